@@ -124,6 +124,19 @@ Ref<Resource> ResourceLoader::get_cached_ref(const String &p_path) {
 	return ResourceCache::get_ref(local_path);
 }
 
+void ResourceLoader::set_cache_budget(int64_t p_bytes) {
+	ERR_FAIL_COND(p_bytes < 0);
+	ResourceCache::set_retain_budget(p_bytes);
+}
+
+int64_t ResourceLoader::get_cache_budget() const {
+	return ResourceCache::get_retain_budget();
+}
+
+void ResourceLoader::clear_cache_retained() {
+	ResourceCache::clear_retained();
+}
+
 bool ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 	return ::ResourceLoader::exists(p_path, p_type_hint);
 }
@@ -149,6 +162,9 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_dependencies", "path"), &ResourceLoader::get_dependencies);
 	ClassDB::bind_method(D_METHOD("has_cached", "path"), &ResourceLoader::has_cached);
 	ClassDB::bind_method(D_METHOD("get_cached_ref", "path"), &ResourceLoader::get_cached_ref);
+	ClassDB::bind_method(D_METHOD("set_cache_budget", "bytes"), &ResourceLoader::set_cache_budget);
+	ClassDB::bind_method(D_METHOD("get_cache_budget"), &ResourceLoader::get_cache_budget);
+	ClassDB::bind_method(D_METHOD("clear_cache_retained"), &ResourceLoader::clear_cache_retained);
 	ClassDB::bind_method(D_METHOD("exists", "path", "type_hint"), &ResourceLoader::exists, DEFVAL(""));
 	ClassDB::bind_method(D_METHOD("get_resource_uid", "path"), &ResourceLoader::get_resource_uid);
 	ClassDB::bind_method(D_METHOD("list_directory", "directory_path"), &ResourceLoader::list_directory);
@@ -1304,17 +1320,11 @@ Marshalls *Marshalls::get_singleton() {
 
 String Marshalls::variant_to_base64(const Variant &p_var, bool p_full_objects) {
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, "", "Error when trying to encode Variant.");
-
 	Vector<uint8_t> buff;
-	buff.resize(len);
-	uint8_t *w = buff.ptrw();
-
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	Error err = encode_variant(p_var, buff, len, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, "", "Error when trying to encode Variant.");
 
-	String ret = CryptoCore::b64_encode_str(&w[0], len);
+	String ret = CryptoCore::b64_encode_str(buff.ptr(), len);
 	ERR_FAIL_COND_V(ret.is_empty(), ret);
 
 	return ret;
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/templates/local_vector.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -41,9 +42,10 @@
 #include <brotli/decode.h>
 #endif
 
-// Caches for zstd.
+// Caches for zstd. Idle decompression contexts are pooled, so several threads can decompress at once.
 static BinaryMutex mutex;
-static ZSTD_DCtx *current_zstd_d_ctx = nullptr;
+static LocalVector<ZSTD_DCtx *> zstd_d_ctx_pool;
+static uint32_t zstd_d_ctx_version = 0;
 static bool current_zstd_long_distance_matching;
 static int current_zstd_window_log_size;
 
@@ -198,22 +200,44 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			MutexLock lock(mutex);
-
-			if (!current_zstd_d_ctx || current_zstd_long_distance_matching != zstd_long_distance_matching || current_zstd_window_log_size != zstd_window_log_size) {
-				if (current_zstd_d_ctx) {
-					ZSTD_freeDCtx(current_zstd_d_ctx);
+			ZSTD_DCtx *d_ctx = nullptr;
+			uint32_t version;
+			{
+				MutexLock lock(mutex);
+				if (current_zstd_long_distance_matching != zstd_long_distance_matching || current_zstd_window_log_size != zstd_window_log_size) {
+					// Settings changed, drop the contexts created with the old ones.
+					for (ZSTD_DCtx *ctx : zstd_d_ctx_pool) {
+						ZSTD_freeDCtx(ctx);
+					}
+					zstd_d_ctx_pool.clear();
+					zstd_d_ctx_version++;
+					current_zstd_long_distance_matching = zstd_long_distance_matching;
+					current_zstd_window_log_size = zstd_window_log_size;
+				}
+				if (!zstd_d_ctx_pool.is_empty()) {
+					d_ctx = zstd_d_ctx_pool[zstd_d_ctx_pool.size() - 1];
+					zstd_d_ctx_pool.resize(zstd_d_ctx_pool.size() - 1);
 				}
+				version = zstd_d_ctx_version;
+			}
 
-				current_zstd_d_ctx = ZSTD_createDCtx();
+			if (!d_ctx) {
+				d_ctx = ZSTD_createDCtx();
 				if (zstd_long_distance_matching) {
-					ZSTD_DCtx_setParameter(current_zstd_d_ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
+					ZSTD_DCtx_setParameter(d_ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
 				}
-				current_zstd_long_distance_matching = zstd_long_distance_matching;
-				current_zstd_window_log_size = zstd_window_log_size;
 			}
 
-			size_t ret = ZSTD_decompressDCtx(current_zstd_d_ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+			size_t ret = ZSTD_decompressDCtx(d_ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+
+			{
+				MutexLock lock(mutex);
+				if (version == zstd_d_ctx_version) {
+					zstd_d_ctx_pool.push_back(d_ctx);
+				} else {
+					ZSTD_freeDCtx(d_ctx);
+				}
+			}
 			return (int64_t)ret;
 		} break;
 	}
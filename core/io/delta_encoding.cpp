@@ -30,6 +30,9 @@
 
 #include "delta_encoding.h"
 
+#include "core/io/marshalls.h"
+#include "core/templates/hash_map.h"
+
 #include <zstd.h>
 
 #define ERR_FAIL_ZSTD_V_MSG(m_result, m_retval, m_msg) \
@@ -51,6 +54,18 @@ static constexpr uint8_t DELTA_MAGIC[4] = { 'G', 'D', 'D', 'L' };
 static constexpr uint8_t DELTA_VERSION_NUMBER = 1;
 static constexpr size_t DELTA_HEADER_SIZE = 5;
 
+// Block deltas share the magic, followed by:
+//   uint8_t reserved[3]
+//   uint32_t block_size
+//   uint32_t op_count
+//   uint64_t new_size
+//   struct { uint64_t source_offset; uint64_t length; } ops[op_count] (literal ops have BLOCK_DELTA_LITERAL set in length)
+//   uint8_t literals[]
+static constexpr uint8_t BLOCK_DELTA_VERSION_NUMBER = 2;
+static constexpr size_t BLOCK_DELTA_HEADER_SIZE = 24;
+static constexpr size_t BLOCK_DELTA_OP_SIZE = 16;
+static constexpr uint64_t BLOCK_DELTA_LITERAL = 1ULL << 63;
+
 Error DeltaEncoding::encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, int p_compression_level) {
 	size_t zstd_result = ZSTD_compressBound(p_new_data.size());
 	ERR_FAIL_ZSTD_V_MSG(zstd_result, FAILED, "Failed to encode delta. Calculating compression bounds failed.");
@@ -86,6 +101,195 @@ Error DeltaEncoding::encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_
 	return OK;
 }
 
+// Weak checksum from rsync, cheap to roll one byte forward.
+struct RollingChecksum {
+	uint32_t a = 0;
+	uint32_t b = 0;
+
+	void init(const uint8_t *p_data, uint32_t p_size) {
+		a = 0;
+		b = 0;
+		for (uint32_t i = 0; i < p_size; i++) {
+			a += p_data[i];
+			b += (p_size - i) * p_data[i];
+		}
+	}
+
+	void roll(uint8_t p_out, uint8_t p_in, uint32_t p_size) {
+		a += p_in - p_out;
+		b += a - p_size * p_out;
+	}
+
+	uint32_t get() const { return (a & 0xFFFF) | (b << 16); }
+};
+
+static void _add_block_delta_op(LocalVector<DeltaEncoding::BlockDeltaOp> &r_ops, uint64_t p_new_offset, uint64_t p_length, uint64_t p_source_offset, bool p_literal) {
+	if (p_length == 0) {
+		return;
+	}
+
+	if (!r_ops.is_empty()) {
+		DeltaEncoding::BlockDeltaOp &last = r_ops[r_ops.size() - 1];
+		if (last.literal == p_literal && last.source_offset + last.length == p_source_offset) {
+			last.length += p_length;
+			return;
+		}
+	}
+
+	DeltaEncoding::BlockDeltaOp op;
+	op.new_offset = p_new_offset;
+	op.length = p_length;
+	op.source_offset = p_source_offset;
+	op.literal = p_literal;
+	r_ops.push_back(op);
+}
+
+static Error _parse_block_delta_ops(const uint8_t *p_table, uint32_t p_op_count, uint64_t p_new_size, uint64_t p_literals_size, LocalVector<DeltaEncoding::BlockDeltaOp> &r_ops) {
+	r_ops.resize(p_op_count);
+	uint64_t new_offset = 0;
+	for (uint32_t i = 0; i < p_op_count; i++) {
+		DeltaEncoding::BlockDeltaOp &op = r_ops[i];
+		op.new_offset = new_offset;
+		op.source_offset = decode_uint64(p_table + i * BLOCK_DELTA_OP_SIZE);
+		const uint64_t length = decode_uint64(p_table + i * BLOCK_DELTA_OP_SIZE + 8);
+		op.literal = length & BLOCK_DELTA_LITERAL;
+		op.length = length & ~BLOCK_DELTA_LITERAL;
+		ERR_FAIL_COND_V_MSG(op.length == 0 || op.length > p_new_size - new_offset, ERR_FILE_CORRUPT, "Failed to decode delta. Block operations exceed the patched size.");
+		ERR_FAIL_COND_V_MSG(op.literal && (op.source_offset > p_literals_size || op.length > p_literals_size - op.source_offset), ERR_FILE_CORRUPT, "Failed to decode delta. Literal exceeds the delta size.");
+		new_offset += op.length;
+	}
+	ERR_FAIL_COND_V_MSG(new_offset != p_new_size, ERR_FILE_CORRUPT, "Failed to decode delta. Block operations don't cover the patched size.");
+
+	return OK;
+}
+
+Error DeltaEncoding::encode_block_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size < 16, ERR_INVALID_PARAMETER);
+
+	const uint8_t *old_data = p_old_data.ptr();
+	const uint8_t *new_data = p_new_data.ptr();
+	const uint64_t old_size = p_old_data.size();
+	const uint64_t new_size = p_new_data.size();
+
+	// Index the blocks of the old data, candidates with the same checksum are chained.
+	const uint64_t old_block_count = old_size / p_block_size;
+	ERR_FAIL_COND_V_MSG(old_block_count >= UINT32_MAX, ERR_OUT_OF_MEMORY, "Failed to encode delta. Too many blocks, use a larger block size.");
+	HashMap<uint32_t, uint32_t> first_block;
+	first_block.reserve(old_block_count);
+	LocalVector<uint32_t> next_block;
+	next_block.resize(old_block_count);
+	RollingChecksum checksum;
+	for (uint32_t i = old_block_count; i > 0; i--) {
+		const uint32_t block = i - 1;
+		checksum.init(old_data + (uint64_t)block * p_block_size, p_block_size);
+		uint32_t *first = first_block.getptr(checksum.get());
+		if (first) {
+			next_block[block] = *first;
+			*first = block;
+		} else {
+			next_block[block] = UINT32_MAX;
+			first_block.insert(checksum.get(), block);
+		}
+	}
+
+	LocalVector<BlockDeltaOp> ops;
+	uint64_t literals_size = 0;
+	uint64_t literal_start = 0;
+	uint64_t pos = 0;
+	bool checksum_valid = false;
+	while (pos + p_block_size <= new_size) {
+		if (!checksum_valid) {
+			checksum.init(new_data + pos, p_block_size);
+			checksum_valid = true;
+		}
+
+		int64_t match = -1;
+		const uint32_t *candidate = first_block.getptr(checksum.get());
+		for (uint32_t block = candidate ? *candidate : UINT32_MAX; block != UINT32_MAX; block = next_block[block]) {
+			if (memcmp(old_data + (uint64_t)block * p_block_size, new_data + pos, p_block_size) == 0) {
+				match = block;
+				break;
+			}
+		}
+
+		if (match < 0) {
+			if (pos + p_block_size < new_size) {
+				checksum.roll(new_data[pos], new_data[pos + p_block_size], p_block_size);
+			}
+			pos++;
+			continue;
+		}
+
+		// Grow the match past the block in both directions.
+		uint64_t old_offset = (uint64_t)match * p_block_size;
+		uint64_t length = p_block_size;
+		while (pos + length < new_size && old_offset + length < old_size && new_data[pos + length] == old_data[old_offset + length]) {
+			length++;
+		}
+		while (pos > literal_start && old_offset > 0 && new_data[pos - 1] == old_data[old_offset - 1]) {
+			pos--;
+			old_offset--;
+			length++;
+		}
+
+		_add_block_delta_op(ops, literal_start, pos - literal_start, literals_size, true);
+		literals_size += pos - literal_start;
+		_add_block_delta_op(ops, pos, length, old_offset, false);
+
+		pos += length;
+		literal_start = pos;
+		checksum_valid = false;
+	}
+	_add_block_delta_op(ops, literal_start, new_size - literal_start, literals_size, true);
+	literals_size += new_size - literal_start;
+
+	const uint64_t literals_offset = BLOCK_DELTA_HEADER_SIZE + (uint64_t)ops.size() * BLOCK_DELTA_OP_SIZE;
+	ERR_FAIL_COND_V(r_delta.resize(literals_offset + literals_size) != OK, ERR_OUT_OF_MEMORY);
+	uint8_t *w = r_delta.ptrw();
+	memcpy(w, DELTA_MAGIC, 4);
+	w[4] = BLOCK_DELTA_VERSION_NUMBER;
+	w[5] = w[6] = w[7] = 0;
+	encode_uint32(p_block_size, w + 8);
+	encode_uint32(ops.size(), w + 12);
+	encode_uint64(new_size, w + 16);
+
+	uint8_t *table = w + BLOCK_DELTA_HEADER_SIZE;
+	for (const BlockDeltaOp &op : ops) {
+		encode_uint64(op.source_offset, table);
+		encode_uint64(op.length | (op.literal ? BLOCK_DELTA_LITERAL : 0), table + 8);
+		table += BLOCK_DELTA_OP_SIZE;
+		if (op.literal) {
+			memcpy(w + literals_offset + op.source_offset, new_data + op.new_offset, op.length);
+		}
+	}
+
+	return OK;
+}
+
+bool DeltaEncoding::is_block_delta(Span<uint8_t> p_delta_header) {
+	return p_delta_header.size() >= DELTA_HEADER_SIZE && memcmp(p_delta_header.ptr(), DELTA_MAGIC, 4) == 0 && p_delta_header[4] == BLOCK_DELTA_VERSION_NUMBER;
+}
+
+Error DeltaEncoding::parse_block_delta(const Ref<FileAccess> &p_delta, LocalVector<BlockDeltaOp> &r_ops, uint64_t &r_literals_offset, uint64_t &r_new_size) {
+	ERR_FAIL_COND_V(p_delta.is_null(), ERR_INVALID_PARAMETER);
+
+	uint8_t header[BLOCK_DELTA_HEADER_SIZE];
+	p_delta->seek(0);
+	ERR_FAIL_COND_V_MSG(p_delta->get_buffer(header, BLOCK_DELTA_HEADER_SIZE) != BLOCK_DELTA_HEADER_SIZE, ERR_FILE_CORRUPT, "Failed to decode delta. File is too small.");
+	ERR_FAIL_COND_V_MSG(!is_block_delta(Span<uint8_t>(header, BLOCK_DELTA_HEADER_SIZE)), ERR_FILE_UNRECOGNIZED, "Failed to decode delta. Not a block delta.");
+
+	const uint32_t op_count = decode_uint32(header + 12);
+	r_new_size = decode_uint64(header + 16);
+	r_literals_offset = BLOCK_DELTA_HEADER_SIZE + (uint64_t)op_count * BLOCK_DELTA_OP_SIZE;
+	ERR_FAIL_COND_V_MSG(r_literals_offset > p_delta->get_length(), ERR_FILE_CORRUPT, "Failed to decode delta. Block operations exceed the delta size.");
+
+	Vector<uint8_t> table;
+	ERR_FAIL_COND_V(table.resize(r_literals_offset - BLOCK_DELTA_HEADER_SIZE) != OK, ERR_OUT_OF_MEMORY);
+	ERR_FAIL_COND_V(p_delta->get_buffer(table.ptrw(), table.size()) != (uint64_t)table.size(), ERR_FILE_CORRUPT);
+
+	return _parse_block_delta_ops(table.ptr(), op_count, r_new_size, p_delta->get_length() - r_literals_offset, r_ops);
+}
+
 Error DeltaEncoding::decode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_delta, Vector<uint8_t> &r_new_data) {
 	ERR_FAIL_COND_V_MSG(p_delta.size() < DELTA_HEADER_SIZE, ERR_INVALID_DATA, vformat("Failed to decode delta. File size (%d) is too small.", p_delta.size()));
 
@@ -94,6 +298,32 @@ Error DeltaEncoding::decode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_delt
 	uint8_t version = p_delta[4];
 
 	ERR_FAIL_COND_V_MSG(memcmp(magic, DELTA_MAGIC, 4) != 0, ERR_FILE_CORRUPT, "Failed to decode delta. Header is invalid.");
+
+	if (version == BLOCK_DELTA_VERSION_NUMBER) {
+		ERR_FAIL_COND_V_MSG(p_delta.size() < BLOCK_DELTA_HEADER_SIZE, ERR_INVALID_DATA, vformat("Failed to decode delta. File size (%d) is too small.", p_delta.size()));
+		const uint32_t op_count = decode_uint32(p_delta.ptr() + 12);
+		const uint64_t new_size = decode_uint64(p_delta.ptr() + 16);
+		const uint64_t literals_offset = BLOCK_DELTA_HEADER_SIZE + (uint64_t)op_count * BLOCK_DELTA_OP_SIZE;
+		ERR_FAIL_COND_V_MSG(literals_offset > p_delta.size(), ERR_FILE_CORRUPT, "Failed to decode delta. Block operations exceed the delta size.");
+
+		LocalVector<BlockDeltaOp> ops;
+		Error err = _parse_block_delta_ops(p_delta.ptr() + BLOCK_DELTA_HEADER_SIZE, op_count, new_size, p_delta.size() - literals_offset, ops);
+		ERR_FAIL_COND_V(err != OK, err);
+
+		ERR_FAIL_COND_V(r_new_data.resize(new_size) != OK, ERR_OUT_OF_MEMORY);
+		uint8_t *w = r_new_data.ptrw();
+		for (const BlockDeltaOp &op : ops) {
+			if (op.literal) {
+				memcpy(w + op.new_offset, p_delta.ptr() + literals_offset + op.source_offset, op.length);
+			} else {
+				ERR_FAIL_COND_V_MSG(op.source_offset > p_old_data.size() || op.length > p_old_data.size() - op.source_offset, ERR_FILE_CORRUPT, "Failed to decode delta. Copy exceeds the original size.");
+				memcpy(w + op.new_offset, p_old_data.ptr() + op.source_offset, op.length);
+			}
+		}
+
+		return OK;
+	}
+
 	ERR_FAIL_COND_V_MSG(version != DELTA_VERSION_NUMBER, ERR_FILE_UNRECOGNIZED, vformat("Failed to decode delta. Expected version %d but found %d.", DELTA_VERSION_NUMBER, version));
 
 	size_t zstd_result = ZSTD_getFrameContentSize(p_delta.ptr() + DELTA_HEADER_SIZE, p_delta.size() - DELTA_HEADER_SIZE);
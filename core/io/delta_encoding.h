@@ -32,8 +32,25 @@
 
 #include "core/io/file_access.h"
 
+#include "core/templates/local_vector.h"
+
 class DeltaEncoding {
 public:
+	// Block deltas describe the new data as copies of ranges of the old data, and literal runs.
+	// Unlike deltas made by encode_delta(), any range of the new data can be rebuilt on its own.
+	struct BlockDeltaOp {
+		uint64_t new_offset = 0;
+		uint64_t length = 0;
+		uint64_t source_offset = 0; // In the old data for copies, in the literals otherwise.
+		bool literal = false;
+	};
+
+	static constexpr uint32_t BLOCK_DELTA_DEFAULT_BLOCK_SIZE = 2048;
+
 	static Error encode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, int p_compression_level = 19);
+	static Error encode_block_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_new_data, Vector<uint8_t> &r_delta, uint32_t p_block_size = BLOCK_DELTA_DEFAULT_BLOCK_SIZE);
 	static Error decode_delta(Span<uint8_t> p_old_data, Span<uint8_t> p_delta, Vector<uint8_t> &r_new_data);
+
+	static bool is_block_delta(Span<uint8_t> p_delta_header);
+	static Error parse_block_delta(const Ref<FileAccess> &p_delta, LocalVector<BlockDeltaOp> &r_ops, uint64_t &r_literals_offset, uint64_t &r_new_size);
 };
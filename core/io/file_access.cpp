@@ -64,19 +64,19 @@ void FileAccess::_set_access_type(AccessType p_access) {
 	_access_type = p_access;
 }
 
-Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
-	Ref<FileAccess> ret;
+FileAccess::AccessType FileAccess::_get_access_type_for_path(const String &p_path) {
 	if (p_path.begins_with("res://") || p_path.begins_with("uid://")) {
-		ret = create(ACCESS_RESOURCES);
+		return ACCESS_RESOURCES;
 	} else if (p_path.begins_with("user://")) {
-		ret = create(ACCESS_USERDATA);
+		return ACCESS_USERDATA;
 	} else if (p_path.begins_with("pipe://")) {
-		ret = create(ACCESS_PIPE);
-	} else {
-		ret = create(ACCESS_FILESYSTEM);
+		return ACCESS_PIPE;
 	}
+	return ACCESS_FILESYSTEM;
+}
 
-	return ret;
+Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
+	return create(_get_access_type_for_path(p_path));
 }
 
 Ref<FileAccess> FileAccess::create_temp(int p_mode_flags, const String &p_prefix, const String &p_extension, bool p_keep, Error *r_error) {
@@ -183,6 +183,29 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 	return ret;
 }
 
+Ref<FileAccess> FileAccess::open_mapped(const String &p_path, Error *r_error) {
+	const AccessType access = _get_access_type_for_path(p_path);
+	if (!create_mapped_func || access == ACCESS_PIPE) {
+		if (r_error) {
+			*r_error = ERR_UNAVAILABLE;
+		}
+		return Ref<FileAccess>();
+	}
+
+	Ref<FileAccess> ret = create_mapped_func();
+	ret->_set_access_type(access);
+	Error err = ret->open_internal(p_path, READ);
+
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err != OK) {
+		ret.unref();
+	}
+
+	return ret;
+}
+
 Ref<FileAccess> FileAccess::_open(const String &p_path, ModeFlags p_mode_flags) {
 	Error err = OK;
 	Ref<FileAccess> fa = open(p_path, p_mode_flags, &err);
@@ -584,6 +607,17 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+const uint8_t *FileAccess::get_buffer_mapped(uint64_t p_length) {
+	const Span<uint8_t> mapped = get_mapped_span();
+	const uint64_t position = get_position();
+	if (mapped.is_empty() || position + p_length > mapped.size()) {
+		return nullptr;
+	}
+
+	seek(position + p_length);
+	return mapped.ptr() + position;
+}
+
 String FileAccess::get_as_utf8_string() const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -920,17 +954,11 @@ bool FileAccess::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 
 bool FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
-
 	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	Error err = encode_variant(p_var, buff, len, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
 
-	return store_32(uint32_t(len)) && store_buffer(buff);
+	return store_32(uint32_t(len)) && store_buffer(buff.ptr(), len);
 }
 
 Vector<uint8_t> FileAccess::get_file_as_bytes(const String &p_path, Error *r_error) {
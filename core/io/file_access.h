@@ -35,6 +35,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/span.h"
 #include "core/typedefs.h"
 
 /**
@@ -148,11 +149,13 @@ private:
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
 	static inline CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
+	static inline CreateFunc create_mapped_func = nullptr; /** memory mapped file access creation function, if the platform has one */
 	template <typename T>
 	static Ref<FileAccess> _create_builtin() {
 		return memnew(T);
 	}
 
+	static AccessType _get_access_type_for_path(const String &p_path);
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
 
 	bool _is_temp_file = false;
@@ -191,6 +194,8 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual Span<uint8_t> get_mapped_span() const { return Span<uint8_t>(); } ///< read-only view of the whole file when it lives in memory, valid while the file is open.
+	const uint8_t *get_buffer_mapped(uint64_t p_length); ///< like get_buffer(), but points into get_mapped_span() instead of copying. Returns nullptr if the file isn't mapped.
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -241,6 +246,7 @@ public:
 	static Ref<FileAccess> create(AccessType p_access); /// Create a file access (for the current platform) this is the only portable way of accessing files.
 	static Ref<FileAccess> create_for_path(const String &p_path);
 	static Ref<FileAccess> open(const String &p_path, int p_mode_flags, Error *r_error = nullptr); /// Create a file access (for the current platform) this is the only portable way of accessing files.
+	static Ref<FileAccess> open_mapped(const String &p_path, Error *r_error = nullptr); /// Open a file read-only as a memory mapping, bypassing packs. Fails with ERR_UNAVAILABLE if the platform can't map files.
 	static Ref<FileAccess> create_temp(int p_mode_flags, const String &p_prefix = "", const String &p_extension = "", bool p_keep = false, Error *r_error = nullptr);
 
 	static Ref<FileAccess> open_encrypted(const String &p_path, ModeFlags p_mode_flags, const Vector<uint8_t> &p_key, const Vector<uint8_t> &p_iv = Vector<uint8_t>());
@@ -286,6 +292,11 @@ public:
 		create_func[p_access] = _create_builtin<T>;
 	}
 
+	template <typename T>
+	static void make_mapped_default() {
+		create_mapped_func = _create_builtin<T>;
+	}
+
 public:
 	virtual ~FileAccess();
 };
@@ -30,10 +30,15 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/compression.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
+#include "core/io/file_io_queue.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
@@ -46,7 +51,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, bool p_compressed) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -56,6 +61,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
 	pf.delta = p_delta;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -180,9 +186,71 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 	}
 }
 
+Ref<FileAccess> PackedData::get_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+
+	HashMap<String, Ref<FileAccess>>::Iterator E = mapped_packs.find(p_pack);
+	if (E) {
+		return E->value;
+	}
+
+	Ref<FileAccess> mapped;
+	// Packs nested in other packs aren't on disk.
+	if (!has_path(p_pack)) {
+		mapped = FileAccess::open_mapped(p_pack);
+	}
+	mapped_packs.insert(p_pack, mapped);
+	return mapped;
+}
+
+// Where the raw contents of a packed file are on disk, for I/O that doesn't go through FileAccessPack.
+// Fails for files that need processing on read (encrypted, compressed or patched).
+bool PackedData::get_path_location(const String &p_path, String &r_file, uint64_t &r_offset, uint64_t &r_size) {
+	String simplified_path = p_path.simplify_path().trim_prefix("res://");
+	PathMD5 pmd5(simplified_path.md5_buffer());
+	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
+	if (!E || E->value.offset == 0 || E->value.encrypted || E->value.compressed || !E->value.src->stores_files_in_place() || has_delta_patches(p_path)) {
+		return false;
+	}
+
+	if (E->value.bundle) {
+		// Sparse packs keep each file on its own.
+		r_file = p_path.simplify_path();
+		r_offset = 0;
+	} else {
+		r_file = E->value.pack;
+		r_offset = E->value.offset;
+	}
+	r_size = E->value.size;
+	return true;
+}
+
+bool PackedData::get_cached_block(const String &p_pack, uint64_t p_offset, Vector<uint8_t> &r_data) {
+	MutexLock lock(block_cache_mutex);
+	const Vector<uint8_t> *data = block_cache.getptr({ p_pack, p_offset });
+	if (!data) {
+		return false;
+	}
+	r_data = *data;
+	return true;
+}
+
+void PackedData::cache_block(const String &p_pack, uint64_t p_offset, const Vector<uint8_t> &p_data) {
+	MutexLock lock(block_cache_mutex);
+	block_cache.insert({ p_pack, p_offset }, p_data);
+}
+
 void PackedData::clear() {
 	files.clear();
 	delta_patches.clear();
+	{
+		MutexLock lock(mapped_packs_mutex);
+		mapped_packs.clear();
+	}
+	{
+		MutexLock lock(block_cache_mutex);
+		block_cache.clear();
+	}
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -291,21 +359,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_V2 || version > PACK_FORMAT_VERSION_V4, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3 and later.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
-		// V3: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3 and V4: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -315,6 +383,12 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		}
 	}
 
+	// Files with flags this version doesn't know about can't be read correctly.
+	uint32_t known_file_flags = PACK_FILE_ENCRYPTED | PACK_FILE_REMOVAL | PACK_FILE_DELTA;
+	if (version >= PACK_FORMAT_VERSION_V4) {
+		known_file_flags |= PACK_FILE_COMPRESSED;
+	}
+
 	// Read directory.
 	int file_count = f->get_32();
 	if (enc_directory) {
@@ -333,24 +407,38 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f = fae;
 	}
 
+	struct DirectoryEntry {
+		String path;
+		uint64_t ofs = 0;
+		uint64_t size = 0;
+		uint8_t md5[16];
+		uint32_t flags = 0;
+	};
+
+	// Read and check the whole directory first, so a rejected pack doesn't leave some of its files registered.
+	LocalVector<DirectoryEntry> entries;
 	for (int i = 0; i < file_count; i++) {
+		DirectoryEntry entry;
 		uint32_t sl = f->get_32();
 		CharString cs;
 		cs.resize_uninitialized(sl + 1);
 		f->get_buffer((uint8_t *)cs.ptr(), sl);
 		cs[sl] = 0;
 
-		String path = String::utf8(cs.ptr(), sl);
-		uint64_t ofs = f->get_64();
-		uint64_t size = f->get_64();
-		uint8_t md5[16];
-		f->get_buffer(md5, 16);
-		uint32_t flags = f->get_32();
+		entry.path = String::utf8(cs.ptr(), sl);
+		entry.ofs = f->get_64();
+		entry.size = f->get_64();
+		f->get_buffer(entry.md5, 16);
+		entry.flags = f->get_32();
+		ERR_FAIL_COND_V_MSG(entry.flags & ~known_file_flags, false, vformat("Pack file \"%s\" has unsupported flags: %d.", entry.path, entry.flags));
+		entries.push_back(entry);
+	}
 
-		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
-			PackedData::get_singleton()->remove_path(path);
+	for (const DirectoryEntry &entry : entries) {
+		if (entry.flags & PACK_FILE_REMOVAL) { // The file was removed.
+			PackedData::get_singleton()->remove_path(entry.path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA));
+			PackedData::get_singleton()->add_path(p_path, entry.path, file_base + entry.ofs, entry.size, entry.md5, this, p_replace_files, (entry.flags & PACK_FILE_ENCRYPTED), sparse_bundle, (entry.flags & PACK_FILE_DELTA), (entry.flags & PACK_FILE_COMPRESSED));
 		}
 	}
 
@@ -358,7 +446,12 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file)));
+	Ref<FileAccess> file;
+	if (p_file->compressed) {
+		file = memnew(FileAccessPackCompressed(p_path, *p_file));
+	} else {
+		file = memnew(FileAccessPack(p_path, *p_file));
+	}
 
 	if (PackedData::get_singleton()->has_delta_patches(p_path)) {
 		Ref<FileAccessPatched> file_patched;
@@ -417,7 +510,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped_data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -425,7 +520,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped_data && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -433,7 +528,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped_data) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -454,7 +551,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!mapped_data && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -467,21 +564,34 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (mapped_data) {
+		memcpy(p_dst, mapped_data + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
 
+Span<uint8_t> FileAccessPack::get_mapped_span() const {
+	if (mapped_data) {
+		return Span<uint8_t>(mapped_data, pf.size);
+	}
+	return Span<uint8_t>();
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped_data && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped_data) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -505,11 +615,40 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped_data = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
 	path = p_path;
 	pf = p_file;
+	pos = 0;
+	eof = false;
+
+	// Warm up the OS file cache, so reading large files (or touching their mapped pages) doesn't block as often.
+	FileIOQueue *io_queue = FileIOQueue::get_singleton();
+	if (pf.size >= PREFETCH_MIN_SIZE && io_queue && io_queue->is_asynchronous()) {
+		if (pf.bundle) {
+			io_queue->request_prefetch(p_path.simplify_path(), 0, pf.size, FileIOQueue::PRIORITY_NORMAL);
+		} else {
+			io_queue->request_prefetch(pf.pack, pf.offset, pf.size, FileIOQueue::PRIORITY_NORMAL);
+		}
+	}
+
+	if (!pf.bundle && !pf.encrypted) {
+		// Serve plain files straight from the mapped pack, without reopening it.
+		mapped_pack = PackedData::get_singleton()->get_mapped_pack(pf.pack);
+		if (mapped_pack.is_valid()) {
+			const Span<uint8_t> mapped = mapped_pack->get_mapped_span();
+			if (pf.offset + pf.size <= mapped.size()) {
+				mapped_data = mapped.ptr() + pf.offset;
+				off = pf.offset;
+				return;
+			}
+			mapped_pack.unref();
+		}
+	}
+
 	if (pf.bundle) {
 		String simplified_path = p_path.simplify_path();
 		f = FileAccess::open(simplified_path, FileAccess::READ | FileAccess::SKIP_PACK);
@@ -542,6 +681,259 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	eof = false;
 }
 
+//////////////////////////////////////////////////////////////////
+
+Error FileAccessPackCompressed::open_internal(const String &p_path, int p_mode_flags) {
+	ERR_PRINT("Can't open pack-referenced file.");
+	return ERR_UNAVAILABLE;
+}
+
+uint64_t FileAccessPackCompressed::_get_block_size(uint32_t p_block) const {
+	return MIN((uint64_t)block_size, pf.size - (uint64_t)p_block * block_size);
+}
+
+void FileAccessPackCompressed::_decompress_job(void *p_jobs, uint32_t p_index) {
+	DecompressJob &job = ((DecompressJob *)p_jobs)[p_index];
+	if (job.data.resize(job.size) != OK) {
+		return;
+	}
+	if (job.src_size == job.size) {
+		// Stored uncompressed.
+		memcpy(job.data.ptrw(), job.src, job.size);
+		job.ok = true;
+		return;
+	}
+	const int64_t ret = Compression::decompress(job.data.ptrw(), job.size, job.src, job.src_size, Compression::MODE_ZSTD);
+	job.ok = ret == (int64_t)job.size;
+}
+
+bool FileAccessPackCompressed::_load_blocks(uint32_t p_from, uint32_t p_to, LocalVector<Vector<uint8_t>> &r_blocks) const {
+	PackedData *packed_data = PackedData::get_singleton();
+
+	r_blocks.resize(p_to - p_from);
+	LocalVector<uint32_t> missing;
+	for (uint32_t i = p_from; i < p_to; i++) {
+		if (!packed_data->get_cached_block(pf.pack, frames_offset + frame_offsets[i], r_blocks[i - p_from])) {
+			missing.push_back(i);
+		}
+	}
+	if (missing.is_empty()) {
+		return true;
+	}
+
+	// Frames are contiguous, fetch all the missing ones with a single read.
+	const uint64_t src_begin = frame_offsets[missing[0]];
+	const uint64_t src_end = frame_offsets[missing[missing.size() - 1] + 1];
+	const uint8_t *src = nullptr;
+	Vector<uint8_t> src_buffer;
+	if (mapped_frames) {
+		src = mapped_frames + src_begin;
+	} else {
+		ERR_FAIL_COND_V(src_buffer.resize(src_end - src_begin) != OK, false);
+		f->seek(frames_offset + src_begin);
+		if (f->get_buffer(src_buffer.ptrw(), src_buffer.size()) != (uint64_t)src_buffer.size()) {
+			return false;
+		}
+		src = src_buffer.ptr();
+	}
+
+	LocalVector<DecompressJob> jobs;
+	jobs.resize(missing.size());
+	for (uint32_t i = 0; i < missing.size(); i++) {
+		jobs[i].src = src + frame_offsets[missing[i]] - src_begin;
+		jobs[i].src_size = frame_offsets[missing[i] + 1] - frame_offsets[missing[i]];
+		jobs[i].size = _get_block_size(missing[i]);
+	}
+
+	// Waiting for a group task from a pool thread could starve the pool, decompress in place there.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (jobs.size() > 1 && pool && pool->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(&_decompress_job, jobs.ptr(), jobs.size(), -1, true, SNAME("Decompress pack blocks"));
+		pool->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < jobs.size(); i++) {
+			_decompress_job(jobs.ptr(), i);
+		}
+	}
+
+	for (uint32_t i = 0; i < missing.size(); i++) {
+		ERR_FAIL_COND_V_MSG(!jobs[i].ok, false, vformat(R"(Can't decompress block %d of pack-referenced file "%s" from pack "%s".)", missing[i], path, pf.pack));
+		r_blocks[missing[i] - p_from] = jobs[i].data;
+		packed_data->cache_block(pf.pack, frames_offset + frame_offsets[missing[i]], jobs[i].data);
+	}
+	return true;
+}
+
+bool FileAccessPackCompressed::is_open() const {
+	return !frame_offsets.is_empty();
+}
+
+void FileAccessPackCompressed::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(!is_open(), "File must be opened before use.");
+
+	eof = p_position > pf.size;
+	pos = p_position;
+}
+
+void FileAccessPackCompressed::seek_end(int64_t p_position) {
+	seek(pf.size + p_position);
+}
+
+uint64_t FileAccessPackCompressed::get_position() const {
+	return pos;
+}
+
+uint64_t FileAccessPackCompressed::get_length() const {
+	return pf.size;
+}
+
+bool FileAccessPackCompressed::eof_reached() const {
+	return eof;
+}
+
+uint64_t FileAccessPackCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!is_open(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (eof) {
+		return 0;
+	}
+
+	uint64_t to_read = p_length;
+	if (to_read + pos > pf.size) {
+		eof = true;
+		to_read = pos < pf.size ? pf.size - pos : 0;
+	}
+
+	uint64_t read = 0;
+	LocalVector<Vector<uint8_t>> blocks;
+	while (read < to_read) {
+		const uint32_t block = pos / block_size;
+		if ((int64_t)block != current_block) {
+			// Get every block the rest of the read spans at once, so they're decompressed in parallel.
+			uint32_t to = (pos + to_read - read - 1) / block_size + 1;
+			if (to == block + 1) {
+				to += READ_AHEAD_BLOCKS; // Small read, more are likely to follow.
+			}
+			to = MIN(MIN(to, block + MAX_BLOCKS_PER_LOAD), _get_block_count());
+			if (!_load_blocks(block, to, blocks)) {
+				error = ERR_FILE_CORRUPT;
+				break;
+			}
+
+			for (uint32_t i = 0; i < blocks.size() && read < to_read; i++) {
+				current_block = block + i;
+				current_data = blocks[i];
+				const uint64_t block_pos = pos - (uint64_t)current_block * block_size;
+				const uint64_t n = MIN(to_read - read, (uint64_t)current_data.size() - block_pos);
+				memcpy(p_dst + read, current_data.ptr() + block_pos, n);
+				read += n;
+				pos += n;
+			}
+			continue;
+		}
+
+		const uint64_t block_pos = pos - (uint64_t)current_block * block_size;
+		const uint64_t n = MIN(to_read - read, (uint64_t)current_data.size() - block_pos);
+		memcpy(p_dst + read, current_data.ptr() + block_pos, n);
+		read += n;
+		pos += n;
+	}
+
+	return read;
+}
+
+Error FileAccessPackCompressed::get_error() const {
+	if (error != OK) {
+		return error;
+	}
+	if (eof) {
+		return ERR_FILE_EOF;
+	}
+	return OK;
+}
+
+void FileAccessPackCompressed::flush() {
+	ERR_FAIL();
+}
+
+bool FileAccessPackCompressed::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V(false);
+}
+
+bool FileAccessPackCompressed::file_exists(const String &p_name) {
+	return false;
+}
+
+void FileAccessPackCompressed::close() {
+	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped_frames = nullptr;
+	frame_offsets.clear();
+	current_block = -1;
+	current_data.clear();
+}
+
+Error FileAccessPackCompressed::_open_index() {
+	Span<uint8_t> mapped;
+	mapped_pack = PackedData::get_singleton()->get_mapped_pack(pf.pack);
+	if (mapped_pack.is_valid()) {
+		mapped = mapped_pack->get_mapped_span();
+	}
+
+	uint32_t block_count = 0;
+	const uint64_t index_offset = pf.offset + 8;
+	if (index_offset <= mapped.size()) {
+		block_size = decode_uint32(mapped.ptr() + pf.offset);
+		block_count = decode_uint32(mapped.ptr() + pf.offset + 4);
+	} else {
+		mapped_pack.unref();
+		f = FileAccess::open(pf.pack, FileAccess::READ);
+		ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", path, pf.pack));
+		f->seek(pf.offset);
+		block_size = f->get_32();
+		block_count = f->get_32();
+	}
+	ERR_FAIL_COND_V_MSG(block_size == 0 || block_count != Math::division_round_up(pf.size, (uint64_t)block_size), ERR_FILE_CORRUPT, vformat(R"(Invalid frame index for pack-referenced file "%s" in pack "%s".)", path, pf.pack));
+
+	frames_offset = index_offset + (uint64_t)(block_count + 1) * 8;
+	frame_offsets.resize(block_count + 1);
+	if (mapped_pack.is_valid()) {
+		ERR_FAIL_COND_V_MSG(frames_offset > mapped.size(), ERR_FILE_CORRUPT, vformat(R"(Invalid frame index for pack-referenced file "%s" in pack "%s".)", path, pf.pack));
+		for (uint32_t i = 0; i <= block_count; i++) {
+			frame_offsets[i] = decode_uint64(mapped.ptr() + index_offset + i * 8);
+		}
+	} else {
+		for (uint32_t i = 0; i <= block_count; i++) {
+			frame_offsets[i] = f->get_64();
+		}
+	}
+
+	bool valid = frame_offsets[0] == 0;
+	for (uint32_t i = 0; i < block_count && valid; i++) {
+		valid = frame_offsets[i + 1] > frame_offsets[i] && frame_offsets[i + 1] - frame_offsets[i] <= _get_block_size(i);
+	}
+	if (mapped_pack.is_valid()) {
+		valid = valid && frames_offset + frame_offsets[block_count] <= mapped.size();
+		mapped_frames = mapped.ptr() + frames_offset;
+	}
+	if (!valid) {
+		frame_offsets.clear();
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat(R"(Invalid frame index for pack-referenced file "%s" in pack "%s".)", path, pf.pack));
+	}
+	return OK;
+}
+
+FileAccessPackCompressed::FileAccessPackCompressed(const String &p_path, const PackedData::PackedFile &p_file) {
+	path = p_path;
+	pf = p_file;
+
+	error = _open_index();
+	if (error != OK) {
+		close();
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // DIR ACCESS
 //////////////////////////////////////////////////////////////////////////////////
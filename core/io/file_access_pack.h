@@ -32,17 +32,23 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/lru.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+// Same layout as V3, files may also be stored with PACK_FILE_COMPRESSED.
+#define PACK_FORMAT_VERSION_V4 4
 
-// The current packed file format version number.
+// The packed file format version number written for packs without compressed files.
+// Packs holding PACK_FILE_COMPRESSED files are written as PACK_FORMAT_VERSION_V4 instead,
+// so that older versions can still read the others.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
 
 enum PackFlags {
@@ -55,8 +61,16 @@ enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3,
 };
 
+// Compressed files start with a frame index, followed by one zstd frame per block:
+//   uint32_t block_size
+//   uint32_t block_count
+//   uint64_t frame_offsets[block_count + 1] (relative to the first frame)
+// Frames as large as their block are stored uncompressed.
+#define PACK_COMPRESSED_BLOCK_SIZE_DEFAULT 65536
+
 class PackSource;
 
 class PackedData {
@@ -74,6 +88,7 @@ public:
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed = false;
 	};
 
 private:
@@ -109,6 +124,27 @@ private:
 
 	Vector<PackSource *> sources;
 
+	// Whole packs mapped in memory, shared by all the files read from them.
+	// Packs that can't be mapped are stored as null, so mapping isn't retried.
+	Mutex mapped_packs_mutex;
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+
+	// Decompressed blocks of compressed files, shared by all the files open from any pack.
+	struct BlockKey {
+		String pack;
+		uint64_t offset = 0;
+
+		bool operator==(const BlockKey &p_key) const {
+			return offset == p_key.offset && pack == p_key.pack;
+		}
+		static uint32_t hash(const BlockKey &p_key) {
+			return hash_murmur3_one_64(p_key.offset, p_key.pack.hash());
+		}
+	};
+	static constexpr int BLOCK_CACHE_CAPACITY = 256;
+	BinaryMutex block_cache_mutex;
+	LRUCache<BlockKey, Vector<uint8_t>, BlockKey> block_cache{ BLOCK_CACHE_CAPACITY };
+
 	PackedDir *root = nullptr;
 
 	static inline PackedData *singleton = nullptr;
@@ -119,12 +155,16 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, bool p_compressed = false); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
 	bool has_delta_patches(const String &p_path) const;
 	HashSet<String> get_file_paths() const;
+	Ref<FileAccess> get_mapped_pack(const String &p_pack);
+	bool get_cached_block(const String &p_pack, uint64_t p_offset, Vector<uint8_t> &r_data);
+	void cache_block(const String &p_pack, uint64_t p_offset, const Vector<uint8_t> &p_data);
+	bool get_path_location(const String &p_path, String &r_file, uint64_t &r_offset, uint64_t &r_size);
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -150,6 +190,8 @@ class PackSource {
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) = 0;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) = 0;
+	// Whether file contents are stored as-is at their offset in the pack, so they can be read without get_file().
+	virtual bool stores_files_in_place() const { return false; }
 	virtual ~PackSource() {}
 };
 
@@ -157,6 +199,7 @@ class PackedSourcePCK : public PackSource {
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+	virtual bool stores_files_in_place() const override { return true; }
 };
 
 class PackedSourceDirectory : public PackSource {
@@ -169,6 +212,9 @@ public:
 
 class FileAccessPack : public FileAccess {
 	GDSOFTCLASS(FileAccessPack, FileAccess);
+	// Files at least this large have the rest of their data prefetched while the start is being read.
+	static constexpr uint64_t PREFETCH_MIN_SIZE = 256 * 1024;
+
 	PackedData::PackedFile pf;
 
 	String path;
@@ -177,6 +223,8 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	Ref<FileAccess> mapped_pack; // Keeps the mapping alive while mapped_data is used instead of f.
+	const uint8_t *mapped_data = nullptr;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -203,6 +251,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_mapped_span() const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -219,6 +268,86 @@ public:
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
 };
 
+// Reads files stored with PACK_FILE_COMPRESSED. Blocks are decompressed on demand,
+// several at once on the WorkerThreadPool when a read spans multiple blocks.
+class FileAccessPackCompressed : public FileAccess {
+	GDSOFTCLASS(FileAccessPackCompressed, FileAccess);
+	// Blocks decompressed past the one needed when reading sequentially.
+	static constexpr uint32_t READ_AHEAD_BLOCKS = 3;
+
+	PackedData::PackedFile pf;
+	String path;
+
+	Ref<FileAccess> f;
+	Ref<FileAccess> mapped_pack;
+	const uint8_t *mapped_frames = nullptr;
+	uint64_t frames_offset = 0;
+
+	uint32_t block_size = 0;
+	LocalVector<uint64_t> frame_offsets;
+
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+	mutable Error error = OK;
+	mutable int64_t current_block = -1;
+	mutable Vector<uint8_t> current_data;
+
+	struct DecompressJob {
+		const uint8_t *src = nullptr;
+		uint64_t src_size = 0;
+		uint64_t size = 0;
+		Vector<uint8_t> data;
+		bool ok = false;
+	};
+	// Reads never decompress more than this many blocks at once.
+	static constexpr uint32_t MAX_BLOCKS_PER_LOAD = 64;
+
+	_FORCE_INLINE_ uint32_t _get_block_count() const { return frame_offsets.size() - 1; }
+	uint64_t _get_block_size(uint32_t p_block) const;
+	static void _decompress_job(void *p_jobs, uint32_t p_index);
+	Error _open_index();
+	bool _load_blocks(uint32_t p_from, uint32_t p_to, LocalVector<Vector<uint8_t>> &r_blocks) const;
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
+	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
+	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
+	virtual int64_t _get_size(const String &p_file) override { return -1; }
+	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
+	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override { return FAILED; }
+
+	virtual bool _get_hidden_attribute(const String &p_file) override { return false; }
+	virtual Error _set_hidden_attribute(const String &p_file, bool p_hidden) override { return ERR_UNAVAILABLE; }
+	virtual bool _get_read_only_attribute(const String &p_file) override { return false; }
+	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
+
+public:
+	virtual bool is_open() const override;
+
+	virtual String get_path() const override { return path; }
+	virtual String get_path_absolute() const override { return path; }
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+	virtual uint64_t get_position() const override;
+	virtual uint64_t get_length() const override;
+
+	virtual bool eof_reached() const override;
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+
+	virtual Error get_error() const override;
+
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+	virtual void flush() override;
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+
+	virtual bool file_exists(const String &p_name) override;
+
+	virtual void close() override;
+
+	FileAccessPackCompressed(const String &p_path, const PackedData::PackedFile &p_file);
+};
+
 int64_t PackedData::get_size(const String &p_path) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
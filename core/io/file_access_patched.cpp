@@ -32,7 +32,6 @@
 
 #include "file_access_pack.h"
 
-#include "core/io/delta_encoding.h"
 #include "core/os/os.h"
 
 Error FileAccessPatched::_apply_patch() const {
@@ -40,7 +39,12 @@ Error FileAccessPatched::_apply_patch() const {
 
 	String path = old_file->get_path();
 	Vector<PackedData::PackedFile> delta_patches = PackedData::get_singleton()->get_delta_patches(path);
-	Vector<uint8_t> old_file_data = old_file->get_buffer(old_file->get_length());
+
+	layers.clear();
+	Layer base;
+	base.file = old_file;
+	base.length = old_file->get_length();
+	layers.push_back(base);
 
 	for (int i = 0; i < delta_patches.size(); ++i) {
 		const PackedData::PackedFile &delta_patch = delta_patches[i];
@@ -51,34 +55,67 @@ Error FileAccessPatched::_apply_patch() const {
 		uint64_t total_usec_start = OS::get_singleton()->get_ticks_usec();
 		uint64_t io_usec_start = OS::get_singleton()->get_ticks_usec();
 
-		Ref<FileAccess> patch_file = FileAccess::open(delta_patch.pack, FileAccess::READ, &err);
-		ERR_FAIL_COND_V(err != OK, err);
-
-		patch_file->seek(delta_patch.offset);
-		ERR_FAIL_COND_V(patch_file->get_error() != OK, patch_file->get_error());
-
-		Vector<uint8_t> patch_data = patch_file->get_buffer(delta_patch.size);
-		ERR_FAIL_COND_V(patch_data.is_empty(), ERR_FILE_CANT_READ);
-
-		uint64_t io_usec_end = OS::get_singleton()->get_ticks_usec();
-		uint64_t decode_usec_start = OS::get_singleton()->get_ticks_usec();
-
-		Vector<uint8_t> new_file_data;
-		err = DeltaEncoding::decode_delta(old_file_data, patch_data, new_file_data);
-		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to apply delta patch (%d of %d) to \"%s\".", i + 1, delta_patches.size(), path));
-
-		uint64_t decode_usec_end = OS::get_singleton()->get_ticks_usec();
-
-		old_file_data = new_file_data;
-
-		uint64_t total_usec_end = OS::get_singleton()->get_ticks_usec();
+		// Open the patch like any other packed file, so it can be compressed or encrypted.
+		Ref<FileAccess> patch_file;
+		if (delta_patch.compressed) {
+			patch_file = memnew(FileAccessPackCompressed(path, delta_patch));
+		} else {
+			patch_file = memnew(FileAccessPack(path, delta_patch));
+		}
+		ERR_FAIL_COND_V(!patch_file->is_open(), ERR_FILE_CANT_OPEN);
+
+		uint8_t header[8];
+		const uint64_t header_size = patch_file->get_buffer(header, sizeof(header));
+		patch_file->seek(0);
+
+		Layer layer;
+		if (DeltaEncoding::is_block_delta(Span<uint8_t>(header, header_size))) {
+			layer.type = Layer::TYPE_BLOCK_DELTA;
+			layer.file = patch_file;
+			err = DeltaEncoding::parse_block_delta(patch_file, layer.ops, layer.literals_offset, layer.length);
+			ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to apply delta patch (%d of %d) to \"%s\".", i + 1, delta_patches.size(), path));
+
+			const uint64_t old_length = layers[layers.size() - 1].length;
+			for (const DeltaEncoding::BlockDeltaOp &op : layer.ops) {
+				ERR_FAIL_COND_V_MSG(!op.literal && (op.source_offset > old_length || op.length > old_length - op.source_offset), ERR_FILE_CORRUPT, vformat("Failed to apply delta patch (%d of %d) to \"%s\", it was made for a different file.", i + 1, delta_patches.size(), path));
+			}
+
+			uint64_t io_usec_end = OS::get_singleton()->get_ticks_usec();
+			print_verbose(vformat(U"Opened block delta patch for \"%s\" from \"%s\" in %d μs.", path, delta_patch.pack.get_file(), io_usec_end - io_usec_start));
+		} else {
+			// Other deltas are decoded against the whole previous layer.
+			Vector<uint8_t> patch_data = patch_file->get_buffer(delta_patch.size);
+			ERR_FAIL_COND_V(patch_data.is_empty(), ERR_FILE_CANT_READ);
+
+			Vector<uint8_t> old_file_data;
+			const uint32_t top = layers.size() - 1;
+			ERR_FAIL_COND_V(old_file_data.resize(layers[top].length) != OK, ERR_OUT_OF_MEMORY);
+			ERR_FAIL_COND_V(_read_layer(top, 0, old_file_data.ptrw(), old_file_data.size()) != (uint64_t)old_file_data.size(), ERR_FILE_CANT_READ);
+
+			uint64_t io_usec_end = OS::get_singleton()->get_ticks_usec();
+			uint64_t decode_usec_start = OS::get_singleton()->get_ticks_usec();
+
+			err = DeltaEncoding::decode_delta(old_file_data, patch_data, layer.data);
+			ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Failed to apply delta patch (%d of %d) to \"%s\".", i + 1, delta_patches.size(), path));
+			layer.type = Layer::TYPE_DATA;
+			layer.length = layer.data.size();
+
+			uint64_t decode_usec_end = OS::get_singleton()->get_ticks_usec();
+			uint64_t total_usec_end = OS::get_singleton()->get_ticks_usec();
+
+			print_verbose(vformat(U"Applied delta patch to \"%s\" from \"%s\" in %d μs (%d μs I/O, %d μs decoding).", path, delta_patch.pack.get_file(), total_usec_end - total_usec_start, io_usec_end - io_usec_start, decode_usec_end - decode_usec_start));
+		}
 
-		print_verbose(vformat(U"Applied delta patch to \"%s\" from \"%s\" in %d μs (%d μs I/O, %d μs decoding).", path, delta_patch.pack.get_file(), total_usec_end - total_usec_start, io_usec_end - io_usec_start, decode_usec_end - decode_usec_start));
+		// Layers below a fully decoded one are no longer read.
+		if (layer.type == Layer::TYPE_DATA) {
+			layers.clear();
+		}
+		layers.push_back(layer);
 	}
 
-	patched_file_data = old_file_data;
-	patched_file.instantiate();
-	return patched_file->open_custom(patched_file_data.ptr(), patched_file_data.size());
+	pos = 0;
+	eof = false;
+	return OK;
 }
 
 bool FileAccessPatched::_try_apply_patch() const {
@@ -86,14 +123,70 @@ bool FileAccessPatched::_try_apply_patch() const {
 		return false;
 	}
 
-	if (patched_file.is_valid()) {
+	if (!layers.is_empty()) {
 		return true;
 	}
 
 	last_error = _apply_patch();
+	if (last_error != OK) {
+		layers.clear();
+	}
 	return last_error == OK;
 }
 
+uint64_t FileAccessPatched::_read_layer(uint32_t p_layer, uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const {
+	const Layer &layer = layers[p_layer];
+	if (p_offset >= layer.length) {
+		return 0;
+	}
+	p_length = MIN(p_length, layer.length - p_offset);
+
+	switch (layer.type) {
+		case Layer::TYPE_FILE: {
+			layer.file->seek(p_offset);
+			return layer.file->get_buffer(p_dst, p_length);
+		}
+		case Layer::TYPE_DATA: {
+			memcpy(p_dst, layer.data.ptr() + p_offset, p_length);
+			return p_length;
+		}
+		case Layer::TYPE_BLOCK_DELTA: {
+			// Find the last operation starting at or before the offset.
+			uint32_t low = 0;
+			uint32_t high = layer.ops.size();
+			while (high - low > 1) {
+				const uint32_t mid = (low + high) / 2;
+				if (layer.ops[mid].new_offset <= p_offset) {
+					low = mid;
+				} else {
+					high = mid;
+				}
+			}
+
+			uint64_t read = 0;
+			for (uint32_t i = low; i < layer.ops.size() && read < p_length; i++) {
+				const DeltaEncoding::BlockDeltaOp &op = layer.ops[i];
+				const uint64_t op_offset = p_offset + read - op.new_offset;
+				const uint64_t size = MIN(op.length - op_offset, p_length - read);
+				uint64_t op_read = 0;
+				if (op.literal) {
+					layer.file->seek(layer.literals_offset + op.source_offset + op_offset);
+					op_read = layer.file->get_buffer(p_dst + read, size);
+				} else {
+					op_read = _read_layer(p_layer - 1, op.source_offset + op_offset, p_dst + read, size);
+				}
+				read += op_read;
+				if (op_read != size) {
+					break;
+				}
+			}
+			return read;
+		}
+	}
+
+	return 0;
+}
+
 Error FileAccessPatched::open_custom(const Ref<FileAccess> &p_old_file) {
 	close();
 
@@ -116,7 +209,8 @@ void FileAccessPatched::seek(uint64_t p_position) {
 		return;
 	}
 
-	patched_file->seek(p_position);
+	pos = p_position;
+	eof = false;
 }
 
 void FileAccessPatched::seek_end(int64_t p_position) {
@@ -124,7 +218,7 @@ void FileAccessPatched::seek_end(int64_t p_position) {
 		return;
 	}
 
-	patched_file->seek_end(p_position);
+	seek(get_length() + p_position);
 }
 
 uint64_t FileAccessPatched::get_position() const {
@@ -132,7 +226,7 @@ uint64_t FileAccessPatched::get_position() const {
 		return 0;
 	}
 
-	return patched_file->get_position();
+	return pos;
 }
 
 uint64_t FileAccessPatched::get_length() const {
@@ -140,7 +234,7 @@ uint64_t FileAccessPatched::get_length() const {
 		return 0;
 	}
 
-	return patched_file->get_length();
+	return layers[layers.size() - 1].length;
 }
 
 bool FileAccessPatched::eof_reached() const {
@@ -148,7 +242,7 @@ bool FileAccessPatched::eof_reached() const {
 		return true;
 	}
 
-	return patched_file->eof_reached();
+	return eof;
 }
 
 Error FileAccessPatched::get_error() const {
@@ -156,44 +250,38 @@ Error FileAccessPatched::get_error() const {
 		return last_error;
 	}
 
-	if (patched_file.is_valid()) {
-		Error inner_error = patched_file->get_error();
-		if (inner_error != OK) {
-			return inner_error;
-		}
-	}
-
-	return last_error;
+	return eof ? ERR_FILE_EOF : OK;
 }
 
 bool FileAccessPatched::store_buffer(const uint8_t *p_src, uint64_t p_length) {
-	if (!_try_apply_patch()) {
-		return false;
-	}
-
-	return patched_file->store_buffer(p_src, p_length);
+	ERR_FAIL_V(false);
 }
 
 uint64_t FileAccessPatched::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
 	if (!_try_apply_patch()) {
 		return 0;
 	}
 
-	return patched_file->get_buffer(p_dst, p_length);
+	const uint64_t read = _read_layer(layers.size() - 1, pos, p_dst, p_length);
+	pos += read;
+	if (read < p_length) {
+		eof = true;
+	}
+
+	return read;
 }
 
 void FileAccessPatched::flush() {
-	if (!_try_apply_patch()) {
-		return;
-	}
-
-	patched_file->flush();
+	ERR_FAIL();
 }
 
 void FileAccessPatched::close() {
 	old_file = Ref<FileAccess>();
-	patched_file = Ref<FileAccessMemory>();
-	patched_file_data.clear();
+	layers.clear();
+	pos = 0;
+	eof = false;
 	last_error = OK;
 }
 
@@ -31,18 +31,38 @@
 #pragma once
 
 #include "file_access.h"
-#include "file_access_memory.h"
+
+#include "core/io/delta_encoding.h"
 
 class FileAccessPatched : public FileAccess {
 	GDSOFTCLASS(FileAccessPatched, FileAccess);
 
+	// Each delta patch applies on top of the previous layer, the first layer being the unpatched file.
+	// Block deltas are read in parts as needed, other deltas are decoded whole when the file is first read.
+	struct Layer {
+		enum Type {
+			TYPE_FILE,
+			TYPE_DATA,
+			TYPE_BLOCK_DELTA,
+		};
+
+		Type type = TYPE_FILE;
+		Ref<FileAccess> file; // The unpatched file, or the block delta.
+		Vector<uint8_t> data;
+		LocalVector<DeltaEncoding::BlockDeltaOp> ops;
+		uint64_t literals_offset = 0;
+		uint64_t length = 0;
+	};
+
 	Ref<FileAccess> old_file;
-	mutable Vector<uint8_t> patched_file_data;
-	mutable Ref<FileAccessMemory> patched_file;
+	mutable LocalVector<Layer> layers;
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
 	mutable Error last_error = OK;
 
 	Error _apply_patch() const;
 	bool _try_apply_patch() const;
+	uint64_t _read_layer(uint32_t p_layer, uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const;
 
 protected:
 	virtual BitField<UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -0,0 +1,410 @@
+/**************************************************************************/
+/*  file_io_queue.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_io_queue.h"
+
+#include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/resource_loader.h"
+
+void FileIOQueue::Backend::_read_with_file_access(Request *p_request) {
+	Ref<FileAccess> f = FileAccess::open(p_request->path, FileAccess::READ, &p_request->error);
+	if (f.is_null()) {
+		return;
+	}
+
+	const uint64_t file_length = f->get_length();
+	if (p_request->offset > file_length) {
+		p_request->error = ERR_FILE_EOF;
+		return;
+	}
+	uint64_t length = file_length - p_request->offset;
+	if (p_request->length >= 0) {
+		length = MIN(length, (uint64_t)p_request->length);
+	}
+	f->seek(p_request->offset);
+
+	if (p_request->prefetch) {
+		// Only the OS file cache needs to see the data, read it in chunks.
+		static thread_local LocalVector<uint8_t> chunk;
+		chunk.resize(65536);
+		while (length > 0 && !p_request->canceled.is_set()) {
+			const uint64_t read = f->get_buffer(chunk.ptr(), MIN(length, (uint64_t)chunk.size()));
+			if (read == 0 || read > length) {
+				break;
+			}
+			length -= read;
+		}
+		return;
+	}
+
+	if (p_request->data.resize(length) != OK) {
+		p_request->error = ERR_OUT_OF_MEMORY;
+		return;
+	}
+	const uint64_t read = f->get_buffer(p_request->data.ptrw(), length);
+	if (read < length) {
+		p_request->data.resize(read);
+	}
+}
+
+void FileIOQueue::Backend::read_batch(Request *const *p_requests, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (!p_requests[i]->canceled.is_set()) {
+			_read_with_file_access(p_requests[i]);
+		}
+	}
+}
+
+void FileIOQueue::_resolve(Request *p_request) {
+	if (p_request->resolve_resource) {
+		p_request->path = ResourceLoader::import_remap(ResourceLoader::path_remap(p_request->path));
+		if (p_request->path.is_empty()) {
+			p_request->error = ERR_FILE_NOT_FOUND;
+			return;
+		}
+	}
+
+	PackedData *packed_data = PackedData::get_singleton();
+	if (!packed_data || packed_data->is_disabled() || !packed_data->has_path(p_request->path)) {
+		return;
+	}
+
+	String pack;
+	uint64_t pack_offset = 0;
+	uint64_t size = 0;
+	if (!packed_data->get_path_location(p_request->path, pack, pack_offset, size)) {
+		p_request->through_file_access = true;
+		return;
+	}
+
+	if (p_request->offset > size) {
+		p_request->error = ERR_FILE_EOF;
+		return;
+	}
+	const uint64_t available = size - p_request->offset;
+	p_request->length = p_request->length < 0 ? available : MIN((uint64_t)p_request->length, available);
+	p_request->offset += pack_offset;
+	p_request->path = pack;
+}
+
+void FileIOQueue::_process(Request *const *p_requests, uint32_t p_count) {
+	LocalVector<Request *> to_read;
+	to_read.reserve(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		Request *request = p_requests[i];
+		if (request->canceled.is_set()) {
+			continue;
+		}
+		_resolve(request);
+		if (request->error == OK) {
+			to_read.push_back(request);
+		}
+	}
+
+	if (!to_read.is_empty()) {
+		backend->read_batch(to_read.ptr(), to_read.size());
+	}
+
+	MutexLock lock(mutex);
+	for (uint32_t i = 0; i < p_count; i++) {
+		Request *request = p_requests[i];
+		request->status = STATUS_COMPLETED;
+		if (request->resolve_resource) {
+			pending_prefetches.erase(request->source_path);
+		}
+		if (request->prefetch || (request->canceled.is_set() && !request->waited)) {
+			_release(request);
+		}
+	}
+	completion_cond.notify_all();
+}
+
+void FileIOQueue::_thread_func(void *p_userdata) {
+	FileIOQueue *queue = (FileIOQueue *)p_userdata;
+	const uint32_t max_batch_size = MAX(1u, queue->backend->get_max_batch_size());
+	LocalVector<Request *> batch;
+
+	while (true) {
+		batch.clear();
+		{
+			MutexLock lock(queue->mutex);
+			while (!queue->exit_threads && queue->pending_count == 0) {
+				queue->request_cond.wait(lock);
+			}
+			if (queue->exit_threads) {
+				break;
+			}
+
+			for (int i = PRIORITY_MAX - 1; i >= 0 && batch.size() < max_batch_size; i--) {
+				List<Request *> &pending = queue->queues[i];
+				while (!pending.is_empty() && batch.size() < max_batch_size) {
+					Request *request = pending.front()->get();
+					pending.pop_front();
+					request->queue_element = nullptr;
+					request->status = STATUS_IN_PROGRESS;
+					batch.push_back(request);
+					queue->pending_count--;
+				}
+			}
+		}
+
+		queue->_process(batch.ptr(), batch.size());
+	}
+}
+
+void FileIOQueue::_start() {
+	if (create_backend_func) {
+		backend = create_backend_func();
+	}
+	if (!backend) {
+		backend = memnew(Backend);
+	}
+
+#ifdef THREADS_ENABLED
+	const uint32_t thread_count = MAX(1u, backend->get_thread_count());
+	for (uint32_t i = 0; i < thread_count; i++) {
+		Thread *thread = memnew(Thread);
+		thread->start(&FileIOQueue::_thread_func, this);
+		threads.push_back(thread);
+	}
+#endif
+}
+
+FileIOQueue::RequestID FileIOQueue::_queue(Request *p_request) {
+#ifdef THREADS_ENABLED
+	MutexLock lock(mutex);
+
+	if (exit_threads || (p_request->resolve_resource && pending_prefetches.has(p_request->source_path))) {
+		memdelete(p_request);
+		return INVALID_REQUEST_ID;
+	}
+	if (!backend) {
+		_start();
+	}
+
+	p_request->id = ++last_id;
+	requests.insert(p_request->id, p_request);
+	if (p_request->resolve_resource) {
+		pending_prefetches.insert(p_request->source_path);
+	}
+	p_request->queue_element = queues[p_request->priority].push_back(p_request);
+	pending_count++;
+	request_cond.notify_one();
+
+	return p_request->id;
+#else
+	// Without threads there's nothing to gain from prefetching, and reads happen right away.
+	if (p_request->prefetch) {
+		memdelete(p_request);
+		return INVALID_REQUEST_ID;
+	}
+	if (!backend) {
+		_start();
+	}
+
+	p_request->id = ++last_id;
+	requests.insert(p_request->id, p_request);
+	p_request->status = STATUS_IN_PROGRESS;
+	_process(&p_request, 1);
+
+	return p_request->id;
+#endif
+}
+
+void FileIOQueue::_release(Request *p_request) {
+	requests.erase(p_request->id);
+	memdelete(p_request);
+}
+
+FileIOQueue::RequestID FileIOQueue::request_read(const String &p_path, uint64_t p_offset, int64_t p_length, Priority p_priority) {
+	ERR_FAIL_INDEX_V(p_priority, PRIORITY_MAX, INVALID_REQUEST_ID);
+
+	Request *request = memnew(Request);
+	request->source_path = p_path;
+	request->path = p_path;
+	request->offset = p_offset;
+	request->length = p_length;
+	request->priority = p_priority;
+	return _queue(request);
+}
+
+FileIOQueue::RequestID FileIOQueue::request_prefetch(const String &p_path, uint64_t p_offset, int64_t p_length, Priority p_priority) {
+	ERR_FAIL_INDEX_V(p_priority, PRIORITY_MAX, INVALID_REQUEST_ID);
+
+	Request *request = memnew(Request);
+	request->source_path = p_path;
+	request->path = p_path;
+	request->offset = p_offset;
+	request->length = p_length;
+	request->priority = p_priority;
+	request->prefetch = true;
+	return _queue(request);
+}
+
+FileIOQueue::RequestID FileIOQueue::prefetch_resource(const String &p_path, Priority p_priority) {
+	ERR_FAIL_INDEX_V(p_priority, PRIORITY_MAX, INVALID_REQUEST_ID);
+
+	Request *request = memnew(Request);
+	request->source_path = p_path;
+	request->path = p_path;
+	request->priority = p_priority;
+	request->prefetch = true;
+	request->resolve_resource = true;
+	return _queue(request);
+}
+
+bool FileIOQueue::is_asynchronous() {
+#ifdef THREADS_ENABLED
+	MutexLock lock(mutex);
+	if (exit_threads) {
+		return false;
+	}
+	if (!backend) {
+		_start();
+	}
+	return backend->is_asynchronous();
+#else
+	return false;
+#endif
+}
+
+FileIOQueue::Status FileIOQueue::get_status(RequestID p_id) const {
+	MutexLock lock(mutex);
+	Request *const *request = requests.getptr(p_id);
+	return request ? (*request)->status : STATUS_INVALID;
+}
+
+Error FileIOQueue::wait(RequestID p_id, Vector<uint8_t> *r_data) {
+	MutexLock lock(mutex);
+	Request **request_ptr = requests.getptr(p_id);
+	ERR_FAIL_NULL_V_MSG(request_ptr, ERR_INVALID_PARAMETER, "Invalid or already released request.");
+	Request *request = *request_ptr;
+	ERR_FAIL_COND_V_MSG(request->prefetch, ERR_INVALID_PARAMETER, "Prefetches can't be waited for.");
+	ERR_FAIL_COND_V_MSG(request->waited, ERR_BUSY, "Request is already waited for on another thread.");
+	ERR_FAIL_COND_V_MSG(request->canceled.is_set(), ERR_INVALID_PARAMETER, "Request was canceled.");
+	request->waited = true;
+
+	if (request->status == STATUS_PENDING && request->priority != PRIORITY_HIGH) {
+		// Someone needs it now, move it ahead.
+		queues[request->priority].erase(request->queue_element);
+		request->priority = PRIORITY_HIGH;
+		request->queue_element = queues[PRIORITY_HIGH].push_back(request);
+	}
+
+	// Once the queue is shut down, `finish()` may have released the request already.
+	while (!exit_threads && request->status != STATUS_COMPLETED) {
+		completion_cond.wait(lock);
+	}
+	ERR_FAIL_COND_V_MSG(exit_threads, ERR_UNAVAILABLE, "File I/O queue was shut down before the request completed.");
+
+	const Error err = request->error;
+	if (r_data) {
+		*r_data = request->data;
+	}
+	_release(request);
+	return err;
+}
+
+void FileIOQueue::cancel(RequestID p_id) {
+	MutexLock lock(mutex);
+	Request **request_ptr = requests.getptr(p_id);
+	if (!request_ptr) {
+		return;
+	}
+	Request *request = *request_ptr;
+	if (request->waited) {
+		return;
+	}
+
+	switch (request->status) {
+		case STATUS_PENDING: {
+			queues[request->priority].erase(request->queue_element);
+			pending_count--;
+			if (request->resolve_resource) {
+				pending_prefetches.erase(request->source_path);
+			}
+			_release(request);
+		} break;
+		case STATUS_IN_PROGRESS: {
+			request->canceled.set();
+		} break;
+		default: {
+			_release(request);
+		} break;
+	}
+}
+
+void FileIOQueue::finish() {
+	{
+		MutexLock lock(mutex);
+		if (exit_threads) {
+			return;
+		}
+		exit_threads = true;
+		request_cond.notify_all();
+		// Waiters can't be served anymore.
+		completion_cond.notify_all();
+	}
+
+	for (Thread *thread : threads) {
+		thread->wait_to_finish();
+		memdelete(thread);
+	}
+	threads.clear();
+
+	MutexLock lock(mutex);
+
+	if (backend) {
+		memdelete(backend);
+		backend = nullptr;
+	}
+
+	for (KeyValue<RequestID, Request *> &E : requests) {
+		memdelete(E.value);
+	}
+	requests.clear();
+	for (List<Request *> &pending : queues) {
+		pending.clear();
+	}
+	pending_count = 0;
+	pending_prefetches.clear();
+}
+
+FileIOQueue::FileIOQueue() {
+	singleton = this;
+}
+
+FileIOQueue::~FileIOQueue() {
+	finish();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
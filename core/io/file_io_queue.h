@@ -0,0 +1,167 @@
+/**************************************************************************/
+/*  file_io_queue.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Queue of asynchronous file reads, served by priority on dedicated I/O
+// threads, so loaders can ask for data ahead of time instead of blocking the
+// thread they run on. Paths inside packs are translated to their location in
+// the pack file. Platforms can provide a faster backend (e.g. io_uring on
+// Linux), the default one reads through FileAccess.
+class FileIOQueue {
+public:
+	enum Priority {
+		PRIORITY_LOW,
+		PRIORITY_NORMAL,
+		PRIORITY_HIGH,
+		PRIORITY_MAX,
+	};
+
+	enum Status {
+		STATUS_INVALID,
+		STATUS_PENDING,
+		STATUS_IN_PROGRESS,
+		STATUS_COMPLETED,
+	};
+
+	typedef int64_t RequestID;
+	static constexpr RequestID INVALID_REQUEST_ID = 0;
+
+	struct Request {
+		RequestID id = INVALID_REQUEST_ID;
+		String source_path; // As requested, `path` may be rewritten when resolving it.
+		String path;
+		uint64_t offset = 0;
+		int64_t length = -1; // Until the end of the file.
+		Priority priority = PRIORITY_NORMAL;
+		bool prefetch = false; // Only warms up the OS file cache, no data is kept.
+		bool resolve_resource = false; // Apply resource remaps and imports to the path first.
+		bool through_file_access = false; // Set when the data can only be read with FileAccess (e.g. encrypted packed files).
+		SafeFlag canceled;
+		bool waited = false; // A thread is blocked in `wait()` on it, and releases it.
+
+		Status status = STATUS_PENDING;
+		Error error = OK;
+		Vector<uint8_t> data;
+		List<Request *>::Element *queue_element = nullptr;
+	};
+
+	class Backend {
+	protected:
+		static void _read_with_file_access(Request *p_request);
+
+	public:
+		// Called from the I/O threads. Sets the error of each request, and its data unless it's a prefetch.
+		virtual void read_batch(Request *const *p_requests, uint32_t p_count);
+		virtual uint32_t get_max_batch_size() const { return 1; }
+		virtual uint32_t get_thread_count() const { return 2; }
+		virtual bool is_valid() const { return true; }
+		// Whether the OS serves reads and prefetches on its own, so the I/O threads don't have to read the data themselves.
+		virtual bool is_asynchronous() const { return false; }
+
+		virtual ~Backend() {}
+	};
+
+	typedef Backend *(*CreateBackendFunc)();
+
+private:
+	static inline FileIOQueue *singleton = nullptr;
+	static inline CreateBackendFunc create_backend_func = nullptr;
+
+	template <typename T>
+	static Backend *_create_backend() {
+		T *backend = memnew(T);
+		if (!backend->is_valid()) {
+			memdelete(backend);
+			return nullptr;
+		}
+		return backend;
+	}
+
+	Backend *backend = nullptr;
+	LocalVector<Thread *> threads;
+	bool exit_threads = false;
+
+	mutable BinaryMutex mutex;
+	ConditionVariable request_cond;
+	ConditionVariable completion_cond;
+
+	RequestID last_id = INVALID_REQUEST_ID;
+	HashMap<RequestID, Request *> requests;
+	List<Request *> queues[PRIORITY_MAX];
+	uint32_t pending_count = 0;
+	HashSet<String> pending_prefetches;
+
+	void _start();
+	RequestID _queue(Request *p_request);
+	void _release(Request *p_request);
+	static void _resolve(Request *p_request);
+	void _process(Request *const *p_requests, uint32_t p_count);
+	static void _thread_func(void *p_userdata);
+
+public:
+	static FileIOQueue *get_singleton() { return singleton; }
+
+	template <typename T>
+	static void make_default_backend() {
+		create_backend_func = _create_backend<T>;
+	}
+
+	RequestID request_read(const String &p_path, uint64_t p_offset = 0, int64_t p_length = -1, Priority p_priority = PRIORITY_NORMAL);
+	RequestID request_prefetch(const String &p_path, uint64_t p_offset = 0, int64_t p_length = -1, Priority p_priority = PRIORITY_LOW);
+	// Prefetches the file a resource is actually loaded from, after remaps and imports. Returns INVALID_REQUEST_ID if it's already queued.
+	RequestID prefetch_resource(const String &p_path, Priority p_priority = PRIORITY_LOW);
+
+	// Prefetches only pay off with an asynchronous backend, or when the data is needed by another thread anyway.
+	bool is_asynchronous();
+
+	Status get_status(RequestID p_id) const;
+	// Blocks until a read completes, then releases it. Prefetches are released on their own once done.
+	// Fails if the queue is shut down before the read completes.
+	Error wait(RequestID p_id, Vector<uint8_t> *r_data = nullptr);
+	// Releases a request. If it's already being read, it is discarded once done.
+	// Does nothing while another thread waits for the request, that thread releases it.
+	void cancel(RequestID p_id);
+
+	void finish();
+
+	FileIOQueue();
+	~FileIOQueue();
+};
@@ -78,6 +78,15 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_MASK (0b11 << 18)
 #define HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT 18
 
+// For `Variant::ARRAY` and `Variant::DICTIONARY` with a built-in element type, when elements
+// are stored without their own header. The `_64` bits replace `HEADER_DATA_FLAG_64` for all elements.
+#define HEADER_DATA_FLAG_COMPACT_ARRAY (1 << 20)
+#define HEADER_DATA_FLAG_COMPACT_ARRAY_64 (1 << 21)
+#define HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY (1 << 20)
+#define HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY_64 (1 << 21)
+#define HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE (1 << 22)
+#define HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE_64 (1 << 23)
+
 enum ContainerTypeKind {
 	CONTAINER_TYPE_KIND_NONE = 0b00,
 	CONTAINER_TYPE_KIND_BUILTIN = 0b01,
@@ -88,6 +97,107 @@ enum ContainerTypeKind {
 #define GET_CONTAINER_TYPE_KIND(m_header, m_field) \
 	((ContainerTypeKind)(((m_header) & HEADER_DATA_FIELD_##m_field##_MASK) >> HEADER_DATA_FIELD_##m_field##_SHIFT))
 
+// Elements of these types can be stored without a header in typed containers, since they are
+// always encoded the same way for a given type.
+static bool _is_compact_element_type(const ContainerType &p_type) {
+	switch (p_type.builtin_type) {
+		case Variant::NIL:
+		case Variant::OBJECT:
+		case Variant::DICTIONARY:
+		case Variant::ARRAY:
+			return false;
+		default:
+			return p_type.builtin_type < Variant::VARIANT_MAX;
+	}
+}
+
+// Compact `Variant::INT` and `Variant::FLOAT` elements are always stored in 64 bits.
+static bool _is_compact_element_64(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::INT:
+		case Variant::FLOAT:
+			return true;
+#ifdef REAL_T_IS_DOUBLE
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::VECTOR4:
+		case Variant::PACKED_VECTOR2_ARRAY:
+		case Variant::PACKED_VECTOR3_ARRAY:
+		case Variant::PACKED_VECTOR4_ARRAY:
+		case Variant::TRANSFORM2D:
+		case Variant::TRANSFORM3D:
+		case Variant::PROJECTION:
+		case Variant::QUATERNION:
+		case Variant::PLANE:
+		case Variant::BASIS:
+		case Variant::RECT2:
+		case Variant::AABB:
+			return true;
+#endif // REAL_T_IS_DOUBLE
+		default:
+			return false;
+	}
+}
+
+// The encoded data is little-endian, so arrays of 32-bit and 64-bit values can be copied as a whole on little-endian hosts.
+static void _decode_uint32_array(void *r_dst, const uint8_t *p_src, int p_count) {
+#ifdef BIG_ENDIAN_ENABLED
+	uint32_t *dst = (uint32_t *)r_dst;
+	for (int i = 0; i < p_count; i++) {
+		dst[i] = decode_uint32(p_src + i * 4);
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(uint32_t));
+#endif
+}
+
+static void _decode_uint64_array(void *r_dst, const uint8_t *p_src, int p_count) {
+#ifdef BIG_ENDIAN_ENABLED
+	uint64_t *dst = (uint64_t *)r_dst;
+	for (int i = 0; i < p_count; i++) {
+		dst[i] = decode_uint64(p_src + i * 8);
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(uint64_t));
+#endif
+}
+
+static void _encode_uint32_array(const void *p_src, uint8_t *r_dst, int p_count) {
+	if (p_count == 0) {
+		return;
+	}
+#ifdef BIG_ENDIAN_ENABLED
+	const uint32_t *src = (const uint32_t *)p_src;
+	for (int i = 0; i < p_count; i++) {
+		encode_uint32(src[i], r_dst + i * 4);
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(uint32_t));
+#endif
+}
+
+static void _encode_uint64_array(const void *p_src, uint8_t *r_dst, int p_count) {
+	if (p_count == 0) {
+		return;
+	}
+#ifdef BIG_ENDIAN_ENABLED
+	const uint64_t *src = (const uint64_t *)p_src;
+	for (int i = 0; i < p_count; i++) {
+		encode_uint64(src[i], r_dst + i * 8);
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(uint64_t));
+#endif
+}
+
+static void _encode_real_array(const real_t *p_src, uint8_t *r_dst, int p_count) {
+	if constexpr (sizeof(real_t) == sizeof(double)) {
+		_encode_uint64_array(p_src, r_dst, p_count);
+	} else {
+		_encode_uint32_array(p_src, r_dst, p_count);
+	}
+}
+
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 
@@ -182,23 +292,15 @@ static Error _decode_container_type(const uint8_t *&buf, int &len, int *r_len, b
 	ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Invalid container type kind."); // Future proofing.
 }
 
-Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+// Decodes the data following a header. `r_len` is incremented by the amount of bytes used, if provided.
+static Error _decode_variant_payload(Variant &r_variant, uint32_t p_header, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
+	ERR_FAIL_COND_V((p_header & HEADER_TYPE_MASK) >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
+
+	const uint32_t header = p_header;
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
 
-	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
-
-	uint32_t header = decode_uint32(buf);
-
-	ERR_FAIL_COND_V((header & HEADER_TYPE_MASK) >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
-
-	buf += 4;
-	len -= 4;
-	if (r_len) {
-		*r_len = 4;
-	}
-
 	// NOTE: We cannot use `sizeof(real_t)` for decoding, in case a different size is encoded.
 	// Decoding math types always checks for the encoded size, while encoding always uses compilation setting.
 	// This does lead to some code duplication for decoding, but compatibility is the priority.
@@ -837,16 +939,25 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4; // Size of count number.
 			}
 
+			const bool compact_keys = header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY;
+			const bool compact_values = header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE;
+			ERR_FAIL_COND_V(compact_keys && !_is_compact_element_type(key_type), ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(compact_values && !_is_compact_element_type(value_type), ERR_INVALID_DATA);
+			const uint32_t key_header = key_type.builtin_type | ((header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY_64) ? HEADER_DATA_FLAG_64 : 0);
+			const uint32_t value_header = value_type.builtin_type | ((header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE_64) ? HEADER_DATA_FLAG_64 : 0);
+
 			Dictionary dict;
 			if (key_type.builtin_type != Variant::NIL || value_type.builtin_type != Variant::NIL) {
 				dict.set_typed(key_type, value_type);
 			}
+			// Don't trust the count further than what the remaining data can hold.
+			dict.reserve(MIN(count, len / 4));
 
 			for (int i = 0; i < count; i++) {
 				Variant key, value;
 
-				int used;
-				Error err = decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
+				int used = 0;
+				Error err = compact_keys ? _decode_variant_payload(key, key_header, buf, len, &used, p_allow_objects, p_depth + 1) : decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -855,7 +966,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += used;
 				}
 
-				err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+				used = 0;
+				err = compact_values ? _decode_variant_payload(value, value_header, buf, len, &used, p_allow_objects, p_depth + 1) : decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -894,15 +1006,21 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4; // Size of count number.
 			}
 
+			const bool compact = header & HEADER_DATA_FLAG_COMPACT_ARRAY;
+			ERR_FAIL_COND_V(compact && !_is_compact_element_type(type), ERR_INVALID_DATA);
+			const uint32_t element_header = type.builtin_type | ((header & HEADER_DATA_FLAG_COMPACT_ARRAY_64) ? HEADER_DATA_FLAG_64 : 0);
+
 			Array array;
 			if (type.builtin_type != Variant::NIL) {
 				array.set_typed(type);
 			}
+			// Don't trust the count further than what the remaining data can hold.
+			array.reserve(MIN(count, len / 4));
 
 			for (int i = 0; i < count; i++) {
 				int used = 0;
 				Variant elem;
-				Error err = decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1);
+				Error err = compact ? _decode_variant_payload(elem, element_header, buf, len, &used, p_allow_objects, p_depth + 1) : decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 				buf += used;
 				len -= used;
@@ -928,10 +1046,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -955,12 +1070,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int32_t> data;
 
 			if (count) {
-				//const int *rbuf = (const int *)buf;
 				data.resize(count);
-				int32_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_uint32(&buf[i * 4]);
-				}
+				_decode_uint32_array(data.ptrw(), buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -979,12 +1090,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int64_t> data;
 
 			if (count) {
-				//const int *rbuf = (const int *)buf;
 				data.resize(count);
-				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_uint64(&buf[i * 8]);
-				}
+				_decode_uint64_array(data.ptrw(), buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -1003,12 +1110,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float *rbuf = (const float *)buf;
 				data.resize(count);
-				float *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_float(&buf[i * 4]);
-				}
+				_decode_uint32_array(data.ptrw(), buf, count);
 			}
 			r_variant = data;
 
@@ -1029,10 +1132,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_double(&buf[i * 8]);
-				}
+				_decode_uint64_array(data.ptrw(), buf, count);
 			}
 			r_variant = data;
 
@@ -1086,9 +1186,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
+					if constexpr (sizeof(real_t) == sizeof(double)) {
+						_decode_uint64_array(w, buf, count * 2);
+					} else {
+						for (int32_t i = 0; i < count; i++) {
+							w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
+							w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
+						}
 					}
 
 					int adv = sizeof(double) * 2 * count;
@@ -1111,9 +1215,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
+					if constexpr (sizeof(real_t) == sizeof(float)) {
+						_decode_uint32_array(w, buf, count * 2);
+					} else {
+						for (int32_t i = 0; i < count; i++) {
+							w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
+							w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
+						}
 					}
 
 					int adv = sizeof(float) * 2 * count;
@@ -1146,10 +1254,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
+					if constexpr (sizeof(real_t) == sizeof(double)) {
+						_decode_uint64_array(w, buf, count * 3);
+					} else {
+						for (int32_t i = 0; i < count; i++) {
+							w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
+							w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
+							w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
+						}
 					}
 
 					int adv = sizeof(double) * 3 * count;
@@ -1172,10 +1284,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
+					if constexpr (sizeof(real_t) == sizeof(float)) {
+						_decode_uint32_array(w, buf, count * 3);
+					} else {
+						for (int32_t i = 0; i < count; i++) {
+							w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
+							w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
+							w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
+						}
 					}
 
 					int adv = sizeof(float) * 3 * count;
@@ -1207,15 +1323,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				carray.resize(count);
-				Color *w = carray.ptrw();
-
-				for (int32_t i = 0; i < count; i++) {
-					// Colors should always be in single-precision.
-					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
-					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
-					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
-					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
-				}
+				// Colors should always be in single-precision.
+				_decode_uint32_array(carray.ptrw(), buf, count * 4);
 
 				int adv = 4 * 4 * count;
 
@@ -1248,11 +1357,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
-						w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
+					if constexpr (sizeof(real_t) == sizeof(double)) {
+						_decode_uint64_array(w, buf, count * 4);
+					} else {
+						for (int32_t i = 0; i < count; i++) {
+							w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
+							w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
+							w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
+							w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
+						}
 					}
 
 					int adv = sizeof(double) * 4 * count;
@@ -1275,11 +1388,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
-						w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
+					if constexpr (sizeof(real_t) == sizeof(float)) {
+						_decode_uint32_array(w, buf, count * 4);
+					} else {
+						for (int32_t i = 0; i < count; i++) {
+							w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
+							w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
+							w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
+							w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
+						}
 					}
 
 					int adv = sizeof(float) * 4 * count;
@@ -1302,6 +1419,18 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+	ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+
+	uint32_t header = decode_uint32(p_buffer);
+
+	if (r_len) {
+		*r_len = 4;
+	}
+
+	return _decode_variant_payload(r_variant, header, p_buffer + 4, p_len - 4, r_len, p_allow_objects, p_depth);
+}
+
 static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
 	CharString utf8 = p_string.utf8();
 
@@ -1358,12 +1487,7 @@ static Error _encode_container_type(const ContainerType &p_type, uint8_t *&buf,
 	return OK;
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
-	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
-	uint8_t *buf = r_buffer;
-
-	r_len = 0;
-
+static uint32_t _encode_variant_header(const Variant &p_variant, bool p_full_objects, bool p_compact_typed_containers) {
 	uint32_t header = p_variant.get_type();
 
 	switch (p_variant.get_type()) {
@@ -1385,11 +1509,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			Object *obj = p_variant.get_validated_object();
 			if (!obj) {
 				// Object is invalid, send a nullptr instead.
-				if (buf) {
-					encode_uint32(Variant::NIL, buf);
-				}
-				r_len += 4;
-				return OK;
+				return Variant::NIL;
 			}
 
 			if (!p_full_objects) {
@@ -1398,12 +1518,33 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} break;
 		case Variant::DICTIONARY: {
 			const Dictionary dict = p_variant;
-			_encode_container_type_header(dict.get_key_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_KEY_SHIFT, p_full_objects);
-			_encode_container_type_header(dict.get_value_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT, p_full_objects);
+			const ContainerType key_type = dict.get_key_type();
+			const ContainerType value_type = dict.get_value_type();
+			_encode_container_type_header(key_type, header, HEADER_DATA_FIELD_TYPED_DICTIONARY_KEY_SHIFT, p_full_objects);
+			_encode_container_type_header(value_type, header, HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT, p_full_objects);
+			if (p_compact_typed_containers && _is_compact_element_type(key_type)) {
+				header |= HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY;
+				if (_is_compact_element_64(key_type.builtin_type)) {
+					header |= HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY_64;
+				}
+			}
+			if (p_compact_typed_containers && _is_compact_element_type(value_type)) {
+				header |= HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE;
+				if (_is_compact_element_64(value_type.builtin_type)) {
+					header |= HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE_64;
+				}
+			}
 		} break;
 		case Variant::ARRAY: {
 			const Array array = p_variant;
-			_encode_container_type_header(array.get_element_type(), header, HEADER_DATA_FIELD_TYPED_ARRAY_SHIFT, p_full_objects);
+			const ContainerType type = array.get_element_type();
+			_encode_container_type_header(type, header, HEADER_DATA_FIELD_TYPED_ARRAY_SHIFT, p_full_objects);
+			if (p_compact_typed_containers && _is_compact_element_type(type)) {
+				header |= HEADER_DATA_FLAG_COMPACT_ARRAY;
+				if (_is_compact_element_64(type.builtin_type)) {
+					header |= HEADER_DATA_FLAG_COMPACT_ARRAY_64;
+				}
+			}
 		} break;
 #ifdef REAL_T_IS_DOUBLE
 		case Variant::VECTOR2:
@@ -1428,13 +1569,18 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} break;
 	}
 
-	if (buf) {
-		encode_uint32(header, buf);
-		buf += 4;
-	}
-	r_len += 4;
+	return header;
+}
 
-	switch (p_variant.get_type()) {
+// Encodes the data following a header, `r_len` doesn't include the header.
+static Error _encode_variant_payload(const Variant &p_variant, uint32_t p_header, uint8_t *r_buffer, int &r_len, bool p_full_objects, bool p_compact_typed_containers, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+	const uint32_t header = p_header;
+	uint8_t *buf = r_buffer;
+
+	r_len = 0;
+
+	switch (header & HEADER_TYPE_MASK) {
 		case Variant::NIL: {
 			// Nothing to do.
 		} break;
@@ -1790,7 +1936,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 						}
 
 						int len;
-						Error err = encode_variant(value, buf, len, p_full_objects, p_depth + 1);
+						Error err = encode_variant(value, buf, len, p_full_objects, p_compact_typed_containers, p_depth + 1);
 						ERR_FAIL_COND_V(err, err);
 						ERR_FAIL_COND_V(len % 4, ERR_BUG);
 						r_len += len;
@@ -1849,16 +1995,21 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
+			const bool compact_keys = header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY;
+			const bool compact_values = header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE;
+			const uint32_t key_header = dict.get_typed_key_builtin() | ((header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY_64) ? HEADER_DATA_FLAG_64 : 0);
+			const uint32_t value_header = dict.get_typed_value_builtin() | ((header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE_64) ? HEADER_DATA_FLAG_64 : 0);
+
 			for (const KeyValue<Variant, Variant> &kv : dict) {
 				int len;
-				Error err = encode_variant(kv.key, buf, len, p_full_objects, p_depth + 1);
+				Error err = compact_keys ? _encode_variant_payload(kv.key, key_header, buf, len, p_full_objects, p_compact_typed_containers, p_depth + 1) : encode_variant(kv.key, buf, len, p_full_objects, p_compact_typed_containers, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
 				if (buf) {
 					buf += len;
 				}
-				err = encode_variant(kv.value, buf, len, p_full_objects, p_depth + 1);
+				err = compact_values ? _encode_variant_payload(kv.value, value_header, buf, len, p_full_objects, p_compact_typed_containers, p_depth + 1) : encode_variant(kv.value, buf, len, p_full_objects, p_compact_typed_containers, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
@@ -1884,9 +2035,12 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
+			const bool compact = header & HEADER_DATA_FLAG_COMPACT_ARRAY;
+			const uint32_t element_header = array.get_typed_builtin() | ((header & HEADER_DATA_FLAG_COMPACT_ARRAY_64) ? HEADER_DATA_FLAG_64 : 0);
+
 			for (const Variant &elem : array) {
 				int len;
-				Error err = encode_variant(elem, buf, len, p_full_objects, p_depth + 1);
+				Error err = compact ? _encode_variant_payload(elem, element_header, buf, len, p_full_objects, p_compact_typed_containers, p_depth + 1) : encode_variant(elem, buf, len, p_full_objects, p_compact_typed_containers, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				if (buf) {
@@ -1930,10 +2084,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
+				_encode_uint32_array(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1947,10 +2098,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
+				_encode_uint64_array(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1964,10 +2112,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
+				_encode_uint32_array(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1981,10 +2126,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
+				_encode_uint64_array(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -2033,13 +2175,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					buf += sizeof(real_t) * 2;
-				}
+				_encode_real_array((const real_t *)data.ptr(), buf, len * 2);
+				buf += sizeof(real_t) * 2 * len;
 			}
 
 			r_len += sizeof(real_t) * 2 * len;
@@ -2057,14 +2194,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					buf += sizeof(real_t) * 3;
-				}
+				_encode_real_array((const real_t *)data.ptr(), buf, len * 3);
+				buf += sizeof(real_t) * 3 * len;
 			}
 
 			r_len += sizeof(real_t) * 3 * len;
@@ -2082,15 +2213,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4; // Colors should always be in single-precision.
-				}
+				_encode_uint32_array(data.ptr(), buf, len * 4);
+				buf += 4 * 4 * len; // Colors should always be in single-precision.
 			}
 
 			r_len += 4 * 4 * len;
@@ -2108,15 +2232,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector4 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					encode_real(v.w, &buf[sizeof(real_t) * 3]);
-					buf += sizeof(real_t) * 4;
-				}
+				_encode_real_array((const real_t *)data.ptr(), buf, len * 4);
+				buf += sizeof(real_t) * 4 * len;
 			}
 
 			r_len += sizeof(real_t) * 4 * len;
@@ -2130,6 +2247,136 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, bool p_compact_typed_containers, int p_depth) {
+	uint32_t header = _encode_variant_header(p_variant, p_full_objects, p_compact_typed_containers);
+	uint8_t *buf = r_buffer;
+	if (buf) {
+		encode_uint32(header, buf);
+		buf += 4;
+	}
+
+	Error err = _encode_variant_payload(p_variant, header, buf, r_len, p_full_objects, p_compact_typed_containers, p_depth);
+	r_len += 4;
+	return err;
+}
+
+// Single-pass encoding into a growable buffer. Containers and strings, which are the expensive
+// part of measuring the data, are written directly; other types are small enough to be measured
+// before being written in place.
+
+static uint8_t *_grow_encode_buffer(Vector<uint8_t> &r_buffer, int &r_pos, int p_len) {
+	int pos = r_pos;
+	r_pos += p_len;
+	if (r_buffer.size() < r_pos) {
+		r_buffer.resize(r_pos);
+	}
+	return r_buffer.ptrw() + pos;
+}
+
+static void _append_string(const String &p_string, Vector<uint8_t> &r_buffer, int &r_pos) {
+	CharString utf8 = p_string.utf8();
+	int len = utf8.length();
+	int pad = (4 - len % 4) % 4;
+
+	uint8_t *w = _grow_encode_buffer(r_buffer, r_pos, 4 + len + pad);
+	encode_uint32(len, w);
+	memcpy(w + 4, utf8.get_data(), len);
+	memset(w + 4 + len, 0, pad);
+}
+
+static Error _append_container_type(const ContainerType &p_type, Vector<uint8_t> &r_buffer, int &r_pos, bool p_full_objects) {
+	uint8_t *buf = nullptr;
+	int len = 0;
+	Error err = _encode_container_type(p_type, buf, len, p_full_objects);
+	if (err) {
+		return err;
+	}
+
+	buf = _grow_encode_buffer(r_buffer, r_pos, len);
+	len = 0;
+	return _encode_container_type(p_type, buf, len, p_full_objects);
+}
+
+static Error _append_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_pos, bool p_full_objects, bool p_compact_typed_containers, int p_depth);
+
+static Error _append_variant_payload(const Variant &p_variant, uint32_t p_header, Vector<uint8_t> &r_buffer, int &r_pos, bool p_full_objects, bool p_compact_typed_containers, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	switch (p_header & HEADER_TYPE_MASK) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			_append_string(p_variant, r_buffer, r_pos);
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dict = p_variant;
+
+			Error err = _append_container_type(dict.get_key_type(), r_buffer, r_pos, p_full_objects);
+			if (err) {
+				return err;
+			}
+			err = _append_container_type(dict.get_value_type(), r_buffer, r_pos, p_full_objects);
+			if (err) {
+				return err;
+			}
+
+			encode_uint32(uint32_t(dict.size()), _grow_encode_buffer(r_buffer, r_pos, 4));
+
+			const bool compact_keys = p_header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY;
+			const bool compact_values = p_header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE;
+			const uint32_t key_header = dict.get_typed_key_builtin() | ((p_header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_KEY_64) ? HEADER_DATA_FLAG_64 : 0);
+			const uint32_t value_header = dict.get_typed_value_builtin() | ((p_header & HEADER_DATA_FLAG_COMPACT_DICTIONARY_VALUE_64) ? HEADER_DATA_FLAG_64 : 0);
+
+			for (const KeyValue<Variant, Variant> &kv : dict) {
+				err = compact_keys ? _append_variant_payload(kv.key, key_header, r_buffer, r_pos, p_full_objects, p_compact_typed_containers, p_depth + 1) : _append_variant(kv.key, r_buffer, r_pos, p_full_objects, p_compact_typed_containers, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				err = compact_values ? _append_variant_payload(kv.value, value_header, r_buffer, r_pos, p_full_objects, p_compact_typed_containers, p_depth + 1) : _append_variant(kv.value, r_buffer, r_pos, p_full_objects, p_compact_typed_containers, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_variant;
+
+			Error err = _append_container_type(array.get_element_type(), r_buffer, r_pos, p_full_objects);
+			if (err) {
+				return err;
+			}
+
+			encode_uint32(uint32_t(array.size()), _grow_encode_buffer(r_buffer, r_pos, 4));
+
+			const bool compact = p_header & HEADER_DATA_FLAG_COMPACT_ARRAY;
+			const uint32_t element_header = array.get_typed_builtin() | ((p_header & HEADER_DATA_FLAG_COMPACT_ARRAY_64) ? HEADER_DATA_FLAG_64 : 0);
+
+			for (const Variant &elem : array) {
+				err = compact ? _append_variant_payload(elem, element_header, r_buffer, r_pos, p_full_objects, p_compact_typed_containers, p_depth + 1) : _append_variant(elem, r_buffer, r_pos, p_full_objects, p_compact_typed_containers, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+			}
+		} break;
+		default: {
+			int len = 0;
+			Error err = _encode_variant_payload(p_variant, p_header, nullptr, len, p_full_objects, p_compact_typed_containers, p_depth);
+			if (err) {
+				return err;
+			}
+
+			uint8_t *w = _grow_encode_buffer(r_buffer, r_pos, len);
+			return _encode_variant_payload(p_variant, p_header, w, len, p_full_objects, p_compact_typed_containers, p_depth);
+		}
+	}
+
+	return OK;
+}
+
+static Error _append_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_pos, bool p_full_objects, bool p_compact_typed_containers, int p_depth) {
+	uint32_t header = _encode_variant_header(p_variant, p_full_objects, p_compact_typed_containers);
+	encode_uint32(header, _grow_encode_buffer(r_buffer, r_pos, 4));
+	return _append_variant_payload(p_variant, header, r_buffer, r_pos, p_full_objects, p_compact_typed_containers, p_depth);
+}
+
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects, bool p_compact_typed_containers) {
+	r_len = 0;
+	return _append_variant(p_variant, r_buffer, r_len, p_full_objects, p_compact_typed_containers, 0);
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't `memcpy()`.
 	// We also don't consider returning a pointer to the passed vectors when `sizeof(real_t) == 4`.
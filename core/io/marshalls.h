@@ -220,6 +220,12 @@ public:
 };
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+// When `r_buffer` is null, only `r_len` is computed so the caller can allocate the buffer and encode again.
+// `p_compact_typed_containers` stores the elements of arrays and dictionaries typed with a built-in type
+// without their own header. Such data can't be decoded by versions that predate this option.
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, bool p_compact_typed_containers = false, int p_depth = 0);
+// Encodes in a single pass, starting at the beginning of `r_buffer` and growing it as needed, but never shrinking it.
+// `r_len` is set to the amount of bytes written.
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects = false, bool p_compact_typed_containers = false);
 
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
@@ -31,9 +31,14 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
+#include "core/io/delta_encoding.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -48,9 +53,78 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("use_previous_pack", "previous_pck_path"), &PCKPacker::use_previous_pack);
+	ClassDB::bind_method(D_METHOD("use_delta_base_pack", "base_pck_path"), &PCKPacker::use_delta_base_pack);
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_compression_block_size", "block_size"), &PCKPacker::set_compression_block_size);
+	ClassDB::bind_method(D_METHOD("get_compression_block_size"), &PCKPacker::get_compression_block_size);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compression_enabled"), "set_compression_enabled", "is_compression_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_block_size", PROPERTY_HINT_RANGE, "4096,16777216,1,or_greater,suffix:B"), "set_compression_block_size", "get_compression_block_size");
+}
+
+// Splits the data in independently compressed frames, preceded by their index (see PACK_FILE_COMPRESSED).
+// Returns an empty buffer if compression doesn't make the file smaller.
+Vector<uint8_t> PCKPacker::_compress_blocks(const Vector<uint8_t> &p_data, uint32_t p_block_size) {
+	const uint64_t size = p_data.size();
+	const uint32_t block_count = Math::division_round_up(size, (uint64_t)p_block_size);
+	const uint64_t index_size = 8 + (uint64_t)(block_count + 1) * 8;
+	if (index_size >= size) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> result;
+	ERR_FAIL_COND_V(result.resize(size) != OK, Vector<uint8_t>());
+	uint8_t *w = result.ptrw();
+	encode_uint32(p_block_size, w);
+	encode_uint32(block_count, w + 4);
+
+	Vector<uint8_t> frame;
+	frame.resize(Compression::get_max_compressed_buffer_size(p_block_size, Compression::MODE_ZSTD));
+
+	uint64_t frames_size = 0;
+	encode_uint64(0, w + 8);
+	for (uint32_t i = 0; i < block_count; i++) {
+		const uint8_t *src = p_data.ptr() + (uint64_t)i * p_block_size;
+		const uint64_t src_size = MIN((uint64_t)p_block_size, size - (uint64_t)i * p_block_size);
+
+		const int64_t compressed_size = Compression::compress(frame.ptrw(), src, src_size, Compression::MODE_ZSTD);
+		// Blocks that don't compress are stored as-is, the reader recognizes them by their size.
+		const bool stored = compressed_size <= 0 || (uint64_t)compressed_size >= src_size;
+		const uint64_t frame_size = stored ? src_size : compressed_size;
+		if (index_size + frames_size + frame_size >= size) {
+			return Vector<uint8_t>();
+		}
+
+		memcpy(w + index_size + frames_size, stored ? src : frame.ptr(), frame_size);
+		frames_size += frame_size;
+		encode_uint64(frames_size, w + 8 + (i + 1) * 8);
+	}
+
+	result.resize(index_size + frames_size);
+	return result;
+}
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression_enabled = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression_enabled;
+}
+
+void PCKPacker::set_compression_block_size(int p_block_size) {
+	ERR_FAIL_COND_MSG(p_block_size < 4096, "Compression block size must be at least 4096 bytes.");
+	compression_block_size = p_block_size;
+}
+
+int PCKPacker::get_compression_block_size() const {
+	return compression_block_size;
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -87,10 +161,12 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file = FileAccess::open(p_pck_path, FileAccess::WRITE);
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, vformat("Can't open file to write: '%s'.", String(p_pck_path)));
 
+	pck_path = p_pck_path;
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	version_ofs = file->get_position();
+	file->store_32(PACK_FORMAT_VERSION); // Updated on flush if any file is compressed.
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
@@ -123,6 +199,169 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->seek(file_base);
 
 	files.clear();
+	pending.clear();
+	pending_size = 0;
+	stored_content.clear();
+	previous_pack.unref();
+	previous_files.clear();
+	previous_key = PREVIOUS_KEY_UNKNOWN;
+	delta_base_path = String();
+	delta_base_files.clear();
+
+	return OK;
+}
+
+Error PCKPacker::_read_pack_directory(const String &p_path, Ref<FileAccess> &r_file, HashMap<String, PackEntry> &r_entries) const {
+	ERR_FAIL_COND_V_MSG(p_path.simplify_path() == pck_path.simplify_path(), ERR_INVALID_PARAMETER, "The pack to read must be a different file than the one being written.");
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, vformat("Can't open pack: '%s'.", p_path));
+
+	// Only standalone packs are supported, so the header is at the start.
+	ERR_FAIL_COND_V_MSG(f->get_32() != PACK_HEADER_MAGIC, ERR_FILE_UNRECOGNIZED, vformat("Not a PCK file: '%s'.", p_path));
+	const uint32_t version = f->get_32();
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V4, ERR_FILE_UNRECOGNIZED, vformat("Pack version unsupported: %d.", version));
+	f->get_32(); // Engine version, not used.
+	f->get_32();
+	f->get_32();
+
+	const uint32_t pack_flags = f->get_32();
+	ERR_FAIL_COND_V_MSG(pack_flags & PACK_SPARSE_BUNDLE, ERR_FILE_UNRECOGNIZED, "Sparse bundles can't be read back.");
+	const uint64_t pack_file_base = f->get_64();
+	f->seek(f->get_64());
+
+	const uint32_t file_count = f->get_32();
+	Ref<FileAccess> fdir = f;
+	if (pack_flags & PACK_DIR_ENCRYPTED) {
+		Ref<FileAccessEncrypted> fae;
+		fae.instantiate();
+		Error err = fae->open_and_parse(f, key, FileAccessEncrypted::MODE_READ, false);
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Can't decrypt the pack directory, it must use the same key.");
+		fdir = fae;
+	}
+
+	r_entries.clear();
+	for (uint32_t i = 0; i < file_count; i++) {
+		const uint32_t string_len = fdir->get_32();
+		CharString cs;
+		cs.resize_uninitialized(string_len + 1);
+		fdir->get_buffer((uint8_t *)cs.ptr(), string_len);
+		cs[string_len] = 0;
+		const String path = String::utf8(cs.ptr());
+
+		PackEntry entry;
+		entry.ofs = pack_file_base + fdir->get_64();
+		entry.size = fdir->get_64();
+		fdir->get_buffer(entry.md5, 16);
+		const uint32_t flags = fdir->get_32();
+		if (flags & (PACK_FILE_REMOVAL | PACK_FILE_DELTA)) {
+			r_entries.erase(path);
+			continue;
+		}
+		entry.encrypted = flags & PACK_FILE_ENCRYPTED;
+		entry.compressed = flags & PACK_FILE_COMPRESSED;
+
+		if (entry.encrypted) {
+			// MD5, length and IV, followed by the data padded to the AES block size.
+			entry.stored_size = 16 + 8 + 16 + entry.size + _get_pad(16, entry.size % 16);
+		} else if (entry.compressed) {
+			f->seek(entry.ofs + 4);
+			const uint32_t block_count = f->get_32();
+			f->seek(entry.ofs + 8 + (uint64_t)block_count * 8);
+			entry.stored_size = 8 + (uint64_t)(block_count + 1) * 8 + f->get_64();
+		} else {
+			entry.stored_size = entry.size;
+		}
+		ERR_CONTINUE_MSG(entry.ofs + entry.stored_size > f->get_length(), vformat("Pack entry is truncated: '%s'.", path));
+
+		r_entries[path] = entry;
+	}
+
+	r_file = f;
+
+	return OK;
+}
+
+Error PCKPacker::_read_pack_entry(const String &p_pack_path, const PackEntry &p_entry, Vector<uint8_t> &r_data) const {
+	Ref<FileAccess> f = FileAccess::open(p_pack_path, FileAccess::READ);
+	ERR_FAIL_COND_V(f.is_null(), ERR_FILE_CANT_OPEN);
+	f->seek(p_entry.ofs);
+
+	if (p_entry.encrypted) {
+		Ref<FileAccessEncrypted> fae;
+		fae.instantiate();
+		Error err = fae->open_and_parse(f, key, FileAccessEncrypted::MODE_READ, false);
+		ERR_FAIL_COND_V(err != OK, err);
+		ERR_FAIL_COND_V(r_data.resize(p_entry.size) != OK, ERR_OUT_OF_MEMORY);
+		ERR_FAIL_COND_V(fae->get_buffer(r_data.ptrw(), p_entry.size) != p_entry.size, ERR_FILE_CORRUPT);
+	} else if (p_entry.compressed) {
+		const uint32_t block_size = f->get_32();
+		const uint32_t block_count = f->get_32();
+		ERR_FAIL_COND_V(block_size == 0 || block_count != Math::division_round_up(p_entry.size, (uint64_t)block_size), ERR_FILE_CORRUPT);
+		LocalVector<uint64_t> frame_offsets;
+		frame_offsets.resize(block_count + 1);
+		for (uint64_t &frame_offset : frame_offsets) {
+			frame_offset = f->get_64();
+		}
+
+		ERR_FAIL_COND_V(r_data.resize(p_entry.size) != OK, ERR_OUT_OF_MEMORY);
+		Vector<uint8_t> frame;
+		for (uint32_t i = 0; i < block_count; i++) {
+			const uint64_t block_ofs = (uint64_t)i * block_size;
+			const uint64_t size = MIN((uint64_t)block_size, p_entry.size - block_ofs);
+			frame = f->get_buffer(frame_offsets[i + 1] - frame_offsets[i]);
+			if ((uint64_t)frame.size() == size) {
+				memcpy(r_data.ptrw() + block_ofs, frame.ptr(), size);
+			} else {
+				const int64_t decompressed = Compression::decompress(r_data.ptrw() + block_ofs, size, frame.ptr(), frame.size(), Compression::MODE_ZSTD);
+				ERR_FAIL_COND_V((uint64_t)decompressed != size, ERR_FILE_CORRUPT);
+			}
+		}
+	} else {
+		r_data = f->get_buffer(p_entry.size);
+	}
+	ERR_FAIL_COND_V((uint64_t)r_data.size() != p_entry.size, ERR_FILE_CORRUPT);
+
+	return OK;
+}
+
+// Decrypts the entry and compares it with its MD5, without printing errors: a different key is expected if it was changed.
+bool PCKPacker::_is_encrypted_with_key(const Ref<FileAccess> &p_pack, const PackEntry &p_entry) const {
+	p_pack->seek(p_entry.ofs);
+	uint8_t md5[16];
+	uint8_t iv[16];
+	p_pack->get_buffer(md5, 16);
+	const uint64_t length = p_pack->get_64();
+	p_pack->get_buffer(iv, 16);
+	if (length != p_entry.size) {
+		return false;
+	}
+
+	Vector<uint8_t> data = p_pack->get_buffer(length + _get_pad(16, length % 16));
+	if ((uint64_t)data.size() < length) {
+		return false;
+	}
+	CryptoCore::AESContext ctx;
+	ctx.set_encode_key(key.ptr(), 256); // CFB uses the encryption key schedule for both ways.
+	ctx.decrypt_cfb(data.size(), iv, data.ptr(), data.ptrw());
+
+	uint8_t hash[16];
+	return CryptoCore::md5(data.ptr(), length, hash) == OK && memcmp(hash, md5, 16) == 0;
+}
+
+Error PCKPacker::use_previous_pack(const String &p_previous_pck_path) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+	previous_key = PREVIOUS_KEY_UNKNOWN;
+	return _read_pack_directory(p_previous_pck_path, previous_pack, previous_files);
+}
+
+Error PCKPacker::use_delta_base_pack(const String &p_base_pck_path) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	Ref<FileAccess> base_pack;
+	Error err = _read_pack_directory(p_base_pck_path, base_pack, delta_base_files);
+	ERR_FAIL_COND_V(err != OK, err);
+	delta_base_path = p_base_pck_path;
 
 	return OK;
 }
@@ -158,52 +397,210 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	// symbols or 'res://' in them still match the MD5 hash for the saved path.
 	pf.path = p_target_path.simplify_path().trim_prefix("res://");
 	pf.src_path = p_source_path;
-	pf.ofs = file->get_position();
 	pf.size = f->get_length();
+	pf.encrypted = p_encrypt;
+	files.push_back(pf);
+
+	PendingFile pending_file;
+	pending_file.file_idx = files.size() - 1;
+	pending.push_back(pending_file);
+
+	// Content is written in batches to bound memory use.
+	pending_size += pf.size;
+	if (pending_size >= PENDING_BATCH_SIZE) {
+		return _write_pending();
+	}
+
+	return OK;
+}
 
-	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_source_path);
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(data.ptr(), data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
+void PCKPacker::_read_pending(uint32_t p_index, PendingFile *p_pending) {
+	PendingFile &pf = p_pending[p_index];
+	pf.data = FileAccess::get_file_as_bytes(files[pf.file_idx].src_path, &pf.error);
+	if (pf.error != OK) {
+		return;
+	}
+
+	CryptoCore::sha256(pf.data.ptr(), pf.data.size(), pf.sha256);
+
+	const PackEntry *base = delta_base_files.getptr(files[pf.file_idx].path);
+	if (base) {
+		Vector<uint8_t> base_data;
+		Vector<uint8_t> delta;
+		if (_read_pack_entry(delta_base_path, *base, base_data) == OK && DeltaEncoding::encode_block_delta(base_data, pf.data, delta) == OK && delta.size() <= pf.data.size() * (1.0 - DELTA_MIN_REDUCTION)) {
+			pf.data = delta;
+			pf.delta = true;
 		}
 	}
-	pf.encrypted = p_encrypt;
 
-	Ref<FileAccess> ftmp = file;
+	// Like the size, the MD5 is the one of the stored data, so the delta for patches.
+	CryptoCore::md5(pf.data.ptr(), pf.data.size(), pf.md5);
+}
 
-	Ref<FileAccessEncrypted> fae;
-	if (p_encrypt) {
+void PCKPacker::_encode_pending(uint32_t p_index, PendingFile *p_pending) {
+	PendingFile &pf = p_pending[p_index];
+	if (pf.error != OK || pf.duplicate_of >= 0 || pf.previous) {
+		return;
+	}
+
+	if (files[pf.file_idx].encrypted) {
+		Vector<uint8_t> encrypted;
+		encrypted.resize(16 + 8 + 16 + pf.data.size() + _get_pad(16, pf.data.size() % 16));
+
+		Ref<FileAccessMemory> fm;
+		fm.instantiate();
+		fm->open_custom(encrypted.ptrw(), encrypted.size());
+
+		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
-		ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+		pf.error = fae->open_and_parse(fm, key, FileAccessEncrypted::MODE_WRITE_AES256, false, pf.iv);
+		if (pf.error != OK) {
+			return;
+		}
+		fae->store_buffer(pf.data.ptr(), pf.data.size());
+		fae.unref(); // Encrypts on close.
+
+		pf.data = encrypted;
+	} else if (compression_enabled) {
+		const Vector<uint8_t> compressed = _compress_blocks(pf.data, compression_block_size);
+		if (!compressed.is_empty()) {
+			pf.compressed = true;
+			pf.data = compressed;
+		}
+	}
+}
 
-		Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-		ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
-		ftmp = fae;
+Error PCKPacker::_write_pending() {
+	if (pending.is_empty()) {
+		return OK;
 	}
 
-	ftmp->store_buffer(data);
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PCKPacker::_read_pending, pending.ptr(), pending.size(), -1, false, SNAME("PCKPackerRead"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Content stored before, in this pack or the previous one, is not encoded again.
+	CryptoCore::RandomGenerator rng;
+	bool rng_initialized = false;
+	Error err = OK;
+	for (PendingFile &pf : pending) {
+		File &f = files.write[pf.file_idx];
+		if (pf.error != OK) {
+			err = pf.error;
+			ERR_PRINT(vformat("Can't read file to pack: '%s'.", f.src_path));
+			break;
+		}
 
-	if (fae.is_valid()) {
-		ftmp.unref();
-		fae.unref();
+		f.size = pf.data.size();
+		f.delta = pf.delta;
+		f.md5.resize(16);
+		memcpy(f.md5.ptrw(), pf.md5, 16);
+
+		// Deltas depend on the base file, so they are never shared.
+		if (!pf.delta) {
+			const String content_key = String::hex_encode_buffer(pf.sha256, 32) + (f.encrypted ? "e" : "");
+			const int *stored = stored_content.getptr(content_key);
+			if (stored) {
+				pf.duplicate_of = *stored;
+				pf.data.clear();
+				continue;
+			}
+			stored_content.insert(content_key, pf.file_idx);
+
+			const PackEntry *previous = previous_files.getptr(f.path);
+			if (previous && previous->encrypted == f.encrypted && (compression_enabled || !previous->compressed) && memcmp(previous->md5, pf.md5, 16) == 0) {
+				if (previous->encrypted && previous_key == PREVIOUS_KEY_UNKNOWN) {
+					previous_key = _is_encrypted_with_key(previous_pack, *previous) ? PREVIOUS_KEY_SAME : PREVIOUS_KEY_DIFFERENT;
+				}
+				if (!previous->encrypted || previous_key == PREVIOUS_KEY_SAME) {
+					pf.previous = previous;
+					pf.data.clear();
+					continue;
+				}
+			}
+		}
+
+		if (f.encrypted) {
+			// The shared generator in FileAccessEncrypted isn't thread-safe, IVs are generated here instead.
+			if (!rng_initialized) {
+				err = rng.init();
+				if (err != OK) {
+					ERR_PRINT("Failed to initialize random number generator.");
+					break;
+				}
+				rng_initialized = true;
+			}
+			pf.iv.resize(16);
+			err = rng.get_random_bytes(pf.iv.ptrw(), 16);
+			if (err != OK) {
+				break;
+			}
+		}
 	}
 
-	int pad = _get_pad(alignment, file->get_position());
-	for (int j = 0; j < pad; j++) {
-		file->store_8(0);
+	if (err == OK) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PCKPacker::_encode_pending, pending.ptr(), pending.size(), -1, false, SNAME("PCKPackerEncode"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	}
 
-	files.push_back(pf);
+	// Write in the order files were added.
+	for (uint32_t i = 0; i < pending.size() && err == OK; i++) {
+		const PendingFile &pf = pending[i];
+		File &f = files.write[pf.file_idx];
+		if (pf.error != OK) {
+			err = pf.error;
+			ERR_PRINT(vformat("Can't encode file to pack: '%s'.", f.src_path));
+			break;
+		}
 
-	return OK;
+		if (pf.duplicate_of >= 0) {
+			f.ofs = files[pf.duplicate_of].ofs;
+			f.compressed = files[pf.duplicate_of].compressed;
+			continue;
+		}
+
+		f.ofs = file->get_position();
+		if (pf.previous) {
+			f.compressed = pf.previous->compressed;
+
+			uint8_t buf[65536];
+			previous_pack->seek(pf.previous->ofs);
+			uint64_t left = pf.previous->stored_size;
+			while (left > 0) {
+				const uint64_t read = previous_pack->get_buffer(buf, MIN(left, sizeof(buf)));
+				if (read == 0) {
+					err = ERR_FILE_CORRUPT;
+					ERR_PRINT(vformat("Can't copy file from previous pack: '%s'.", f.path));
+					break;
+				}
+				file->store_buffer(buf, read);
+				left -= read;
+			}
+		} else {
+			f.compressed = pf.compressed;
+			file->store_buffer(pf.data);
+		}
+
+		int pad = _get_pad(alignment, file->get_position());
+		for (int j = 0; j < pad; j++) {
+			file->store_8(0);
+		}
+	}
+
+	pending.clear();
+	pending_size = 0;
+
+	return err;
 }
 
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	const Error write_err = _write_pending();
+	if (write_err != OK) {
+		file.unref();
+		return write_err;
+	}
+
 	int dir_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < dir_padding; i++) {
 		file->store_8(0);
@@ -213,6 +610,14 @@ Error PCKPacker::flush(bool p_verbose) {
 	uint64_t dir_offset = file->get_position();
 	file->seek(dir_base_ofs);
 	file->store_64(dir_offset);
+
+	for (const File &E : files) {
+		if (E.compressed) {
+			file->seek(version_ofs);
+			file->store_32(PACK_FORMAT_VERSION_V4);
+			break;
+		}
+	}
 	file->seek(dir_offset);
 
 	file->store_32(uint32_t(files.size()));
@@ -250,9 +655,15 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].delta) {
+			flags |= PACK_FILE_DELTA;
+		}
 		fhead->store_32(flags);
 
 		if (p_verbose) {
@@ -266,6 +677,12 @@ Error PCKPacker::flush(bool p_verbose) {
 	}
 
 	file.unref();
+	stored_content.clear();
+	previous_pack.unref();
+	previous_files.clear();
+	previous_key = PREVIOUS_KEY_UNKNOWN;
+	delta_base_path = String();
+	delta_base_files.clear();
 	return OK;
 }
 
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 class FileAccess;
 
@@ -38,12 +40,17 @@ class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
 
 	Ref<FileAccess> file;
+	String pck_path;
 	int alignment = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
+	bool compression_enabled = false;
+	int compression_block_size = 65536;
+
 	uint64_t file_base = 0;
+	uint64_t version_ofs = 0;
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
 
@@ -55,16 +62,80 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		bool removal = false;
+		bool delta = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	// Entry of a pack read back, see use_previous_pack() and use_delta_base_pack().
+	struct PackEntry {
+		uint64_t ofs = 0;
+		uint64_t size = 0;
+		uint64_t stored_size = 0;
+		uint8_t md5[16] = {};
+		bool encrypted = false;
+		bool compressed = false;
+	};
+	Error _read_pack_directory(const String &p_path, Ref<FileAccess> &r_file, HashMap<String, PackEntry> &r_entries) const;
+	Error _read_pack_entry(const String &p_pack_path, const PackEntry &p_entry, Vector<uint8_t> &r_data) const;
+
+	// Unchanged files are copied from the previous pack as stored. Encrypted ones only if the
+	// previous pack was encrypted with the same key, which is checked on the first of them.
+	enum PreviousKey {
+		PREVIOUS_KEY_UNKNOWN,
+		PREVIOUS_KEY_SAME,
+		PREVIOUS_KEY_DIFFERENT,
+	};
+	Ref<FileAccess> previous_pack;
+	HashMap<String, PackEntry> previous_files;
+	PreviousKey previous_key = PREVIOUS_KEY_UNKNOWN;
+	bool _is_encrypted_with_key(const Ref<FileAccess> &p_pack, const PackEntry &p_entry) const;
+
+	// Files also in the base pack are stored as block deltas against it when that makes them smaller.
+	static constexpr double DELTA_MIN_REDUCTION = 0.1;
+	String delta_base_path;
+	HashMap<String, PackEntry> delta_base_files;
+
+	// Files are hashed, compressed and encrypted on the WorkerThreadPool in batches, then written in the order they were added.
+	static constexpr uint64_t PENDING_BATCH_SIZE = 64 * 1024 * 1024;
+
+	struct PendingFile {
+		int file_idx = 0;
+		Vector<uint8_t> data; // Source data, replaced by the bytes to store.
+		uint8_t md5[16] = {};
+		uint8_t sha256[32] = {};
+		Vector<uint8_t> iv;
+		bool compressed = false;
+		int duplicate_of = -1; // Entry in 'files' already storing the same content.
+		const PackEntry *previous = nullptr;
+		bool delta = false;
+		Error error = OK;
+	};
+	LocalVector<PendingFile> pending;
+	uint64_t pending_size = 0;
+	HashMap<String, int> stored_content; // Content hash to the entry in 'files' storing it.
+
+	void _read_pending(uint32_t p_index, PendingFile *p_pending);
+	void _encode_pending(uint32_t p_index, PendingFile *p_pending);
+	Error _write_pending();
+
+	static Vector<uint8_t> _compress_blocks(const Vector<uint8_t> &p_data, uint32_t p_block_size);
+
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
+	Error use_previous_pack(const String &p_previous_pck_path);
+	Error use_delta_base_pack(const String &p_base_pck_path);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+
+	void set_compression_block_size(int p_block_size);
+	int get_compression_block_size() const;
+
 	~PCKPacker();
 };
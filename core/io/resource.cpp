@@ -67,6 +67,12 @@ void Resource::_unblock_emit_changed() {
 void Resource::_resource_path_changed() {
 }
 
+void Resource::_single_reference_changed() {
+	if (retained_by_cache.is_set()) {
+		ResourceCache::_update_charge(this);
+	}
+}
+
 void Resource::set_path(const String &p_path, bool p_take_over) {
 	if (path_cache == p_path) {
 		return;
@@ -799,6 +805,146 @@ Mutex ResourceCache::lock;
 RWLock ResourceCache::path_cache_lock;
 #endif
 
+Mutex ResourceCache::retain_lock;
+List<ResourceCache::Retained> ResourceCache::retained;
+HashMap<Resource *, List<ResourceCache::Retained>::Element *> ResourceCache::retained_map;
+uint64_t ResourceCache::retain_budget = 0;
+uint64_t ResourceCache::retained_memory = 0;
+SafeNumeric<uint64_t> ResourceCache::hit_count;
+SafeNumeric<uint64_t> ResourceCache::miss_count;
+SafeNumeric<uint64_t> ResourceCache::eviction_count;
+
+// Charges the resource if only the cache still references it, or un-charges it if it's in use again.
+// Called whenever its reference count goes to one or back, so the retained memory never needs a full scan.
+void ResourceCache::_update_charge(Resource *p_resource) {
+	MutexLock retain_mutex_lock(retain_lock);
+	List<Retained>::Element **E = retained_map.getptr(p_resource);
+	if (!E) {
+		return;
+	}
+
+	Retained &r = (*E)->get();
+	const bool released = p_resource->get_reference_count() == 1;
+	if (released && !r.charged) {
+		r.charged = true;
+		retained_memory += r.size;
+	} else if (!released && r.charged) {
+		r.charged = false;
+		retained_memory -= r.size;
+	}
+}
+
+// Evicts the least recently used charged resources until `p_reserve` more bytes fit in the budget.
+// Resources in use are never evicted, dropping them wouldn't free anything.
+void ResourceCache::_evict_retained(uint64_t p_reserve, LocalVector<Ref<Resource>> &r_evicted) {
+	List<Retained>::Element *E = retained.back();
+	while (E && retained_memory + p_reserve > retain_budget) {
+		List<Retained>::Element *P = E->prev();
+		Retained &r = E->get();
+		if (r.charged) {
+			// Taking a reference below must not charge it again.
+			r.resource->retained_by_cache.clear();
+			retained_memory -= r.size;
+			retained_map.erase(r.resource.ptr());
+			r_evicted.push_back(r.resource);
+			retained.erase(E);
+			eviction_count.increment();
+		}
+		E = P;
+	}
+}
+
+void ResourceCache::_retain(const Ref<Resource> &p_resource, bool p_evict) {
+	if (p_resource.is_null()) {
+		return;
+	}
+
+	// Evicted resources may be freed, so they are released after unlocking.
+	LocalVector<Ref<Resource>> evicted;
+	{
+		MutexLock retain_mutex_lock(retain_lock);
+		if (retain_budget == 0) {
+			return;
+		}
+
+		uint64_t reserve = 0;
+		List<Retained>::Element **existing = retained_map.getptr(p_resource.ptr());
+		if (existing) {
+			retained.move_to_front(*existing);
+		} else {
+			Retained r;
+			r.resource = p_resource;
+			r.size = p_resource->get_estimated_memory_usage();
+			if (r.size == 0) {
+				r.size = UNKNOWN_RESOURCE_SIZE;
+			}
+			reserve = r.size;
+			retained_map.insert(p_resource.ptr(), retained.push_front(r));
+			// The caller still holds a reference, so it starts uncharged.
+			p_resource->retained_by_cache.set();
+		}
+
+		if (p_evict) {
+			// Make room for the resource once it's released.
+			_evict_retained(reserve, evicted);
+		}
+	}
+}
+
+void ResourceCache::_notify_hit(const Ref<Resource> &p_resource) {
+	hit_count.increment();
+	_retain(p_resource, false);
+}
+
+void ResourceCache::_notify_miss(const Ref<Resource> &p_resource) {
+	miss_count.increment();
+	// Released resources are only evicted on loads, so releasing them stays cheap.
+	_retain(p_resource, true);
+}
+
+void ResourceCache::set_retain_budget(uint64_t p_bytes) {
+	LocalVector<Ref<Resource>> evicted;
+	List<Retained> to_release;
+	{
+		MutexLock retain_mutex_lock(retain_lock);
+		retain_budget = p_bytes;
+		if (retain_budget == 0) {
+			// Resources in use would otherwise stay retained after being released.
+			SWAP(to_release, retained);
+			for (Retained &r : to_release) {
+				r.resource->retained_by_cache.clear();
+			}
+			retained_map.clear();
+			retained_memory = 0;
+		} else {
+			_evict_retained(0, evicted);
+		}
+	}
+}
+
+uint64_t ResourceCache::get_retain_budget() {
+	MutexLock retain_mutex_lock(retain_lock);
+	return retain_budget;
+}
+
+uint64_t ResourceCache::get_retained_memory() {
+	MutexLock retain_mutex_lock(retain_lock);
+	return retained_memory;
+}
+
+void ResourceCache::clear_retained() {
+	List<Retained> to_release;
+	{
+		MutexLock retain_mutex_lock(retain_lock);
+		SWAP(to_release, retained);
+		for (Retained &r : to_release) {
+			r.resource->retained_by_cache.clear();
+		}
+		retained_map.clear();
+		retained_memory = 0;
+	}
+}
+
 void ResourceCache::clear() {
 	if (!resources.is_empty()) {
 		if (OS::get_singleton()->is_stdout_verbose()) {
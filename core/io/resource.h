@@ -34,6 +34,8 @@
 #include "core/object/class_db.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 
@@ -91,6 +93,7 @@ private:
 	Node *local_scene = nullptr;
 
 	SelfList<Resource> remapped_list;
+	SafeFlag retained_by_cache; // Skips looking up the retained resources on every release.
 
 	using DuplicateRemapCacheT = HashMap<Ref<Resource>, Ref<Resource>>;
 	static thread_local inline DuplicateRemapCacheT *thread_duplicate_remap_cache = nullptr;
@@ -106,6 +109,7 @@ private:
 
 protected:
 	virtual void _resource_path_changed();
+	virtual void _single_reference_changed() override;
 	static void _bind_methods();
 
 	void _block_emit_changed();
@@ -183,6 +187,7 @@ public:
 	void set_as_translation_remapped(bool p_remapped);
 
 	virtual RID get_rid() const; // Some resources may offer conversion to RID.
+	virtual uint64_t get_estimated_memory_usage() const { return 0; } // Rough size of the data kept alive by this resource, used to budget the resource cache. Zero if unknown.
 
 	// Helps keep IDs the same when loading/saving scenes. An empty ID clears the entry, and an empty ID is returned when not found.
 	static void set_resource_id_for_path(const String &p_referrer_path, const String &p_resource_path, const String &p_id);
@@ -204,13 +209,50 @@ class ResourceCache {
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
 #endif // TOOLS_ENABLED
+
+	// With a budget set, recently loaded or reused resources are kept alive even after
+	// everyone else releases them, and the least recently used are dropped past the budget.
+	// Only resources the cache holds the last reference to are charged against the budget,
+	// which is kept up to date as their reference count goes to one and back.
+	struct Retained {
+		Ref<Resource> resource;
+		uint64_t size = 0;
+		bool charged = false;
+	};
+	static Mutex retain_lock;
+	static List<Retained> retained; // Most recently used first.
+	static HashMap<Resource *, List<Retained>::Element *> retained_map;
+	static uint64_t retain_budget;
+	static uint64_t retained_memory;
+	static SafeNumeric<uint64_t> hit_count;
+	static SafeNumeric<uint64_t> miss_count;
+	static SafeNumeric<uint64_t> eviction_count;
+
+	static void _retain(const Ref<Resource> &p_resource, bool p_evict);
+	static void _evict_retained(uint64_t p_reserve, LocalVector<Ref<Resource>> &r_evicted);
+	static void _update_charge(Resource *p_resource);
+	static void _notify_hit(const Ref<Resource> &p_resource);
+	static void _notify_miss(const Ref<Resource> &p_resource);
+
 	friend void unregister_core_types();
 	static void clear();
 	friend void register_core_types();
 
 public:
+	// Resources whose size is unknown are charged this much against the budget.
+	static constexpr uint64_t UNKNOWN_RESOURCE_SIZE = 4096;
+
 	static bool has(const String &p_path);
 	static Ref<Resource> get_ref(const String &p_path);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+
+	static void set_retain_budget(uint64_t p_bytes);
+	static uint64_t get_retain_budget();
+	static uint64_t get_retained_memory();
+	static void clear_retained();
+
+	static uint64_t get_hit_count() { return hit_count.get(); }
+	static uint64_t get_miss_count() { return miss_count.get(); }
+	static uint64_t get_eviction_count() { return eviction_count.get(); }
 };
@@ -33,8 +33,11 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_io_queue.h"
+#include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/variant/variant_internal.h"
 #include "core/version.h"
 #include "scene/property_utils.h"
 #include "scene/resources/packed_scene.h"
@@ -86,6 +89,7 @@ enum {
 	VARIANT_VECTOR4I = 51,
 	VARIANT_PROJECTION = 52,
 	VARIANT_PACKED_VECTOR4_ARRAY = 53,
+	VARIANT_PACKED_ARRAY_BLOB = 54,
 	OBJECT_EMPTY = 0,
 	OBJECT_EXTERNAL_RESOURCE = 1,
 	OBJECT_INTERNAL_RESOURCE = 2,
@@ -95,9 +99,11 @@ enum {
 	// Version 4: New string ID for ext/subresources, breaks forward compat.
 	// Version 5: Ability to store script class in the header.
 	// Version 6: Added PackedVector4Array Variant type.
-	FORMAT_VERSION = 6,
+	// Version 7: Large packed arrays stored in an aligned blob section after the resources.
+	FORMAT_VERSION = 7,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_PACKED_ARRAY_BLOBS = 7,
 };
 
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
@@ -153,6 +159,38 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	return OK;
 }
 
+// Blob contents are always little endian, and vectors use the precision of the file.
+template <typename T, typename W>
+static Vector<T> blob_to_array(const uint8_t *p_src, uint32_t p_len, uint32_t p_file_real_size) {
+	Vector<T> array;
+	array.resize(p_len);
+	if constexpr (std::is_same_v<T, Vector2> || std::is_same_v<T, Vector3> || std::is_same_v<T, Vector4>) {
+		if (p_file_real_size != sizeof(real_t)) {
+			real_t *w = reinterpret_cast<real_t *>(array.ptrw());
+			const uint32_t count = p_len * (sizeof(T) / sizeof(real_t));
+			for (uint32_t i = 0; i < count; i++) {
+				w[i] = p_file_real_size == sizeof(double) ? decode_double(p_src + i * sizeof(double)) : decode_float(p_src + i * sizeof(float));
+			}
+			return array;
+		}
+	}
+	memcpy(array.ptrw(), p_src, size_t(p_len) * sizeof(T));
+#ifdef BIG_ENDIAN_ENABLED
+	if constexpr (sizeof(W) > 1) {
+		W *ptr = reinterpret_cast<W *>(array.ptrw());
+		const size_t count = size_t(p_len) * (sizeof(T) / sizeof(W));
+		for (size_t i = 0; i < count; i++) {
+			if constexpr (sizeof(W) == 8) {
+				ptr[i] = BSWAP64(ptr[i]);
+			} else {
+				ptr[i] = BSWAP32(ptr[i]);
+			}
+		}
+	}
+#endif
+	return array;
+}
+
 StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
@@ -407,6 +445,18 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						path += res_path + "::" + itos(index);
 					}
 
+					if (!sub_resource_id.is_empty() && using_named_scene_ids && !internal_index_cache.has(path)) {
+						// Only a sub-resource is being loaded, so the resources it uses are parsed on first reference.
+						const uint64_t pos = f->get_position();
+						Ref<Resource> res;
+						Error err = _parse_internal_resource(index, false, res);
+						f->seek(pos);
+						if (err) {
+							return err;
+						}
+						path = internal_resources[index].path;
+					}
+
 					//always use internal cache for loading internal resources
 					if (!internal_index_cache.has(path)) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
@@ -666,6 +716,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 
 		} break;
+		case VARIANT_PACKED_ARRAY_BLOB: {
+			Error err = _parse_packed_array_blob(r_v);
+			if (err) {
+				return err;
+			}
+		} break;
 		default: {
 			ERR_FAIL_V(ERR_FILE_CORRUPT);
 		} break;
@@ -674,223 +730,368 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 	return OK; //never reach anyway
 }
 
+Error ResourceLoaderBinary::_parse_packed_array_blob(Variant &r_v) {
+	uint32_t array_type = f->get_32();
+	uint32_t len = f->get_32();
+	uint64_t offset = f->get_64();
+
+	ERR_FAIL_COND_V_MSG(blob_section_offset == 0, ERR_FILE_CORRUPT, vformat("'%s': Packed array stored in a blob, but the file has no blob section.", local_path));
+
+	const uint32_t real_size = f->real_is_double ? sizeof(double) : sizeof(float);
+	uint64_t element_size = 0;
+	switch (array_type) {
+		case VARIANT_PACKED_BYTE_ARRAY:
+			element_size = 1;
+			break;
+		case VARIANT_PACKED_INT32_ARRAY:
+		case VARIANT_PACKED_FLOAT32_ARRAY:
+			element_size = 4;
+			break;
+		case VARIANT_PACKED_INT64_ARRAY:
+		case VARIANT_PACKED_FLOAT64_ARRAY:
+			element_size = 8;
+			break;
+		case VARIANT_PACKED_COLOR_ARRAY:
+			element_size = 4 * sizeof(float);
+			break;
+		case VARIANT_PACKED_VECTOR2_ARRAY:
+			element_size = 2 * real_size;
+			break;
+		case VARIANT_PACKED_VECTOR3_ARRAY:
+			element_size = 3 * real_size;
+			break;
+		case VARIANT_PACKED_VECTOR4_ARRAY:
+			element_size = 4 * real_size;
+			break;
+		default: {
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+	}
+
+	const uint64_t size = element_size * len;
+	const uint64_t from = blob_section_offset + offset;
+
+	// Read straight from memory when the file is mapped, otherwise fetch the blob and return to the property list.
+	const uint8_t *src = nullptr;
+	Vector<uint8_t> buffer;
+	Span<uint8_t> mapped = f->get_mapped_span();
+	if (!mapped.is_empty()) {
+		ERR_FAIL_COND_V(from + size > mapped.size(), ERR_FILE_CORRUPT);
+		src = mapped.ptr() + from;
+	} else {
+		ERR_FAIL_COND_V(from + size > f->get_length(), ERR_FILE_CORRUPT);
+		const uint64_t pos = f->get_position();
+		buffer.resize(size);
+		f->seek(from);
+		const uint64_t read = f->get_buffer(buffer.ptrw(), size);
+		f->seek(pos);
+		ERR_FAIL_COND_V(read != size, ERR_FILE_CORRUPT);
+		src = buffer.ptr();
+	}
+
+	switch (array_type) {
+		case VARIANT_PACKED_BYTE_ARRAY: {
+			r_v = blob_to_array<uint8_t, uint8_t>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_INT32_ARRAY: {
+			r_v = blob_to_array<int32_t, uint32_t>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_INT64_ARRAY: {
+			r_v = blob_to_array<int64_t, uint64_t>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_FLOAT32_ARRAY: {
+			r_v = blob_to_array<float, uint32_t>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_FLOAT64_ARRAY: {
+			r_v = blob_to_array<double, uint64_t>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_COLOR_ARRAY: {
+			static_assert(sizeof(Color) == 4 * sizeof(float));
+			r_v = blob_to_array<Color, uint32_t>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_VECTOR2_ARRAY: {
+			r_v = blob_to_array<Vector2, std::conditional_t<sizeof(real_t) == 8, uint64_t, uint32_t>>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_VECTOR3_ARRAY: {
+			r_v = blob_to_array<Vector3, std::conditional_t<sizeof(real_t) == 8, uint64_t, uint32_t>>(src, len, real_size);
+		} break;
+		case VARIANT_PACKED_VECTOR4_ARRAY: {
+			r_v = blob_to_array<Vector4, std::conditional_t<sizeof(real_t) == 8, uint64_t, uint32_t>>(src, len, real_size);
+		} break;
+	}
+
+	return OK;
+}
+
 Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
+Error ResourceLoaderBinary::_parse_internal_resource(int p_index, bool p_main, Ref<Resource> &r_res) {
+	//maybe it is loaded already
+	String path;
+	String id;
 
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+	if (!p_main) {
+		path = internal_resources[p_index].path;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+			internal_resources.write[p_index].path = path; // Update path.
 		}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (external_resources[i].load_token.is_null()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				r_res = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	uint64_t offset = internal_resources[p_index].offset;
+
+	f->seek(offset);
 
-		//maybe it is loaded already
-		String path;
-		String id;
+	String t = get_unicode_string();
 
-		if (!main) {
-			path = internal_resources[i].path;
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	MissingResource *missing_resource = nullptr;
 
-				internal_resources.write[i].path = path; // Update path.
+	if (p_main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
+				} else {
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
 				}
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
 			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
+		}
+		r->set_scene_unique_id(id);
+	}
 
-		f->seek(offset);
+	if (!p_main) {
+		internal_index_cache[path] = res;
+	}
 
-		String t = get_unicode_string();
+	int pc = f->get_32();
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+	//set properties
 
-		MissingResource *missing_resource = nullptr;
+	Dictionary missing_resource_properties;
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
-			}
 
-			if (res.is_null()) {
-				//did not replace
+		Variant value;
 
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
-					}
-				}
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
-				}
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-				res = Ref<Resource>(r);
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
 			}
-			r->set_scene_unique_id(id);
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
+				}
+			}
 		}
 
-		int pc = f->get_32();
+		if (set_valid) {
+			res->set(name, value);
+		}
+	}
 
-		//set properties
+	if (missing_resource) {
+		missing_resource->set_recording_properties(false);
+	}
 
-		Dictionary missing_resource_properties;
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	resource_cache.push_back(res);
 
-			Variant value;
+	r_res = res;
+	return OK;
+}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+		if (remaps.has(path)) {
+			path = remaps[path];
+		}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+		if (!path.contains("://") && path.is_relative_path()) {
+			// path is relative to file being loaded, so convert to a resource path
+			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		}
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
-				}
+		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+	}
+
+	// Get the files of all dependencies in flight before loading them one by one. Without sub-threads they are
+	// loaded right here in order, so this only helps if the backend doesn't read them a second time.
+	if (external_resources.size() > 1 && (use_sub_threads || FileIOQueue::get_singleton()->is_asynchronous())) {
+		for (const ExtResource &er : external_resources) {
+			if (!ResourceCache::has(er.path)) {
+				FileIOQueue::get_singleton()->prefetch_resource(er.path);
 			}
+		}
+	}
 
-			if (set_valid) {
-				res->set(name, value);
+	for (int i = 0; i < external_resources.size(); i++) {
+		const String path = external_resources[i].path;
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+		if (external_resources[i].load_token.is_null()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
 			}
 		}
+	}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+	if (!sub_resource_id.is_empty()) {
+		if (!using_named_scene_ids) {
+			error = ERR_UNAVAILABLE;
+			ERR_FAIL_V_MSG(error, vformat("'%s': Sub-resources can't be loaded on their own from files this old.", local_path));
 		}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+		for (int i = 0; i < internal_resources.size() - 1; i++) {
+			if (internal_resources[i].path != "local://" + sub_resource_id) {
+				continue;
+			}
+
+			Ref<Resource> res;
+			error = _parse_internal_resource(i, false, res);
+			if (error) {
+				return error;
+			}
+
+			f.unref();
+			resource = res;
+			return OK;
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		error = ERR_DOES_NOT_EXIST;
+		ERR_FAIL_V_MSG(error, vformat("'%s': No sub-resource with ID '%s'.", local_path, sub_resource_id));
+	}
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+
+		Ref<Resource> res;
+		error = _parse_internal_resource(i, main, res);
+		if (error) {
+			return error;
+		}
 
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
 
-		resource_cache.push_back(res);
-
 		if (main) {
 			f.unref();
 			resource = res;
@@ -1110,6 +1311,10 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 
 	print_bl("int resources: " + itos(int_resources_size));
 
+	if (ver_format >= FORMAT_VERSION_PACKED_ARRAY_BLOBS) {
+		blob_section_offset = f->get_64();
+	}
+
 	if (f->eof_reached()) {
 		error = ERR_FILE_CORRUPT;
 		f.unref();
@@ -1214,10 +1419,19 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 		*r_error = ERR_FILE_CANT_OPEN;
 	}
 
+	// A path like "res://file.res::id" loads only that sub-resource.
+	String file_path = p_path;
+	String sub_resource_id;
+	int sub_resource_sep = p_path.find("::");
+	if (sub_resource_sep != -1) {
+		file_path = p_path.substr(0, sub_resource_sep);
+		sub_resource_id = p_path.substr(sub_resource_sep + 2);
+	}
+
 	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ, &err);
 
-	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), vformat("Cannot open file '%s'.", p_path));
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), vformat("Cannot open file '%s'.", file_path));
 
 	ResourceLoaderBinary loader;
 	switch (p_cache_mode) {
@@ -1241,6 +1455,14 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
+	if (!sub_resource_id.is_empty()) {
+		int sep = loader.local_path.find("::");
+		if (sep != -1) {
+			loader.local_path = loader.local_path.substr(0, sep);
+			loader.res_path = loader.local_path;
+		}
+		loader.sub_resource_id = sub_resource_id;
+	}
 	loader.open(f);
 
 	err = loader.load();
@@ -1255,6 +1477,12 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	return loader.resource;
 }
 
+bool ResourceFormatLoaderBinary::recognize_path(const String &p_path, const String &p_for_type) const {
+	// Sub-resources are recognized by the file they are stored in.
+	int sep = p_path.find("::");
+	return ResourceFormatLoader::recognize_path(sep == -1 ? p_path : p_path.substr(0, sep), p_for_type);
+}
+
 void ResourceFormatLoaderBinary::get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const {
 	if (p_type.is_empty()) {
 		get_recognized_extensions(p_extensions);
@@ -1293,11 +1521,15 @@ bool ResourceFormatLoaderBinary::handles_type(const String &p_type) const {
 }
 
 void ResourceFormatLoaderBinary::get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types) {
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
-	ERR_FAIL_COND_MSG(f.is_null(), vformat("Cannot open file '%s'.", p_path));
+	// A sub-resource may use any of the dependencies of its file.
+	int sep = p_path.find("::");
+	const String file_path = sep == -1 ? p_path : p_path.substr(0, sep);
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	ERR_FAIL_COND_MSG(f.is_null(), vformat("Cannot open file '%s'.", file_path));
 
 	ResourceLoaderBinary loader;
-	loader.local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	loader.local_path = ProjectSettings::get_singleton()->localize_path(file_path);
 	loader.res_path = loader.local_path;
 	loader.get_dependencies(f, p_dependencies, p_add_types);
 }
@@ -1473,6 +1705,17 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 
 	int64_t size_diff = (int64_t)fw->get_position() - (int64_t)f->get_position();
 
+	// Nothing reads the gap between the tables and the first resource, so it can be padded to keep blobs aligned.
+	uint32_t blob_padding = 0;
+	if (ver_format >= FORMAT_VERSION_PACKED_ARRAY_BLOBS) {
+		const int64_t alignment = ResourceFormatSaverBinaryInstance::BLOB_ALIGNMENT;
+		blob_padding = uint32_t(((size_diff % alignment) + alignment) % alignment);
+		if (blob_padding > 0) {
+			blob_padding = alignment - blob_padding;
+		}
+		size_diff += blob_padding;
+	}
+
 	//internal resources
 	uint32_t int_resources_size = f->get_32();
 	fw->store_32(int_resources_size);
@@ -1484,6 +1727,14 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 		fw->store_64(offset + size_diff);
 	}
 
+	if (ver_format >= FORMAT_VERSION_PACKED_ARRAY_BLOBS) {
+		uint64_t blob_ofs = f->get_64();
+		fw->store_64(blob_ofs ? blob_ofs + size_diff : 0);
+		for (uint32_t i = 0; i < blob_padding; i++) {
+			fw->store_8(0);
+		}
+	}
+
 	//rest of file
 	uint8_t b = f->get_8();
 	while (!f->eof_reached()) {
@@ -1615,7 +1866,75 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
-void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
+template <typename T>
+static Span<uint8_t> packed_array_bytes(const Vector<T> *p_array, uint32_t &r_len) {
+	r_len = p_array->size();
+	return Span<uint8_t>(reinterpret_cast<const uint8_t *>(p_array->ptr()), uint64_t(p_array->size()) * sizeof(T));
+}
+
+// Raw contents of the packed arrays that can be stored as blobs, empty for any other type.
+static Span<uint8_t> packed_array_blob_bytes(const Variant &p_array, uint32_t &r_blob_type, uint32_t &r_len) {
+	switch (p_array.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			r_blob_type = VARIANT_PACKED_BYTE_ARRAY;
+			return packed_array_bytes(VariantInternal::get_byte_array(&p_array), r_len);
+		case Variant::PACKED_INT32_ARRAY:
+			r_blob_type = VARIANT_PACKED_INT32_ARRAY;
+			return packed_array_bytes(VariantInternal::get_int32_array(&p_array), r_len);
+		case Variant::PACKED_INT64_ARRAY:
+			r_blob_type = VARIANT_PACKED_INT64_ARRAY;
+			return packed_array_bytes(VariantInternal::get_int64_array(&p_array), r_len);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			r_blob_type = VARIANT_PACKED_FLOAT32_ARRAY;
+			return packed_array_bytes(VariantInternal::get_float32_array(&p_array), r_len);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			r_blob_type = VARIANT_PACKED_FLOAT64_ARRAY;
+			return packed_array_bytes(VariantInternal::get_float64_array(&p_array), r_len);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			r_blob_type = VARIANT_PACKED_VECTOR2_ARRAY;
+			return packed_array_bytes(VariantInternal::get_vector2_array(&p_array), r_len);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			r_blob_type = VARIANT_PACKED_VECTOR3_ARRAY;
+			return packed_array_bytes(VariantInternal::get_vector3_array(&p_array), r_len);
+		case Variant::PACKED_COLOR_ARRAY:
+			r_blob_type = VARIANT_PACKED_COLOR_ARRAY;
+			return packed_array_bytes(VariantInternal::get_color_array(&p_array), r_len);
+		case Variant::PACKED_VECTOR4_ARRAY:
+			r_blob_type = VARIANT_PACKED_VECTOR4_ARRAY;
+			return packed_array_bytes(VariantInternal::get_vector4_array(&p_array), r_len);
+		default:
+			r_len = 0;
+			return Span<uint8_t>();
+	}
+}
+
+bool ResourceFormatSaverBinaryInstance::_write_packed_array_blob(Ref<FileAccess> f, const Variant &p_property, BlobSection &r_blobs) {
+	uint32_t blob_type = 0;
+	uint32_t len = 0;
+	Span<uint8_t> bytes = packed_array_blob_bytes(p_property, blob_type, len);
+	if (bytes.size() < BLOB_MIN_SIZE) {
+		return false;
+	}
+
+	if (r_blobs.size % BLOB_ALIGNMENT) {
+		r_blobs.size += BLOB_ALIGNMENT - r_blobs.size % BLOB_ALIGNMENT;
+	}
+
+	f->store_32(VARIANT_PACKED_ARRAY_BLOB);
+	f->store_32(blob_type);
+	f->store_32(len);
+	f->store_64(r_blobs.size);
+
+	r_blobs.arrays.push_back(p_property);
+	r_blobs.size += bytes.size();
+	return true;
+}
+
+void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint, BlobSection *r_blobs) {
+	if (r_blobs && _write_packed_array_blob(f, p_property, *r_blobs)) {
+		return;
+	}
+
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
 			f->store_32(VARIANT_NIL);
@@ -1900,8 +2219,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			f->store_32(uint32_t(d.size()));
 
 			for (const KeyValue<Variant, Variant> &kv : d) {
-				write_variant(f, kv.key, resource_map, external_resources, string_map);
-				write_variant(f, kv.value, resource_map, external_resources, string_map);
+				write_variant(f, kv.key, resource_map, external_resources, string_map, PropertyInfo(), r_blobs);
+				write_variant(f, kv.value, resource_map, external_resources, string_map, PropertyInfo(), r_blobs);
 			}
 
 		} break;
@@ -1910,7 +2229,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Array a = p_property;
 			f->store_32(uint32_t(a.size()));
 			for (const Variant &var : a) {
-				write_variant(f, var, resource_map, external_resources, string_map);
+				write_variant(f, var, resource_map, external_resources, string_map, PropertyInfo(), r_blobs);
 			}
 
 		} break;
@@ -2372,6 +2691,19 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 		resource_map[r] = res_index++;
 	}
 
+	uint64_t blob_ofs_pos = f->get_position();
+	f->store_64(0); // Offset to the blob section, if any.
+
+	// Blobs are stored as they are in memory, which is only the file's byte order on little endian hosts.
+	BlobSection blobs;
+	BlobSection *blobs_ptr = &blobs;
+#ifdef BIG_ENDIAN_ENABLED
+	blobs_ptr = nullptr;
+#endif
+	if (big_endian) {
+		blobs_ptr = nullptr;
+	}
+
 	Vector<uint64_t> ofs_table;
 
 	//now actually save the resources
@@ -2382,10 +2714,31 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 		for (const Property &p : rd.properties) {
 			f->store_32(uint32_t(p.name_idx));
-			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi);
+			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi, blobs_ptr);
 		}
 	}
 
+	if (!blobs.arrays.is_empty()) {
+		uint64_t blob_section_ofs = f->get_position();
+		while (blob_section_ofs % BLOB_ALIGNMENT) {
+			f->store_8(0);
+			blob_section_ofs++;
+		}
+
+		for (const Variant &array : blobs.arrays) {
+			uint32_t blob_type = 0;
+			uint32_t len = 0;
+			Span<uint8_t> bytes = packed_array_blob_bytes(array, blob_type, len);
+			while ((f->get_position() - blob_section_ofs) % BLOB_ALIGNMENT) {
+				f->store_8(0);
+			}
+			f->store_buffer(bytes.ptr(), bytes.size());
+		}
+
+		f->seek(blob_ofs_pos);
+		f->store_64(blob_section_ofs);
+	}
+
 	for (int i = 0; i < ofs_table.size(); i++) {
 		f->seek(ofs_pos[i]);
 		f->store_64(ofs_table[i]);
@@ -33,6 +33,7 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 
 class ResourceLoaderBinary {
@@ -78,6 +79,10 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	// When set, only this sub-resource is loaded, and the ones it refers to are parsed on first reference.
+	String sub_resource_id;
+	uint64_t blob_section_offset = 0;
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
 
@@ -90,6 +95,8 @@ class ResourceLoaderBinary {
 	friend class ResourceFormatLoaderBinary;
 
 	Error parse_variant(Variant &r_v);
+	Error _parse_packed_array_blob(Variant &r_v);
+	Error _parse_internal_resource(int p_index, bool p_main, Ref<Resource> &r_res);
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
@@ -111,6 +118,7 @@ class ResourceFormatLoaderBinary : public ResourceFormatLoader {
 
 public:
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
+	virtual bool recognize_path(const String &p_path, const String &p_for_type = String()) const override;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const override;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
 	virtual bool handles_type(const String &p_type) const override;
@@ -159,7 +167,14 @@ class ResourceFormatSaverBinaryInstance {
 		List<Property> properties;
 	};
 
+	// Large packed arrays, stored after the resources so they can be read in one go (or straight from a mapping).
+	struct BlobSection {
+		LocalVector<Variant> arrays;
+		uint64_t size = 0;
+	};
+
 	static void _pad_buffer(Ref<FileAccess> f, int p_bytes);
+	static bool _write_packed_array_blob(Ref<FileAccess> f, const Variant &p_property, BlobSection &r_blobs);
 	void _find_resources(const Variant &p_variant, bool p_main = false);
 	static void save_unicode_string(Ref<FileAccess> f, const String &p_string, bool p_bit_on_len = false);
 	int get_string_index(const String &p_string);
@@ -172,11 +187,15 @@ public:
 		FORMAT_FLAG_HAS_SCRIPT_CLASS = 8,
 
 		// Amount of reserved 32-bit fields in resource header
-		RESERVED_FIELDS = 11
+		RESERVED_FIELDS = 11,
+
+		// Packed arrays of at least this many bytes go to the blob section, aligned to BLOB_ALIGNMENT.
+		BLOB_MIN_SIZE = 1024,
+		BLOB_ALIGNMENT = 64,
 	};
 	Error save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags = 0);
 	Error set_uid(const String &p_path, ResourceUID::ID p_uid);
-	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo());
+	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo(), BlobSection *r_blobs = nullptr);
 };
 
 class ResourceFormatSaverBinary : public ResourceFormatSaver {
@@ -389,6 +389,14 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	}
 	// --
 
+	load_task.start_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Held until the load is done, so dependencies loaded ahead of time aren't freed before being used.
+	LocalVector<Ref<LoadToken>> dependency_tokens;
+	if (load_task.start_dependencies) {
+		dependency_tokens = _start_dependency_loads(load_task.local_path);
+	}
+
 	bool xl_remapped = false;
 	const String &remapped_path = _path_remap(load_task.local_path, &xl_remapped);
 
@@ -398,10 +406,21 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 		MessageQueue::get_singleton()->flush();
 	}
 
+	// The loader may not have asked for all of them, but their tasks must be done before the tokens are released.
+	for (Ref<LoadToken> &token : dependency_tokens) {
+		_load_complete(*token.ptr(), nullptr);
+	}
+
 	thread_load_mutex.lock();
 
 	load_task.resource = res;
 
+	const uint64_t load_usec = OS::get_singleton()->get_ticks_usec() - load_task.start_usec;
+	load_task.critical_path_usec = (load_usec > load_task.blocked_usec ? load_usec - load_task.blocked_usec : 0) + load_task.dependency_critical_path_usec;
+	if (!dependency_tokens.is_empty()) {
+		print_verbose(vformat("Loaded \"%s\" in %.2f ms, with %d dependencies started ahead. Critical path: %.2f ms.", load_task.local_path, load_usec / 1000.0, dependency_tokens.size(), load_task.critical_path_usec / 1000.0));
+	}
+
 	load_task.progress = 1.0; // It was fully loaded at this point, so force progress to 1.0.
 	load_task.error = load_err;
 	if (load_task.error != OK) {
@@ -448,6 +467,7 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 			if (pending_unlock) {
 				ResourceCache::lock.unlock();
 			}
+			ResourceCache::_notify_miss(load_task.resource);
 		} else {
 			load_task.resource->set_path_cache(load_task.local_path);
 		}
@@ -502,6 +522,104 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	curr_load_task = curr_load_task_backup;
 }
 
+// Splits an entry of get_dependencies(), falling back to the stored path if the UID is unknown.
+static void _parse_dependency(const String &p_dependency, const String &p_dependent, String &r_path, String &r_type) {
+	const Vector<String> parts = p_dependency.split("::");
+	r_path = parts[0];
+	r_type = parts.size() > 1 ? parts[1] : String();
+
+	if (r_path.begins_with("uid://")) {
+		const ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(r_path);
+		if (uid != ResourceUID::INVALID_ID && ResourceUID::get_singleton()->has_id(uid)) {
+			r_path = ResourceUID::get_singleton()->get_id_path(uid);
+		} else {
+			r_path = parts.size() > 2 ? parts[2] : String();
+		}
+	}
+
+	if (!r_path.is_empty() && !r_path.contains("://") && r_path.is_relative_path()) {
+		r_path = ProjectSettings::get_singleton()->localize_path(p_dependent.get_base_dir().path_join(r_path));
+	}
+}
+
+// Reads the dependency tables of the whole tree up front and starts loading every dependency at once,
+// so the load is bounded by the depth of the tree rather than discovering it one level at a time.
+// Dependents are started before their dependencies, as pool tasks can only await newer tasks without
+// having to load them again.
+LocalVector<Ref<ResourceLoader::LoadToken>> ResourceLoader::_start_dependency_loads(const String &p_local_path) {
+	struct Dependency {
+		String path;
+		String type;
+		LocalVector<uint32_t> dependencies;
+		uint32_t dependents = 0;
+	};
+	LocalVector<Dependency> graph;
+	HashMap<String, uint32_t> indices;
+
+	graph.resize(1);
+	graph[0].path = p_local_path;
+	indices.insert(p_local_path, 0);
+
+	for (uint32_t i = 0; i < graph.size(); i++) {
+		List<String> dependencies;
+		get_dependencies(graph[i].path, &dependencies, true);
+
+		for (const String &E : dependencies) {
+			String path;
+			String type;
+			_parse_dependency(E, graph[i].path, path, type);
+			if (path.is_empty() || ResourceCache::has(path)) {
+				continue; // Cached resources have their own dependencies loaded already.
+			}
+
+			uint32_t index;
+			HashMap<String, uint32_t>::Iterator I = indices.find(path);
+			if (I) {
+				index = I->value;
+			} else {
+				index = graph.size();
+				indices.insert(path, index);
+				graph.resize(index + 1);
+				graph[index].path = path;
+				graph[index].type = type;
+			}
+			graph[i].dependencies.push_back(index);
+			graph[index].dependents++;
+		}
+	}
+
+	LocalVector<Ref<LoadToken>> tokens;
+	LocalVector<uint32_t> ready;
+	ready.push_back(0);
+	while (!ready.is_empty()) {
+		const uint32_t index = ready[ready.size() - 1];
+		ready.resize(ready.size() - 1);
+		if (index != 0) {
+			Ref<LoadToken> token = _load_start(graph[index].path, graph[index].type, LOAD_THREAD_DISTRIBUTE, ResourceFormatLoader::CACHE_MODE_REUSE);
+			if (token.is_valid()) {
+				tokens.push_back(token);
+			}
+		}
+		for (uint32_t dependency : graph[index].dependencies) {
+			if (--graph[dependency].dependents == 0) {
+				ready.push_back(dependency);
+			}
+		}
+	}
+
+	// Dependencies in cycles are never ready, start them anyway.
+	for (uint32_t i = 1; i < graph.size(); i++) {
+		if (graph[i].dependents > 0) {
+			Ref<LoadToken> token = _load_start(graph[i].path, graph[i].type, LOAD_THREAD_DISTRIBUTE, ResourceFormatLoader::CACHE_MODE_REUSE);
+			if (token.is_valid()) {
+				tokens.push_back(token);
+			}
+		}
+	}
+
+	return tokens;
+}
+
 String ResourceLoader::_validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -613,9 +731,12 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			// Dependencies share the cache only if it isn't ignored or replaced deeply.
+			load_task.start_dependencies = p_for_user && load_task.use_sub_threads && p_cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP && p_cache_mode != ResourceFormatLoader::CACHE_MODE_REPLACE_DEEP;
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
+					ResourceCache::_notify_hit(existing);
 					//referencing is fine
 					load_task.resource = existing;
 					load_task.status = THREAD_LOAD_LOADED;
@@ -657,7 +778,12 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	} // MutexLock(thread_load_mutex).
 
 	if (p_thread_mode == LOAD_THREAD_FROM_CURRENT) {
+		ThreadLoadTask *outer_load_task = curr_load_task;
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
 		_run_load_task(load_task_ptr);
+		if (outer_load_task) {
+			outer_load_task->blocked_usec += OS::get_singleton()->get_ticks_usec() - start_usec;
+		}
 	}
 
 	return load_token;
@@ -824,6 +950,7 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 				return Ref<Resource>();
 			}
 
+			const uint64_t wait_start_usec = OS::get_singleton()->get_ticks_usec();
 			bool loader_is_wtp = load_task.task_id != 0;
 			if (loader_is_wtp) {
 				// Loading thread is in the worker pool.
@@ -872,6 +999,9 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 
 				DEV_ASSERT(load_task.status == THREAD_LOAD_FAILED || load_task.status == THREAD_LOAD_LOADED);
 			}
+			if (curr_load_task) {
+				curr_load_task->blocked_usec += OS::get_singleton()->get_ticks_usec() - wait_start_usec;
+			}
 		}
 
 		if (cleaning_tasks) {
@@ -879,6 +1009,10 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 			load_task.error = FAILED;
 		}
 
+		if (curr_load_task && curr_load_task != &load_task && load_task.status != THREAD_LOAD_IN_PROGRESS) {
+			curr_load_task->dependency_critical_path_usec = MAX(curr_load_task->dependency_critical_path_usec, load_task.critical_path_usec);
+		}
+
 		load_task_ptr = &load_task;
 	}
 
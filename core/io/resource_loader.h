@@ -190,10 +190,17 @@ private:
 		Ref<Resource> resource;
 		HashSet<String> sub_tasks;
 
+		// Critical path tracking. Blocked time (awaiting or running other loads) isn't part of the load's own time.
+		uint64_t start_usec = 0;
+		uint64_t blocked_usec = 0;
+		uint64_t dependency_critical_path_usec = 0;
+		uint64_t critical_path_usec = 0;
+
 		bool awaited : 1; // If it's in the pool, this helps not awaiting from more than one dependent thread.
 		bool need_wait : 1;
 		bool in_progress_check : 1; // Measure against recursion cycles in progress reporting. Cycles are not expected, but can happen due to how it's currently implemented.
 		bool use_sub_threads : 1;
+		bool start_dependencies : 1; // Start loading the whole dependency tree before parsing the resource.
 
 		struct ResourceChangedConnection {
 			Resource *source = nullptr;
@@ -206,9 +213,11 @@ private:
 				awaited(false),
 				need_wait(true),
 				in_progress_check(false),
-				use_sub_threads(false) {}
+				use_sub_threads(false),
+				start_dependencies(false) {}
 	};
 	static void _run_load_task(void *p_userdata);
+	static LocalVector<Ref<LoadToken>> _start_dependency_loads(const String &p_local_path);
 
 	static thread_local bool import_thread;
 	static thread_local int load_nesting;
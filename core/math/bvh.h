@@ -313,6 +313,94 @@ public:
 		_check_for_collisions();
 	}
 
+	// Pairing changes of the changed items can also be found on several threads, then applied in an order
+	// of the caller's choosing: call update_tree() instead of update(), find_pair_changes() for every changed
+	// item, then apply_pair_changes() with all the results.
+	struct PairChange {
+		BVHHandle handle_a; // The lower handle, like in the callbacks.
+		BVHHandle handle_b;
+		T *userdata_a = nullptr;
+		int subindex_a = 0;
+		T *userdata_b = nullptr;
+		int subindex_b = 0;
+	};
+
+	void update_tree() {
+		BVH_LOCKED_FUNCTION
+		tree.update();
+	}
+
+	uint32_t get_changed_item_count() const {
+		return changed_items.size();
+	}
+
+	// Only reads the BVH, so it can run for several items at once as long as nothing modifies the BVH meanwhile.
+	// Pairs between two changed items are found from both sides, see apply_pair_changes().
+	void find_pair_changes(uint32_t p_changed_item, LocalVector<uint32_t> &r_cull_hits, LocalVector<PairChange> &r_pairs, LocalVector<PairChange> &r_unpairs) {
+		const BVHHandle h = changed_items[p_changed_item];
+
+		// use the expanded aabb for pairing
+		BVHABB_CLASS abb;
+		abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		// existing pairs that no longer overlap
+		const typename BVHTREE_CLASS::ItemPairs &pairs = tree._pairs[h.id()];
+		for (int n = 0; n < pairs.num_pairs; n++) {
+			const BVHHandle h_to = pairs.extended_pairs[n].handle;
+			BVHABB_CLASS abb_to;
+			tree.item_get_ABB(h_to, abb_to);
+			if (!abb.intersects(abb_to)) {
+				r_unpairs.push_back(_make_pair_change(h, h_to));
+			}
+		}
+
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &r_cull_hits;
+
+		tree.item_fill_cullparams(h, params);
+		params.abb = abb;
+		tree.cull_aabb(params, false);
+
+		// new pairs
+		for (const uint32_t ref_id : r_cull_hits) {
+			// don't collide against ourself
+			if (ref_id == h.id()) {
+				continue;
+			}
+
+			BVHHandle h_a = h;
+			BVHHandle h_b;
+			h_b.set_id(ref_id);
+			if (_is_new_pair(h_a, h_b)) {
+				r_pairs.push_back(_make_pair_change(h_a, h_b));
+			}
+		}
+	}
+
+	// Sends the callbacks in the order of the changes, unpairs first. Changes found twice must be
+	// next to each other, so they are only applied once.
+	void apply_pair_changes(const LocalVector<PairChange> &p_unpairs, const LocalVector<PairChange> &p_pairs) {
+		BVH_LOCKED_FUNCTION
+		for (uint32_t i = 0; i < p_unpairs.size(); i++) {
+			if (i > 0 && _is_same_pair_change(p_unpairs[i - 1], p_unpairs[i])) {
+				continue;
+			}
+			_unpair(p_unpairs[i].handle_a, p_unpairs[i].handle_b);
+		}
+		for (uint32_t i = 0; i < p_pairs.size(); i++) {
+			if (i > 0 && _is_same_pair_change(p_pairs[i - 1], p_pairs[i])) {
+				continue;
+			}
+			_pair(p_pairs[i].handle_a, p_pairs[i].handle_b);
+		}
+		_reset();
+	}
+
 	// prefer calling this directly as type safe
 	void set_tree(const BVHHandle &p_handle, uint32_t p_tree_id, uint32_t p_tree_collision_mask, bool p_force_collision_check = true) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -593,36 +681,48 @@ private:
 	// find NEW enterers, and send callbacks for them only
 	// handle a and b
 	void _collide(BVHHandle p_ha, BVHHandle p_hb) {
+		if (_is_new_pair(p_ha, p_hb)) {
+			_pair(p_ha, p_hb);
+		}
+	}
+
+	// returns true if the overlapping items should pair and are not paired yet,
+	// sorting the handles (only read, so it can run on several threads)
+	bool _is_new_pair(BVHHandle &r_ha, BVHHandle &r_hb) const {
 		// only have to do this oneway, lower ID then higher ID
-		tree._handle_sort(p_ha, p_hb);
+		tree._handle_sort(r_ha, r_hb);
 
-		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(p_ha);
-		const typename BVHTREE_CLASS::ItemExtra &exb = _get_extra(p_hb);
+		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(r_ha);
+		const typename BVHTREE_CLASS::ItemExtra &exb = _get_extra(r_hb);
 
 		// user collision callback
 		if (!USER_PAIR_TEST_FUNCTION::user_pair_check(exa.userdata, exb.userdata)) {
-			return;
+			return false;
 		}
 
 		// if the userdata is the same, no collisions should occur
 		if ((exa.userdata == exb.userdata) && exa.userdata) {
-			return;
+			return false;
 		}
 
-		typename BVHTREE_CLASS::ItemPairs &p_from = tree._pairs[p_ha.id()];
-		typename BVHTREE_CLASS::ItemPairs &p_to = tree._pairs[p_hb.id()];
+		const typename BVHTREE_CLASS::ItemPairs &p_from = tree._pairs[r_ha.id()];
+		const typename BVHTREE_CLASS::ItemPairs &p_to = tree._pairs[r_hb.id()];
 
 		// does this pair exist already?
 		// or only check the one with lower number of pairs for greater speed
 		if (p_from.num_pairs <= p_to.num_pairs) {
-			if (p_from.contains_pair_to(p_hb)) {
-				return;
-			}
-		} else {
-			if (p_to.contains_pair_to(p_ha)) {
-				return;
-			}
+			return !p_from.contains_pair_to(r_hb);
 		}
+		return !p_to.contains_pair_to(r_ha);
+	}
+
+	// handles must be sorted
+	void _pair(BVHHandle p_ha, BVHHandle p_hb) {
+		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(p_ha);
+		const typename BVHTREE_CLASS::ItemExtra &exb = _get_extra(p_hb);
+
+		typename BVHTREE_CLASS::ItemPairs &p_from = tree._pairs[p_ha.id()];
+		typename BVHTREE_CLASS::ItemPairs &p_to = tree._pairs[p_hb.id()];
 
 		// callback
 		void *callback_userdata = nullptr;
@@ -679,6 +779,25 @@ private:
 	}
 
 private:
+	PairChange _make_pair_change(BVHHandle p_ha, BVHHandle p_hb) const {
+		tree._handle_sort(p_ha, p_hb);
+		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(p_ha);
+		const typename BVHTREE_CLASS::ItemExtra &exb = _get_extra(p_hb);
+
+		PairChange change;
+		change.handle_a = p_ha;
+		change.handle_b = p_hb;
+		change.userdata_a = exa.userdata;
+		change.subindex_a = exa.subindex;
+		change.userdata_b = exb.userdata;
+		change.subindex_b = exb.subindex;
+		return change;
+	}
+
+	static bool _is_same_pair_change(const PairChange &p_a, const PairChange &p_b) {
+		return p_a.handle_a == p_b.handle_a && p_a.handle_b == p_b.handle_b;
+	}
+
 	const typename BVHTREE_CLASS::ItemExtra &_get_extra(BVHHandle p_handle) const {
 		return tree._extra[p_handle.id()];
 	}
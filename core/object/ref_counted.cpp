@@ -68,6 +68,10 @@ bool RefCounted::reference() {
 		}
 
 		_instance_binding_reference(true);
+
+		if (rc_val == 2) {
+			_single_reference_changed();
+		}
 	}
 
 	return success;
@@ -88,6 +92,10 @@ bool RefCounted::unreference() {
 
 		bool binding_ret = _instance_binding_reference(false);
 		die = die && binding_ret;
+
+		if (rc_val == 1) {
+			_single_reference_changed();
+		}
 	}
 
 	return die;
@@ -41,6 +41,9 @@ class RefCounted : public Object {
 protected:
 	static void _bind_methods();
 
+	// Called when the reference count rises from one or drops back to it.
+	virtual void _single_reference_changed() {}
+
 public:
 	static constexpr AncestralClass static_ancestral_class = AncestralClass::REF_COUNTED;
 
@@ -47,6 +47,7 @@
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/file_io_queue.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
@@ -112,6 +113,7 @@ static CoreBind::Geometry2D *_geometry_2d = nullptr;
 static CoreBind::Geometry3D *_geometry_3d = nullptr;
 
 static WorkerThreadPool *worker_thread_pool = nullptr;
+static FileIOQueue *file_io_queue = nullptr;
 
 extern Mutex _global_mutex;
 
@@ -339,6 +341,7 @@ void register_core_types() {
 	GDREGISTER_NATIVE_STRUCT(ScriptLanguageExtensionProfilingInfo, "StringName signature;uint64_t call_count;uint64_t total_time;uint64_t self_time");
 
 	worker_thread_pool = memnew(WorkerThreadPool);
+	file_io_queue = memnew(FileIOQueue);
 
 	OS::get_singleton()->benchmark_end_measure("Core", "Register Types");
 }
@@ -410,6 +413,7 @@ void unregister_core_types() {
 
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
+	memdelete(file_io_queue);
 	memdelete(worker_thread_pool);
 
 	memdelete(_engine_debugger);
@@ -133,6 +133,19 @@ public:
 		}
 	}
 
+	_ALWAYS_INLINE_ T exchange_if_less(T p_value) {
+		while (true) {
+			T tmp = value.load(std::memory_order_acquire);
+			if (tmp <= p_value) {
+				return tmp; // already less, or equal
+			}
+
+			if (value.compare_exchange_weak(tmp, p_value, std::memory_order_acq_rel)) {
+				return p_value;
+			}
+		}
+	}
+
 	_ALWAYS_INLINE_ T conditional_increment() {
 		while (true) {
 			T c = value.load(std::memory_order_acquire);
@@ -548,6 +548,110 @@ Error VariantParser::_parse_enginecfg(Stream *p_stream, Vector<String> &strings,
 	}
 }
 
+template <typename T>
+void VariantParser::_parse_buffered_numbers(Stream *p_stream, Vector<T> &r_construct, bool &r_first, int &line) {
+	// The tokenizer reads one character past numbers and identifiers. Take it over if it's a separator,
+	// otherwise the buffer could never be used again for this construct.
+	bool saved_comma = false;
+	if (p_stream->saved) {
+		if (p_stream->saved == ',' && !r_first) {
+			saved_comma = true;
+		} else if (p_stream->saved <= 32) {
+			line += p_stream->saved == '\n';
+		} else {
+			return;
+		}
+		p_stream->saved = 0;
+	}
+	const bool took_saved_comma = saved_comma;
+
+	uint32_t count = 0;
+	const char32_t *begin = p_stream->get_buffered(count);
+	const char32_t *end = begin + count;
+	const char32_t *c = begin;
+
+	// Consumes "[,] number" elements as long as they are complete within the buffer.
+	// Anything else (closing parenthesis, comments, identifiers like "inf") is left to the tokenizer.
+	while (c < end) {
+		const char32_t *e = c;
+		int lines = 0;
+		while (e < end && *e != 0 && *e <= 32) {
+			lines += *e == '\n';
+			e++;
+		}
+		if (saved_comma) {
+			// Only the first element can follow it, the whitespace above came after it.
+			saved_comma = false;
+		} else if (!r_first) {
+			if (e == end || *e != ',') {
+				break;
+			}
+			e++;
+			while (e < end && *e != 0 && *e <= 32) {
+				lines += *e == '\n';
+				e++;
+			}
+		}
+
+		const char32_t *number = e;
+		if (e < end && *e == '-') {
+			e++;
+		}
+		if (e == end || !is_digit(*e)) {
+			break;
+		}
+
+		// Same states as the tokenizer, so the same text is accepted.
+		bool is_float = false;
+		while (e < end && is_digit(*e)) {
+			e++;
+		}
+		if (e < end && *e == '.') {
+			is_float = true;
+			e++;
+			while (e < end && is_digit(*e)) {
+				e++;
+			}
+		}
+		if (e < end && (*e == 'e' || *e == 'E')) {
+			is_float = true;
+			e++;
+			if (e < end && (*e == '-' || *e == '+')) {
+				e++;
+			}
+			while (e < end && is_digit(*e)) {
+				e++;
+			}
+		}
+
+		// The number may continue in the next block.
+		constexpr int MAX_NUMBER_LENGTH = 63;
+		if (e == end || e - number > MAX_NUMBER_LENGTH) {
+			break;
+		}
+
+		char32_t text[MAX_NUMBER_LENGTH + 1];
+		const int length = e - number;
+		memcpy(text, number, length * sizeof(char32_t));
+		text[length] = 0;
+
+		// Go through Variant like the tokenizer does, so values are converted the same way.
+		if (is_float) {
+			r_construct.push_back(Variant(String::to_float(text)));
+		} else {
+			r_construct.push_back(Variant(String::to_int(text)));
+		}
+		r_first = false;
+		line += lines;
+		c = e;
+	}
+
+	if (took_saved_comma && c == begin) {
+		p_stream->saved = ','; // Give it back, no element after it was complete within the buffer.
+	}
+	p_stream->skip_buffered(c - begin);
+}
+
 template <typename T>
 Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str) {
 	Token token;
@@ -559,6 +663,9 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 
 	bool first = true;
 	while (true) {
+		// Numbers already read ahead are parsed in place, the tokenizer only sees what is left.
+		_parse_buffered_numbers(p_stream, r_construct, first, line);
+
 		if (!first) {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type == TK_COMMA) {
@@ -1432,17 +1539,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedInt64Array") {
 			Vector<int64_t> args;
 			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
@@ -1450,17 +1547,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
@@ -1468,17 +1555,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat64Array") {
 			Vector<double> args;
 			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
@@ -1486,17 +1563,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
@@ -53,6 +53,17 @@ public:
 		char32_t saved = 0;
 
 		char32_t get_char();
+		// Characters already read ahead, so parsers can scan them in blocks instead of calling get_char(). Never reads more.
+		_FORCE_INLINE_ const char32_t *get_buffered(uint32_t &r_count) const {
+			r_count = readahead_pointer < readahead_filled ? readahead_filled - readahead_pointer : 0;
+			return readahead_buffer + readahead_pointer;
+		}
+		_FORCE_INLINE_ void skip_buffered(uint32_t p_count) {
+			readahead_pointer += p_count;
+			buffered_skipped += p_count;
+		}
+		// How many characters were consumed through skip_buffered() rather than get_char().
+		uint64_t buffered_skipped = 0;
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
@@ -137,6 +148,8 @@ public:
 private:
 	static const char *tk_name[TK_MAX];
 
+	template <typename T>
+	static void _parse_buffered_numbers(Stream *p_stream, Vector<T> &r_construct, bool &r_first, int &line);
 	template <typename T>
 	static Error _parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str);
 	static Error _parse_byte_array(Stream *p_stream, Vector<uint8_t> &r_construct, int &line, String &r_err_str);
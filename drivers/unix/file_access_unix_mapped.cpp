@@ -0,0 +1,149 @@
+/**************************************************************************/
+/*  file_access_unix_mapped.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_unix_mapped.h"
+
+#if defined(UNIX_ENABLED)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+
+void FileAccessUnixMapped::_close() {
+	if (data) {
+		munmap(data, length);
+		data = nullptr;
+	}
+	length = 0;
+	pos = 0;
+	eof = false;
+	opened = false;
+}
+
+Error FileAccessUnixMapped::open_internal(const String &p_path, int p_mode_flags) {
+	_close();
+
+	ERR_FAIL_COND_V_MSG(p_mode_flags != READ, ERR_UNAVAILABLE, "Memory mapped files can only be opened for reading.");
+
+	path_src = p_path;
+	path = fix_path(p_path);
+
+	int fd = ::open(path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return errno == ENOENT ? ERR_FILE_NOT_FOUND : ERR_FILE_CANT_OPEN;
+	}
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+		::close(fd);
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	// Empty files can't be mapped, but are still valid to open.
+	if (st.st_size > 0) {
+		void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			::close(fd);
+			return ERR_FILE_CANT_OPEN;
+		}
+		data = (uint8_t *)mapping;
+		length = st.st_size;
+	}
+
+	// The mapping outlives the descriptor.
+	::close(fd);
+
+	opened = true;
+	return OK;
+}
+
+bool FileAccessUnixMapped::is_open() const {
+	return opened;
+}
+
+void FileAccessUnixMapped::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(!opened, "File must be opened before use.");
+
+	eof = p_position > length;
+	pos = MIN(p_position, length);
+}
+
+void FileAccessUnixMapped::seek_end(int64_t p_position) {
+	seek(length + p_position);
+}
+
+uint64_t FileAccessUnixMapped::get_position() const {
+	return pos;
+}
+
+uint64_t FileAccessUnixMapped::get_length() const {
+	return length;
+}
+
+bool FileAccessUnixMapped::eof_reached() const {
+	return eof;
+}
+
+uint64_t FileAccessUnixMapped::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!opened, -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	uint64_t to_read = p_length;
+	if (to_read > length - pos) {
+		eof = true;
+		to_read = length - pos;
+	}
+
+	if (to_read > 0) {
+		memcpy(p_dst, data + pos, to_read);
+		pos += to_read;
+	}
+	return to_read;
+}
+
+Error FileAccessUnixMapped::get_error() const {
+	return eof ? ERR_FILE_EOF : OK;
+}
+
+bool FileAccessUnixMapped::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V_MSG(false, "Memory mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::close() {
+	_close();
+}
+
+FileAccessUnixMapped::~FileAccessUnixMapped() {
+	_close();
+}
+
+#endif // UNIX_ENABLED
@@ -42,6 +42,7 @@
 #include "core/input/input_map.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
+#include "core/io/file_io_queue.h"
 #include "core/io/file_access_zip.h"
 #include "core/io/image.h"
 #include "core/io/image_loader.h"
@@ -5071,6 +5072,8 @@ void Main::cleanup(bool p_force) {
 	}
 
 	ResourceLoader::clear_thread_load_tasks();
+	FileIOQueue::get_singleton()->finish();
+	ResourceCache::clear_retained();
 
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
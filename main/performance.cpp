@@ -133,6 +133,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_HITS);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_MISSES);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_EVICTIONS);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_RETAINED_MEMORY);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -228,6 +232,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("resource_cache/hits"),
+		PNAME("resource_cache/misses"),
+		PNAME("resource_cache/evictions"),
+		PNAME("resource_cache/retained_memory"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -453,6 +461,15 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
 
+		case RESOURCE_CACHE_HITS:
+			return ResourceCache::get_hit_count();
+		case RESOURCE_CACHE_MISSES:
+			return ResourceCache::get_miss_count();
+		case RESOURCE_CACHE_EVICTIONS:
+			return ResourceCache::get_eviction_count();
+		case RESOURCE_CACHE_RETAINED_MEMORY:
+			return ResourceCache::get_retained_memory();
+
 		default: {
 		}
 	}
@@ -525,6 +542,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
@@ -121,6 +121,10 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		RESOURCE_CACHE_HITS,
+		RESOURCE_CACHE_MISSES,
+		RESOURCE_CACHE_EVICTIONS,
+		RESOURCE_CACHE_RETAINED_MEMORY,
 		MONITOR_MAX
 	};
 
@@ -45,6 +45,7 @@ class GodotAreaPair2D : public GodotConstraint2D {
 	bool body_has_attached_area = false;
 
 public:
+	virtual SortKey get_sort_key() const override;
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -66,6 +67,7 @@ class GodotArea2Pair2D : public GodotConstraint2D {
 	bool area_b_monitorable;
 
 public:
+	virtual SortKey get_sort_key() const override;
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -247,6 +247,14 @@ real_t combine_friction(GodotBody2D *A, GodotBody2D *B) {
 	return Math::abs(MIN(A->get_friction(), B->get_friction()));
 }
 
+GodotConstraint2D::SortKey GodotBodyPair2D::get_sort_key() const {
+	SortKey key;
+	key.object_a = A->get_self().get_id();
+	key.object_b = B->get_self().get_id();
+	key.sub = (uint64_t(uint32_t(shape_A)) << 32) | uint32_t(shape_B);
+	return key;
+}
+
 bool GodotBodyPair2D::setup(real_t p_step) {
 	check_ccd = false;
 
@@ -36,6 +36,7 @@ class GodotConstraint2D {
 	GodotBody2D **_body_ptr;
 	int _body_count;
 	uint64_t island_step = 0;
+	uint64_t setup_step = 0;
 	bool disabled_collisions_between_bodies = true;
 
 	RID self;
@@ -53,12 +54,49 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	// Step in which `setup()` already ran, it only runs once per step.
+	_FORCE_INLINE_ uint64_t get_setup_step() const { return setup_step; }
+	_FORCE_INLINE_ void set_setup_step(uint64_t p_step) { setup_step = p_step; }
+
 	_FORCE_INLINE_ GodotBody2D **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Identifies the constraint independently of memory addresses and of the order pairs were found in.
+	// Deterministic spaces use it to set up and solve constraints in a canonical order.
+	struct SortKey {
+		uint64_t object_a = 0;
+		uint64_t object_b = 0;
+		uint64_t sub = 0;
+
+		_FORCE_INLINE_ bool operator<(const SortKey &p_other) const {
+			if (object_a != p_other.object_a) {
+				return object_a < p_other.object_a;
+			}
+			if (object_b != p_other.object_b) {
+				return object_b < p_other.object_b;
+			}
+			return sub < p_other.sub;
+		}
+	};
+
+	virtual SortKey get_sort_key() const {
+		SortKey key;
+		if (_body_count > 0) {
+			key.object_a = _body_ptr[0]->get_self().get_id();
+		}
+		if (_body_count > 1) {
+			key.object_b = _body_ptr[1]->get_self().get_id();
+		}
+		key.sub = self.get_id();
+		return key;
+	}
+
+	// Contacts only wake up a sleeping body when `setup()` finds their shapes touching, other constraints always do.
+	virtual bool is_contact() const { return false; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1285,6 +1286,11 @@ void GodotPhysicsServer2D::set_active(bool p_active) {
 void GodotPhysicsServer2D::init() {
 	doing_sync = false;
 	stepper = memnew(GodotStep2D);
+	parallel_spaces_enabled = GLOBAL_GET("physics/2d/solver/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer2D::_step_space(uint32_t p_index, void *p_userdata) {
+	parallel_steppers[p_index]->step(parallel_spaces[p_index], parallel_step);
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
@@ -1294,11 +1300,33 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 
 	_update_shapes();
 
+	if (parallel_spaces_enabled && active_spaces.size() > 1) {
+		// Spaces share no bodies or constraints, and each one queues what its step reports
+		// until flush_queries() calls back from this thread.
+		for (GodotSpace2D *E : active_spaces) {
+			parallel_spaces.push_back(E);
+		}
+		while (parallel_steppers.size() < parallel_spaces.size()) {
+			GodotStep2D *space_stepper = memnew(GodotStep2D);
+			// The pool is already busy with the other spaces.
+			space_stepper->set_thread_count(1);
+			parallel_steppers.push_back(space_stepper);
+		}
+		parallel_step = p_step;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer2D::_step_space, nullptr, parallel_spaces.size(), -1, true, SNAME("Physics2DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		parallel_spaces.clear();
+	} else {
+		for (GodotSpace2D *E : active_spaces) {
+			stepper->step(E, p_step);
+		}
+	}
+
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
 	for (GodotSpace2D *E : active_spaces) {
-		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1364,6 +1392,10 @@ void GodotPhysicsServer2D::end_sync() {
 
 void GodotPhysicsServer2D::finish() {
 	memdelete(stepper);
+	for (GodotStep2D *space_stepper : parallel_steppers) {
+		memdelete(space_stepper);
+	}
+	parallel_steppers.clear();
 }
 
 void GodotPhysicsServer2D::_update_shapes() {
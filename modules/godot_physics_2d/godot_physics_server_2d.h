@@ -57,6 +57,13 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	GodotStep2D *stepper = nullptr;
 	HashSet<GodotSpace2D *> active_spaces;
 
+	// Active spaces stepped concurrently, each by the stepper with the same index.
+	bool parallel_spaces_enabled = false;
+	real_t parallel_step = 0.0;
+	LocalVector<GodotSpace2D *> parallel_spaces;
+	LocalVector<GodotStep2D *> parallel_steppers;
+	void _step_space(uint32_t p_index, void *p_userdata = nullptr);
+
 	mutable RID_PtrOwner<GodotShape2D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace2D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea2D, true> area_owner;
@@ -82,6 +89,8 @@ public:
 		Vector2 *ptr = nullptr;
 	};
 
+	static GodotPhysicsServer2D *get_godot_singleton() { return godot_singleton; }
+
 	virtual RID world_boundary_shape_create() override;
 	virtual RID separation_ray_shape_create() override;
 	virtual RID segment_shape_create() override;
@@ -297,6 +306,10 @@ public:
 
 	virtual bool is_flushing_queries() const override { return flushing_queries; }
 
+	// Steps independent spaces concurrently on the WorkerThreadPool, see `physics/2d/solver/step_spaces_in_parallel`.
+	void set_parallel_spaces_enabled(bool p_enabled) { parallel_spaces_enabled = p_enabled; }
+	bool is_parallel_spaces_enabled() const { return parallel_spaces_enabled; }
+
 	int get_process_info(ProcessInfo p_info) override;
 
 	GodotPhysicsServer2D(bool p_using_threads = false);
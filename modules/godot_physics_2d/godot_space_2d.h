@@ -99,6 +99,8 @@ private:
 	real_t contact_bias = 0.0;
 	real_t constraint_bias = 0.0;
 
+	bool deterministic = false;
+
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
 	};
@@ -163,6 +165,11 @@ public:
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 
+	// When enabled, constraints are set up and solved in a canonical order, so the simulation
+	// is reproducible across runs and machines regardless of thread count.
+	_FORCE_INLINE_ void set_deterministic(bool p_enabled) { deterministic = p_enabled; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
+
 	void update();
 	void setup();
 	void call_queries();
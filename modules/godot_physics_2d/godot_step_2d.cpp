@@ -40,6 +40,76 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+static _FORCE_INLINE_ bool _is_sleeping_rigid_body(const GodotBody2D *p_body) {
+	return p_body->get_mode() >= PhysicsServer2D::BODY_MODE_RIGID && !p_body->is_active();
+}
+
+static bool _is_contact_with_sleeping_body(const GodotConstraint2D *p_constraint) {
+	if (!p_constraint->is_contact()) {
+		return false;
+	}
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		if (_is_sleeping_rigid_body(p_constraint->get_body_ptr()[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int GodotStep2D::_wake_up_touched_islands(const SelfList<GodotBody2D>::List *p_body_list) {
+	// Queue sleeping bodies linked to active ones by a joint or by touching shapes.
+	// Contacts that only overlap in the broadphase are left out of the islands instead.
+	const SelfList<GodotBody2D> *b = p_body_list->first();
+	while (b) {
+		GodotBody2D *body = b->self();
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			GodotConstraint2D *constraint = E.first;
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				if (i == E.second) {
+					continue;
+				}
+				GodotBody2D *other_body = constraint->get_body_ptr()[i];
+				if (!_is_sleeping_rigid_body(other_body)) {
+					continue;
+				}
+				if (constraint->is_contact()) {
+					// Setting up has side effects, so `_setup_constraint()` keeps this result.
+					constraint->set_setup_step(_step);
+					if (!constraint->setup(delta)) {
+						continue; // Not touching yet.
+					}
+				}
+				wake_queue.push_back(other_body);
+			}
+		}
+		b = b->next();
+	}
+
+	// Islands fell asleep as a whole, so wake up everything connected to the queued bodies.
+	int woken_count = 0;
+	while (!wake_queue.is_empty()) {
+		GodotBody2D *body = wake_queue[wake_queue.size() - 1];
+		wake_queue.resize(wake_queue.size() - 1);
+		if (body->is_active()) {
+			continue;
+		}
+		body->set_active(true);
+		body->integrate_forces(delta);
+		woken_count++;
+
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			GodotConstraint2D *constraint = E.first;
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				GodotBody2D *other_body = constraint->get_body_ptr()[i];
+				if (_is_sleeping_rigid_body(other_body)) {
+					wake_queue.push_back(other_body);
+				}
+			}
+		}
+	}
+	return woken_count;
+}
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -53,6 +123,9 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 		if (constraint->get_island_step() == _step) {
 			continue; // Already processed.
 		}
+		if (!_is_sleeping_rigid_body(p_body) && _is_contact_with_sleeping_body(constraint)) {
+			continue; // Not touching, see `_wake_up_touched_islands()`.
+		}
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 		all_constraints.push_back(constraint);
@@ -75,6 +148,9 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
+	if (constraint->get_setup_step() == _step) {
+		return; // Already set up by `_wake_up_touched_islands()`.
+	}
 	constraint->setup(delta);
 }
 
@@ -126,7 +202,39 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 	}
 }
 
+void GodotStep2D::_sort_island(uint32_t p_island_index, void *p_userdata) {
+	constraint_islands[p_island_index].sort_custom<ConstraintSortComparator>();
+}
+
+bool GodotStep2D::_has_ray_ccd(const GodotConstraint2D *p_constraint) {
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		if (p_constraint->get_body_ptr()[i]->get_continuous_collision_detection_mode() == PhysicsServer2D::CCD_MODE_CAST_RAY) {
+			return true;
+		}
+	}
+	return false;
+}
+
+SafeNumeric<uint64_t> GodotStep2D::step_counter;
+
+template <typename M>
+void GodotStep2D::_run_stage(M p_method, uint32_t p_count, const String &p_description) {
+	if (thread_count == 1) {
+		// Also used when the whole space is stepped from a worker thread, where waiting for
+		// a nested group task could block every thread of the pool.
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, nullptr, p_count, thread_count, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
+	_step = step_counter.increment();
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -152,11 +260,15 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		active_count++;
 	}
 
-	p_space->set_active_objects(active_count);
-
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
+	/* WAKE UP SLEEPING ISLANDS TOUCHED BY ACTIVE BODIES */
+
+	active_count += _wake_up_touched_islands(body_list);
+
+	p_space->set_active_objects(active_count);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
@@ -238,11 +350,49 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	/* SORT CONSTRAINTS (DETERMINISTIC SPACES) */
+
+	const bool deterministic = p_space->is_deterministic();
+
+	if (deterministic) {
+		// Islands are independent, so only the order inside each of them and the order in which
+		// pre-solve reports contacts need to be canonical.
+		_run_stage(&GodotStep2D::_sort_island, island_count, SNAME("Physics2DSortIslands"));
+
+		island_order.resize(island_count);
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			island_order[island_index].key = constraint_islands[island_index][0]->get_sort_key();
+			island_order[island_index].index = island_index;
+		}
+		island_order.sort();
+
+		// Ray CCD changes body velocities during setup, which other pairs of the same body read.
+		// Set these pairs up serially in canonical order instead of racing on the worker threads.
+		serial_constraints.clear();
+		uint32_t parallel_constraint_count = 0;
+		for (uint32_t constraint_index = 0; constraint_index < all_constraints.size(); ++constraint_index) {
+			GodotConstraint2D *constraint = all_constraints[constraint_index];
+			if (_has_ray_ccd(constraint)) {
+				serial_constraints.push_back(constraint);
+			} else {
+				all_constraints[parallel_constraint_count++] = constraint;
+			}
+		}
+		all_constraints.resize(parallel_constraint_count);
+		serial_constraints.sort_custom<ConstraintSortComparator>();
+	}
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_stage(&GodotStep2D::_setup_constraint, total_constraint_count, SNAME("Physics2DConstraintSetup"));
+
+	for (GodotConstraint2D *constraint : serial_constraints) {
+		if (constraint->get_setup_step() != _step) {
+			constraint->setup(delta);
+		}
+	}
+	serial_constraints.clear();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -254,15 +404,14 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+		_pre_solve_island(constraint_islands[deterministic ? island_order[island_index].index : island_index]);
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_stage(&GodotStep2D::_solve_island, island_count, SNAME("Physics2DConstraintSolveIslands"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -294,7 +443,6 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep2D::GodotStep2D() {
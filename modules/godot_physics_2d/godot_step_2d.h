@@ -30,12 +30,16 @@
 
 #pragma once
 
+#include "godot_constraint_2d.h"
 #include "godot_space_2d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep2D {
-	uint64_t _step = 1;
+	// Island stamps are unique across all steppers, so any of them can step any space.
+	static SafeNumeric<uint64_t> step_counter;
+	uint64_t _step = 0;
 
 	int iterations = 0;
 	real_t delta = 0.0;
@@ -43,14 +47,42 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<GodotBody2D *> wake_queue;
 
+	int thread_count = -1;
+
+	// Deterministic spaces only.
+	struct ConstraintSortComparator {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const { return p_a->get_sort_key() < p_b->get_sort_key(); }
+	};
+
+	struct IslandOrder {
+		GodotConstraint2D::SortKey key;
+		uint32_t index = 0;
+
+		_FORCE_INLINE_ bool operator<(const IslandOrder &p_other) const { return key < p_other.key; }
+	};
+
+	LocalVector<IslandOrder> island_order;
+	LocalVector<GodotConstraint2D *> serial_constraints;
+
+	template <typename M>
+	void _run_stage(M p_method, uint32_t p_count, const String &p_description);
+	int _wake_up_touched_islands(const SelfList<GodotBody2D>::List *p_body_list);
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
 	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _sort_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	static bool _has_ray_ccd(const GodotConstraint2D *p_constraint);
 
 public:
+	// Limits the worker tasks used by each parallel stage, -1 uses the whole WorkerThreadPool
+	// and 1 runs the stages on the calling thread.
+	void set_thread_count(int p_thread_count) { thread_count = p_thread_count; }
+	int get_thread_count() const { return thread_count; }
+
 	void step(GodotSpace2D *p_space, real_t p_delta);
 	GodotStep2D();
 	~GodotStep2D();
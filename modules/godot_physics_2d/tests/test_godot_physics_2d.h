@@ -0,0 +1,256 @@
+/**************************************************************************/
+/*  test_godot_physics_2d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+#include "../godot_space_2d.h"
+#include "../godot_step_2d.h"
+
+#include "core/os/thread.h"
+#include "core/templates/hashfuncs.h"
+#include "servers/physics_2d/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics2D {
+
+// A space with gravity pulling towards positive y, and the bodies and shapes created for a test,
+// all freed when it goes out of scope.
+struct PhysicsTestScene {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space;
+	GodotSpace2D *godot_space = nullptr;
+	GodotStep2D stepper;
+	LocalVector<RID> bodies;
+	LocalVector<RID> shapes;
+
+	RID create_rectangle_shape(const Vector2 &p_half_extents) {
+		RID shape = ps->rectangle_shape_create();
+		ps->shape_set_data(shape, p_half_extents);
+		shapes.push_back(shape);
+		return shape;
+	}
+
+	RID add_body(PhysicsServer2D::BodyMode p_mode, RID p_shape, const Transform2D &p_transform) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, p_mode);
+		ps->body_add_shape(body, p_shape);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, p_transform);
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+		return body;
+	}
+
+	// Static rectangle with its top at `p_top`.
+	RID add_floor(real_t p_top) {
+		return add_body(PhysicsServer2D::BODY_MODE_STATIC, create_rectangle_shape(Vector2(1000, 10)), Transform2D(0, Vector2(0, p_top + 10)));
+	}
+
+	// Steps the space directly, without going through the server.
+	void step(int p_frames) {
+		for (int i = 0; i < p_frames; i++) {
+			stepper.step(godot_space, 1.0 / 60.0);
+		}
+	}
+
+	PhysicsTestScene() {
+		space = ps->space_create();
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+		GodotPhysicsDirectSpaceState2D *space_state = Object::cast_to<GodotPhysicsDirectSpaceState2D>(ps->space_get_direct_state(space));
+		REQUIRE(space_state);
+		godot_space = space_state->space;
+	}
+
+	~PhysicsTestScene() {
+		for (const RID &body : bodies) {
+			ps->free_rid(body);
+		}
+		for (const RID &shape : shapes) {
+			ps->free_rid(shape);
+		}
+		ps->free_rid(space);
+	}
+};
+
+// Drops separate piles of boxes on a floor, so the solver has several islands to spread over threads,
+// and returns a hash of the final state of all bodies.
+static uint32_t simulate_piles(int p_thread_count, bool p_deterministic) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	PhysicsTestScene scene;
+	scene.godot_space->set_deterministic(p_deterministic);
+
+	scene.add_floor(490);
+	RID box_shape = scene.create_rectangle_shape(Vector2(10, 10));
+
+	LocalVector<RID> boxes;
+	for (int pile = 0; pile < 8; pile++) {
+		for (int level = 0; level < 8; level++) {
+			boxes.push_back(scene.add_body(PhysicsServer2D::BODY_MODE_RIGID, box_shape, Transform2D(0.05 * level, Vector2(-800 + pile * 200 + level * 1.5, 480 - level * 21))));
+		}
+
+		// A fast body using ray CCD, which adjusts its velocity while contacts are set up.
+		RID bullet = scene.add_body(PhysicsServer2D::BODY_MODE_RIGID, box_shape, Transform2D(0, Vector2(-800 + pile * 200, 0)));
+		ps->body_set_continuous_collision_detection_mode(bullet, PhysicsServer2D::CCD_MODE_CAST_RAY);
+		ps->body_set_state(bullet, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(0, 3000));
+		boxes.push_back(bullet);
+	}
+
+	scene.stepper.set_thread_count(p_thread_count);
+	scene.step(120);
+
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (const RID &box : boxes) {
+		const Transform2D transform = ps->body_get_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		const Vector2 linear_velocity = ps->body_get_state(box, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		const real_t angular_velocity = ps->body_get_state(box, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+		hash = hash_murmur3_buffer(&transform, sizeof(Transform2D), hash);
+		hash = hash_murmur3_buffer(&linear_velocity, sizeof(Vector2), hash);
+		hash = hash_murmur3_buffer(&angular_velocity, sizeof(real_t), hash);
+	}
+
+	return hash;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Deterministic simulation does not depend on thread count") {
+	const uint32_t single_thread_hash = simulate_piles(1, true);
+
+	CHECK_EQ(simulate_piles(-1, true), single_thread_hash);
+	CHECK_EQ(simulate_piles(2, true), single_thread_hash);
+	// Same inputs, same thread count.
+	CHECK_EQ(simulate_piles(1, true), single_thread_hash);
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Sleeping islands wake up as a whole when touched") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	PhysicsTestScene scene;
+
+	scene.add_floor(0);
+	RID box_shape = scene.create_rectangle_shape(Vector2(10, 10));
+
+	// A sleeping stack of two boxes, and a third one falling on it from above.
+	RID boxes[3];
+	for (int i = 0; i < 3; i++) {
+		boxes[i] = scene.add_body(PhysicsServer2D::BODY_MODE_RIGID, box_shape, Transform2D(0, Vector2(0, i < 2 ? -10 - i * 20 : -300)));
+	}
+	ps->body_set_state(boxes[0], PhysicsServer2D::BODY_STATE_SLEEPING, true);
+	ps->body_set_state(boxes[1], PhysicsServer2D::BODY_STATE_SLEEPING, true);
+
+	scene.step(10);
+	CHECK(bool(ps->body_get_state(boxes[0], PhysicsServer2D::BODY_STATE_SLEEPING)));
+	CHECK(bool(ps->body_get_state(boxes[1], PhysicsServer2D::BODY_STATE_SLEEPING)));
+	CHECK_EQ(scene.godot_space->get_active_objects(), 1);
+
+	// The bottom box is only touched by the middle one, but wakes up with the rest of its island.
+	bool bottom_woke_up = false;
+	for (int i = 0; i < 120 && !bottom_woke_up; i++) {
+		scene.step(1);
+		bottom_woke_up = !bool(ps->body_get_state(boxes[0], PhysicsServer2D::BODY_STATE_SLEEPING));
+	}
+	CHECK(bottom_woke_up);
+	CHECK_FALSE(bool(ps->body_get_state(boxes[1], PhysicsServer2D::BODY_STATE_SLEEPING)));
+}
+
+static int state_sync_count = 0;
+static int off_main_thread_state_sync_count = 0;
+
+static void count_state_sync(PhysicsDirectBodyState2D *p_state) {
+	state_sync_count++;
+	if (!Thread::is_main_thread()) {
+		off_main_thread_state_sync_count++;
+	}
+}
+
+// Drops a row of boxes in each of many small spaces, steps them all through the server like the main loop does,
+// and returns the final transforms of the boxes.
+static LocalVector<Transform2D> simulate_small_spaces(int p_space_count, bool p_parallel) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	GodotPhysicsServer2D *godot_ps = GodotPhysicsServer2D::get_godot_singleton();
+	REQUIRE(godot_ps);
+	const bool was_parallel = godot_ps->is_parallel_spaces_enabled();
+	godot_ps->set_parallel_spaces_enabled(p_parallel);
+
+	LocalVector<PhysicsTestScene *> scenes;
+	LocalVector<RID> boxes;
+	for (int i = 0; i < p_space_count; i++) {
+		PhysicsTestScene *scene = memnew(PhysicsTestScene);
+		ps->space_set_active(scene->space, true);
+		scenes.push_back(scene);
+
+		scene->add_floor(0);
+		RID box_shape = scene->create_rectangle_shape(Vector2(10, 10));
+
+		// Each space drops its boxes from a different height, so their results differ.
+		for (int j = 0; j < 3; j++) {
+			RID box = scene->add_body(PhysicsServer2D::BODY_MODE_RIGID, box_shape, Transform2D(0, Vector2(j * 30, -20 - (i % 8) * 15)));
+			ps->body_set_state_sync_callback(box, callable_mp_static(&count_state_sync));
+			boxes.push_back(box);
+		}
+	}
+
+	state_sync_count = 0;
+	off_main_thread_state_sync_count = 0;
+	for (int i = 0; i < 60; i++) {
+		ps->step(1.0 / 60.0);
+		ps->flush_queries();
+	}
+
+	LocalVector<Transform2D> transforms;
+	for (const RID &box : boxes) {
+		transforms.push_back(ps->body_get_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM));
+	}
+
+	for (PhysicsTestScene *scene : scenes) {
+		memdelete(scene);
+	}
+
+	godot_ps->set_parallel_spaces_enabled(was_parallel);
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Spaces stepped in parallel match spaces stepped serially") {
+	const LocalVector<Transform2D> serial_transforms = simulate_small_spaces(32, false);
+	const int serial_state_sync_count = state_sync_count;
+	const LocalVector<Transform2D> parallel_transforms = simulate_small_spaces(32, true);
+
+	REQUIRE_EQ(parallel_transforms.size(), serial_transforms.size());
+	for (uint32_t i = 0; i < serial_transforms.size(); i++) {
+		CHECK(parallel_transforms[i].get_origin().is_equal_approx(serial_transforms[i].get_origin()));
+	}
+
+	// Callbacks are all called on the main thread, once the spaces are done stepping.
+	CHECK_EQ(state_sync_count, serial_state_sync_count);
+	CHECK_GT(state_sync_count, 0);
+	CHECK_EQ(off_main_thread_state_sync_count, 0);
+}
+
+} // namespace TestGodotPhysics2D
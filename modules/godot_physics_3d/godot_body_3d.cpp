@@ -708,6 +708,10 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		return;
 	}
 
+	// Velocities are kept, only the motion of this step is cut short at a time of impact.
+	const real_t motion_step = p_step * motion_fraction.get();
+	motion_fraction.set(1.0);
+
 	Vector3 total_angular_velocity = angular_velocity + biased_angular_velocity;
 
 	real_t ang_vel = total_angular_velocity.length();
@@ -715,7 +719,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	if (!Math::is_zero_approx(ang_vel)) {
 		Vector3 ang_vel_axis = total_angular_velocity / ang_vel;
-		Basis rot(ang_vel_axis, ang_vel * p_step);
+		Basis rot(ang_vel_axis, ang_vel * motion_step);
 		Basis identity3(1, 0, 0, 0, 1, 0, 0, 0, 1);
 		transform_new.origin += ((identity3 - rot) * transform_new.basis).xform(center_of_mass_local);
 		transform_new.basis = rot * transform_new.basis;
@@ -729,7 +733,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		}
 	}*/
 
-	transform_new.origin += total_linear_velocity * p_step;
+	transform_new.origin += total_linear_velocity * motion_step;
 
 	_set_transform(transform_new);
 	_set_inv_transform(get_transform().inverse());
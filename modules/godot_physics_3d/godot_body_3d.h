@@ -33,6 +33,7 @@
 #include "godot_area_3d.h"
 #include "godot_collision_object_3d.h"
 
+#include "core/templates/safe_refcount.h"
 #include "core/templates/vset.h"
 
 class GodotConstraint3D;
@@ -104,9 +105,12 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool active = true;
 
 	bool continuous_cd = false;
+	SafeNumeric<real_t> motion_fraction{ 1.0 }; // Limited by every CCD pair of the body, from the worker threads.
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 
+	uint32_t solver_index = 0; // Entry in the packed solver bodies of its island, see GodotSolverBodies3D.
+
 	void _mass_properties_changed();
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
@@ -217,9 +221,14 @@ public:
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
+	_FORCE_INLINE_ void set_solver_index(uint32_t p_index) { solver_index = p_index; }
+	_FORCE_INLINE_ uint32_t get_solver_index() const { return solver_index; }
+
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
 		linear_velocity += p_impulse * _inv_mass;
 	}
@@ -302,6 +311,9 @@ public:
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
 
+	// Stops the body at this fraction of its motion in the next `integrate_velocities()`, for continuous collision detection.
+	_FORCE_INLINE_ void limit_motion_fraction(real_t p_fraction) { motion_fraction.exchange_if_less(MAX(p_fraction, (real_t)0.0)); }
+
 	void set_space(GodotSpace3D *p_space) override;
 
 	void update_mass_properties();
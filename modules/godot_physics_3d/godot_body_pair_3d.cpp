@@ -31,10 +31,12 @@
 #include "godot_body_pair_3d.h"
 
 #include "godot_collision_solver_3d.h"
+#include "godot_solver_bodies_3d.h"
 #include "godot_space_3d.h"
 
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math::PI / 8)
+#define CONTACT_FEATURE_NORMAL_THRESHOLD 0.95
 
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
@@ -57,13 +59,19 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.normal = (p_point_A - p_point_B).normalized();
 	contact.used = true;
 
-	// Attempt to determine if the contact will be reused.
+	// Attempt to determine if the contact will be reused, so its accumulated impulses warm start the solver.
+	// Contacts generated by the same features are matched even when they slid further than the recycle
+	// radius on one of the bodies, as long as they stay anchored on the other one.
 	real_t contact_recycle_radius = space->get_contact_recycle_radius();
+	real_t contact_recycle_radius2 = contact_recycle_radius * contact_recycle_radius;
 
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
-				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
+		bool near_A = c.local_A.distance_squared_to(local_A) < contact_recycle_radius2;
+		bool near_B = c.local_B.distance_squared_to(local_B) < contact_recycle_radius2;
+		bool same_feature = p_index_A != 0 && c.index_A == p_index_A && c.index_B == p_index_B && c.normal.dot(contact.normal) > CONTACT_FEATURE_NORMAL_THRESHOLD;
+
+		if ((near_A && near_B) || (same_feature && (near_A || near_B))) {
 			contact.acc_normal_impulse = c.acc_normal_impulse;
 			contact.acc_bias_impulse = c.acc_bias_impulse;
 			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
@@ -75,40 +83,58 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
-		// Remove the contact with the minimum depth.
-
+		// Keep the deepest contact, and out of the remaining ones the set spanning the largest area,
+		// so the manifold supports the body over its whole contact surface.
 		const Basis &basis_A = A->get_transform().basis;
 		const Basis &basis_B = B->get_transform().basis;
 
-		int least_deep = -1;
-		real_t min_depth;
+		Vector3 points[MAX_CONTACTS + 1];
+		int deepest = 0;
+		real_t max_depth = -1e20;
 
-		// Start with depth for new contact.
-		{
-			Vector3 global_A = basis_A.xform(contact.local_A);
-			Vector3 global_B = basis_B.xform(contact.local_B) + offset_B;
+		for (int i = 0; i <= MAX_CONTACTS; i++) {
+			const Contact &c = i < MAX_CONTACTS ? contacts[i] : contact;
+			Vector3 global_A = basis_A.xform(c.local_A);
+			Vector3 global_B = basis_B.xform(c.local_B) + offset_B;
 
-			Vector3 axis = global_A - global_B;
-			min_depth = axis.dot(contact.normal);
+			real_t depth = (global_A - global_B).dot(c.normal);
+			if (depth > max_depth) {
+				max_depth = depth;
+				deepest = i;
+			}
+			points[i] = global_A;
 		}
 
-		for (int i = 0; i < contact_count; i++) {
-			const Contact &c = contacts[i];
-			Vector3 global_A = basis_A.xform(c.local_A);
-			Vector3 global_B = basis_B.xform(c.local_B) + offset_B;
+		int removed = -1;
+		real_t max_area = -1.0;
 
-			Vector3 axis = global_A - global_B;
-			real_t depth = axis.dot(c.normal);
+		for (int i = 0; i <= MAX_CONTACTS; i++) {
+			if (i == deepest) {
+				continue;
+			}
 
-			if (depth < min_depth) {
-				min_depth = depth;
-				least_deep = i;
+			Vector3 quad[MAX_CONTACTS];
+			int quad_count = 0;
+			for (int j = 0; j <= MAX_CONTACTS; j++) {
+				if (j != i) {
+					quad[quad_count++] = points[j];
+				}
+			}
+
+			// Squared area estimate, the largest of the quad diagonals cross products.
+			real_t area = (quad[0] - quad[1]).cross(quad[2] - quad[3]).length_squared();
+			area = MAX(area, (quad[0] - quad[2]).cross(quad[1] - quad[3]).length_squared());
+			area = MAX(area, (quad[0] - quad[3]).cross(quad[1] - quad[2]).length_squared());
+
+			if (area > max_area) {
+				max_area = area;
+				removed = i;
 			}
 		}
 
-		if (least_deep > -1) {
-			// Replace the least deep contact by the new one.
-			contacts[least_deep] = contact;
+		if (removed > -1 && removed < MAX_CONTACTS) {
+			// Replace the contact that contributes the least by the new one.
+			contacts[removed] = contact;
 		}
 
 		return;
@@ -159,93 +185,64 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
-// `_test_ccd` prevents tunneling by slowing down a high velocity body that is about to collide so
-// that next frame it will be at an appropriate location to collide (i.e. slight overlap).
-// WARNING: The way velocity is adjusted down to cause a collision means the momentum will be
-// weaker than it should for a bounce!
-// Process: Only proceed if body A's motion is high relative to its size.
-// Cast forward along motion vector to see if A is going to enter/pass B's collider next frame, only proceed if it does.
-// Adjust the velocity of A down so that it will just slightly intersect the collider instead of blowing right past it.
+// `_test_ccd` prevents tunneling of a body moving fast relative to its size, by finding the time of impact of its shape
+// sweeping against the other one with conservative advancement: the distance between the shapes is measured with GJK
+// and the motion is advanced by that distance over an upper bound of how fast the gap can close, until they touch.
+// The body then only moves up to slightly past that point this step, keeping its velocity, so the contact is
+// detected and solved normally in the next step.
+static GodotCollisionSolver3D::ShapeMotion _get_shape_motion(const GodotBody3D *p_body, int p_shape, const Transform3D &p_xform, const Vector3 &p_offset, real_t p_step) {
+	GodotCollisionSolver3D::ShapeMotion motion;
+	motion.transform = p_xform;
+	motion.center = p_body->get_transform().origin - p_offset + p_body->get_center_of_mass();
+	motion.linear = p_body->get_linear_velocity() * p_step;
+	motion.angular = p_body->get_angular_velocity() * p_step;
+
+	const AABB aabb = p_xform.xform(p_body->get_shape(p_shape)->get_aabb());
+	motion.radius = aabb.get_center().distance_to(motion.center) + aabb.size.length() * 0.5;
+	return motion;
+}
+
 bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
+	// Transforms are relative to the origin of the pair's first body.
+	const Vector3 &offset = A->get_transform().get_origin();
+	const GodotCollisionSolver3D::ShapeMotion motion_A = _get_shape_motion(p_A, p_shape_A, p_xform_A, offset, p_step);
+	const GodotCollisionSolver3D::ShapeMotion motion_B = _get_shape_motion(p_B, p_shape_B, p_xform_B, offset, p_step);
+
 	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
 
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
-	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON) {
+	const Vector3 relative_motion = motion_A.linear - motion_B.linear;
+	const real_t mlen = relative_motion.length();
+	const real_t sweep = mlen + motion_A.angular.length() * motion_A.radius + motion_B.angular.length() * motion_B.radius;
+	if (sweep < CMP_EPSILON) {
 		return false;
 	}
 
-	Vector3 mnormal = motion / mlen;
-
-	real_t min = 0.0, max = 0.0;
-	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
-
-	// Did it move enough in this direction to even attempt raycast?
-	// Let's say it should move more than 1/3 the size of the object in that axis.
-	bool fast_object = mlen > (max - min) * 0.3;
-	if (!fast_object) {
-		return false; // moving slow enough that there's no chance of tunneling.
+	// Size of A in the direction it moves in.
+	real_t size = motion_A.radius * 2.0;
+	if (mlen > CMP_EPSILON) {
+		real_t min = 0.0, max = 0.0;
+		shape_A_ptr->project_range(relative_motion / mlen, p_xform_A, min, max);
+		size = max - min;
 	}
 
-	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
-
-	// Roughly predict body B's position in the next frame (ignoring collisions).
-	Transform3D predicted_xform_B = p_xform_B.translated(p_B->get_linear_velocity() * p_step);
-
-	// Support points are the farthest forward points on A in the direction of the motion vector.
-	// i.e. the candidate points of which one should hit B first if any collision does occur.
-	static const int max_supports = 16;
-	Vector3 supports_A[max_supports];
-	int support_count_A;
-	GodotShape3D::FeatureType support_type_A;
-	// Convert mnormal into body A's local xform because get_supports requires (and returns) local coordinates.
-	shape_A_ptr->get_supports(p_xform_A.basis.xform_inv(mnormal).normalized(), max_supports, supports_A, support_count_A, support_type_A);
-
-	// Cast a segment from each support point of A in the motion direction.
-	int segment_support_idx = -1;
-	float segment_hit_length = FLT_MAX;
-	Vector3 segment_hit_local;
-	for (int i = 0; i < support_count_A; i++) {
-		supports_A[i] = p_xform_A.xform(supports_A[i]);
-
-		Vector3 from = supports_A[i];
-		Vector3 to = from + motion;
-
-		Transform3D from_inv = predicted_xform_B.affine_inverse();
-
-		// Back up 10% of the per-frame motion behind the support point and use that as the beginning of our cast.
-		// At high speeds, this may mean we're actually casting from well behind the body instead of inside it, which is odd.
-		// But it still works out.
-		Vector3 local_from = from_inv.xform(from - motion * 0.1);
-		Vector3 local_to = from_inv.xform(to);
-
-		Vector3 rpos, rnorm;
-		int fi = -1;
-		if (p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm, fi, true)) {
-			float hit_length = local_from.distance_to(rpos);
-			if (hit_length < segment_hit_length) {
-				segment_support_idx = i;
-				segment_hit_length = hit_length;
-				segment_hit_local = rpos;
-			}
-		}
+	// Let's say it should move more than 1/3 the size of the object to possibly tunnel.
+	if (sweep <= size * 0.3) {
+		return false;
 	}
 
-	if (segment_support_idx == -1) {
-		// There was no hit. Since the segment is the length of per-frame motion, this means the bodies will not
-		// actually collide yet on next frame. We'll probably check again next frame once they're closer.
+	const real_t tolerance = size * 0.01;
+	real_t fraction = 1.0;
+	if (!GodotCollisionSolver3D::solve_time_of_impact(shape_A_ptr, motion_A, p_B->get_shape(p_shape_B), motion_B, tolerance, fraction)) {
 		return false;
 	}
 
-	Vector3 hitpos = predicted_xform_B.xform(segment_hit_local);
-
-	real_t newlen = hitpos.distance_to(supports_A[segment_support_idx]);
-	// Adding 1% of body length to the distance between collision and support point
-	// should cause body A's support point to arrive just within B's collider next frame.
-	newlen += (max - min) * 0.01;
-	// FIXME: This doesn't always work well when colliding with a triangle face of a trimesh shape.
+	// Go slightly past the time of impact so the shapes overlap in the next step.
+	fraction += 2.0 * tolerance / sweep;
+	if (fraction >= 1.0) {
+		return false;
+	}
 
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
+	p_A->limit_motion_fraction(fraction);
 
 	return true;
 }
@@ -357,6 +354,8 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 
 	bool do_process = false;
 
+	friction = combine_friction(A, B);
+
 	const Vector3 &offset_A = A->get_transform().get_origin();
 
 	const Basis &basis_A = A->get_transform().basis;
@@ -451,7 +450,49 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	return do_process;
 }
 
-void GodotBodyPair3D::solve(real_t p_step) {
+// Solver body access for `GodotBodyPair3D::_solve()`, working on the bodies themselves.
+struct BodyPairDirectAccess3D {
+	GodotBody3D *body[2];
+
+	_FORCE_INLINE_ Vector3 get_linear_velocity(int p_body) const { return body[p_body]->get_linear_velocity(); }
+	_FORCE_INLINE_ Vector3 get_angular_velocity(int p_body) const { return body[p_body]->get_angular_velocity(); }
+	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity(int p_body) const { return body[p_body]->get_biased_linear_velocity(); }
+	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity(int p_body) const { return body[p_body]->get_biased_angular_velocity(); }
+	_FORCE_INLINE_ real_t get_inv_mass(int p_body) const { return body[p_body]->get_inv_mass(); }
+	_FORCE_INLINE_ const Basis &get_inv_inertia_tensor(int p_body) const { return body[p_body]->get_inv_inertia_tensor(); }
+
+	_FORCE_INLINE_ void apply_impulse(int p_body, const Vector3 &p_impulse, const Vector3 &p_offset) {
+		body[p_body]->apply_impulse(p_impulse, p_offset + body[p_body]->get_center_of_mass());
+	}
+
+	_FORCE_INLINE_ void apply_bias_impulse(int p_body, const Vector3 &p_impulse, const Vector3 &p_offset, real_t p_max_delta_av) {
+		body[p_body]->apply_bias_impulse(p_impulse, p_offset + body[p_body]->get_center_of_mass(), p_max_delta_av);
+	}
+};
+
+// Solver body access for `GodotBodyPair3D::_solve()`, working on the packed velocities of the island.
+struct BodyPairPackedAccess3D {
+	GodotSolverBodies3D *bodies;
+	uint32_t index[2];
+
+	_FORCE_INLINE_ const Vector3 &get_linear_velocity(int p_body) const { return bodies->linear_velocity[index[p_body]]; }
+	_FORCE_INLINE_ const Vector3 &get_angular_velocity(int p_body) const { return bodies->angular_velocity[index[p_body]]; }
+	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity(int p_body) const { return bodies->biased_linear_velocity[index[p_body]]; }
+	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity(int p_body) const { return bodies->biased_angular_velocity[index[p_body]]; }
+	_FORCE_INLINE_ real_t get_inv_mass(int p_body) const { return bodies->inv_mass[index[p_body]]; }
+	_FORCE_INLINE_ const Basis &get_inv_inertia_tensor(int p_body) const { return bodies->inv_inertia_tensor[index[p_body]]; }
+
+	_FORCE_INLINE_ void apply_impulse(int p_body, const Vector3 &p_impulse, const Vector3 &p_offset) {
+		bodies->apply_impulse(index[p_body], p_impulse, p_offset);
+	}
+
+	_FORCE_INLINE_ void apply_bias_impulse(int p_body, const Vector3 &p_impulse, const Vector3 &p_offset, real_t p_max_delta_av) {
+		bodies->apply_bias_impulse(index[p_body], p_impulse, p_offset, p_max_delta_av);
+	}
+};
+
+template <typename Bodies>
+void GodotBodyPair3D::_solve(real_t p_step, Bodies &p_bodies) {
 	if (!collided) {
 		return;
 	}
@@ -461,11 +502,11 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	Basis zero_basis;
 	zero_basis.set_zero();
 
-	const Basis &inv_inertia_tensor_A = collide_A ? A->get_inv_inertia_tensor() : zero_basis;
-	const Basis &inv_inertia_tensor_B = collide_B ? B->get_inv_inertia_tensor() : zero_basis;
+	const Basis &inv_inertia_tensor_A = collide_A ? p_bodies.get_inv_inertia_tensor(0) : zero_basis;
+	const Basis &inv_inertia_tensor_B = collide_B ? p_bodies.get_inv_inertia_tensor(1) : zero_basis;
 
-	real_t inv_mass_A = collide_A ? A->get_inv_mass() : 0.0;
-	real_t inv_mass_B = collide_B ? B->get_inv_mass() : 0.0;
+	real_t inv_mass_A = collide_A ? p_bodies.get_inv_mass(0) : 0.0;
+	real_t inv_mass_B = collide_B ? p_bodies.get_inv_mass(1) : 0.0;
 
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
@@ -477,9 +518,9 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		//bias impulse
 
-		Vector3 crbA = A->get_biased_angular_velocity().cross(c.rA);
-		Vector3 crbB = B->get_biased_angular_velocity().cross(c.rB);
-		Vector3 dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+		Vector3 crbA = p_bodies.get_biased_angular_velocity(0).cross(c.rA);
+		Vector3 crbB = p_bodies.get_biased_angular_velocity(1).cross(c.rB);
+		Vector3 dbv = p_bodies.get_biased_linear_velocity(1) + crbB - p_bodies.get_biased_linear_velocity(0) - crbA;
 
 		real_t vbn = dbv.dot(c.normal);
 
@@ -491,15 +532,15 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
 
 			if (collide_A) {
-				A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), max_bias_av);
+				p_bodies.apply_bias_impulse(0, -jb, c.rA, max_bias_av);
 			}
 			if (collide_B) {
-				B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), max_bias_av);
+				p_bodies.apply_bias_impulse(1, jb, c.rB, max_bias_av);
 			}
 
-			crbA = A->get_biased_angular_velocity().cross(c.rA);
-			crbB = B->get_biased_angular_velocity().cross(c.rB);
-			dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+			crbA = p_bodies.get_biased_angular_velocity(0).cross(c.rA);
+			crbB = p_bodies.get_biased_angular_velocity(1).cross(c.rB);
+			dbv = p_bodies.get_biased_linear_velocity(1) + crbB - p_bodies.get_biased_linear_velocity(0) - crbA;
 
 			vbn = dbv.dot(c.normal);
 
@@ -511,19 +552,19 @@ void GodotBodyPair3D::solve(real_t p_step) {
 				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
 
 				if (collide_A) {
-					A->apply_bias_impulse(-jb_com, A->get_center_of_mass(), 0.0f);
+					p_bodies.apply_bias_impulse(0, -jb_com, Vector3(), 0.0f);
 				}
 				if (collide_B) {
-					B->apply_bias_impulse(jb_com, B->get_center_of_mass(), 0.0f);
+					p_bodies.apply_bias_impulse(1, jb_com, Vector3(), 0.0f);
 				}
 			}
 
 			c.active = true;
 		}
 
-		Vector3 crA = A->get_angular_velocity().cross(c.rA);
-		Vector3 crB = B->get_angular_velocity().cross(c.rB);
-		Vector3 dv = B->get_linear_velocity() + crB - A->get_linear_velocity() - crA;
+		Vector3 crA = p_bodies.get_angular_velocity(0).cross(c.rA);
+		Vector3 crB = p_bodies.get_angular_velocity(1).cross(c.rB);
+		Vector3 dv = p_bodies.get_linear_velocity(1) + crB - p_bodies.get_linear_velocity(0) - crA;
 
 		//normal impulse
 		real_t vn = dv.dot(c.normal);
@@ -536,10 +577,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
 
 			if (collide_A) {
-				A->apply_impulse(-j, c.rA + A->get_center_of_mass());
+				p_bodies.apply_impulse(0, -j, c.rA);
 			}
 			if (collide_B) {
-				B->apply_impulse(j, c.rB + B->get_center_of_mass());
+				p_bodies.apply_impulse(1, j, c.rB);
 			}
 			c.acc_impulse -= j;
 
@@ -548,10 +589,8 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		//friction impulse
 
-		real_t friction = combine_friction(A, B);
-
-		Vector3 lvA = A->get_linear_velocity() + A->get_angular_velocity().cross(c.rA);
-		Vector3 lvB = B->get_linear_velocity() + B->get_angular_velocity().cross(c.rB);
+		Vector3 lvA = p_bodies.get_linear_velocity(0) + p_bodies.get_angular_velocity(0).cross(c.rA);
+		Vector3 lvB = p_bodies.get_linear_velocity(1) + p_bodies.get_angular_velocity(1).cross(c.rB);
 
 		Vector3 dtv = lvB - lvA;
 		real_t tn = c.normal.dot(dtv);
@@ -583,10 +622,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			jt = c.acc_tangent_impulse - jtOld;
 
 			if (collide_A) {
-				A->apply_impulse(-jt, c.rA + A->get_center_of_mass());
+				p_bodies.apply_impulse(0, -jt, c.rA);
 			}
 			if (collide_B) {
-				B->apply_impulse(jt, c.rB + B->get_center_of_mass());
+				p_bodies.apply_impulse(1, jt, c.rB);
 			}
 			c.acc_impulse -= jt;
 
@@ -595,6 +634,21 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::solve(real_t p_step) {
+	BodyPairDirectAccess3D bodies = { { A, B } };
+	_solve(p_step, bodies);
+}
+
+void GodotBodyPair3D::gather_solver_bodies(GodotSolverBodies3D &r_bodies) {
+	solver_index_A = r_bodies.gather(A);
+	solver_index_B = r_bodies.gather(B);
+}
+
+void GodotBodyPair3D::solve_packed(real_t p_step, GodotSolverBodies3D &r_bodies) {
+	BodyPairPackedAccess3D bodies = { &r_bodies, { solver_index_A, solver_index_B } };
+	_solve(p_step, bodies);
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
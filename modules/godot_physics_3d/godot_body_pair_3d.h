@@ -96,6 +96,11 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	real_t friction = 0.0;
+
+	uint32_t solver_index_A = 0;
+	uint32_t solver_index_B = 0;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -103,11 +108,20 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	void validate_contacts();
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
+	template <typename Bodies>
+	void _solve(real_t p_step, Bodies &p_bodies);
+
 public:
+	virtual bool is_contact() const override { return true; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool can_solve_packed() const override { return true; }
+	virtual void gather_solver_bodies(GodotSolverBodies3D &r_bodies) override;
+	virtual void solve_packed(real_t p_step, GodotSolverBodies3D &r_bodies) override;
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
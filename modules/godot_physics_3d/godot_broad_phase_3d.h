@@ -63,7 +63,9 @@ public:
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
-	virtual void update() = 0;
+	// Pairing changes may be found on up to `p_thread_count` threads (-1 for all of them),
+	// the callbacks are always called from this thread in a fixed order.
+	virtual void update(int p_thread_count) = 0;
 
 	virtual ~GodotBroadPhase3D() {}
 };
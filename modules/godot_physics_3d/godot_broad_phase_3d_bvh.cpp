@@ -32,6 +32,8 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -114,8 +116,72 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
-void GodotBroadPhase3DBVH::update() {
-	bvh.update();
+bool GodotBroadPhase3DBVH::PairChangeComparator::operator()(const BVH::PairChange &p_a, const BVH::PairChange &p_b) const {
+	const uint64_t id_a = p_a.userdata_a->get_self().get_id();
+	const uint64_t other_id_a = p_b.userdata_a->get_self().get_id();
+	if (id_a != other_id_a) {
+		return id_a < other_id_a;
+	}
+	if (p_a.subindex_a != p_b.subindex_a) {
+		return p_a.subindex_a < p_b.subindex_a;
+	}
+	const uint64_t id_b = p_a.userdata_b->get_self().get_id();
+	const uint64_t other_id_b = p_b.userdata_b->get_self().get_id();
+	if (id_b != other_id_b) {
+		return id_b < other_id_b;
+	}
+	return p_a.subindex_b < p_b.subindex_b;
+}
+
+void GodotBroadPhase3DBVH::_find_pair_changes(uint32_t p_batch_index, void *p_userdata) {
+	PairBatch &batch = pair_batches[p_batch_index];
+	batch.pairs.clear();
+	batch.unpairs.clear();
+
+	const uint32_t from = p_batch_index * PAIR_BATCH_SIZE;
+	const uint32_t to = MIN(from + PAIR_BATCH_SIZE, pair_batch_item_count);
+	for (uint32_t i = from; i < to; i++) {
+		bvh.find_pair_changes(i, batch.cull_hits, batch.pairs, batch.unpairs);
+	}
+}
+
+void GodotBroadPhase3DBVH::update(int p_thread_count) {
+	bvh.update_tree();
+
+	pair_batch_item_count = bvh.get_changed_item_count();
+	if (pair_batch_item_count == 0) {
+		return;
+	}
+
+	const uint32_t batch_count = (pair_batch_item_count + PAIR_BATCH_SIZE - 1) / PAIR_BATCH_SIZE;
+	if (pair_batches.size() < batch_count) {
+		pair_batches.resize(batch_count);
+	}
+
+	if (batch_count == 1 || p_thread_count == 1) {
+		for (uint32_t i = 0; i < batch_count; i++) {
+			_find_pair_changes(i, nullptr);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotBroadPhase3DBVH::_find_pair_changes, nullptr, batch_count, p_thread_count, true, SNAME("Physics3DBroadPhasePairs"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	pair_changes.clear();
+	unpair_changes.clear();
+	for (uint32_t i = 0; i < batch_count; i++) {
+		for (const BVH::PairChange &change : pair_batches[i].pairs) {
+			pair_changes.push_back(change);
+		}
+		for (const BVH::PairChange &change : pair_batches[i].unpairs) {
+			unpair_changes.push_back(change);
+		}
+	}
+
+	// The order in which items changed doesn't matter, and pairs between two changed items found twice end up next to each other.
+	pair_changes.sort_custom<PairChangeComparator>();
+	unpair_changes.sort_custom<PairChangeComparator>();
+	bvh.apply_pair_changes(unpair_changes, pair_changes);
 }
 
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
@@ -62,7 +62,29 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 		TREE_FLAG_DYNAMIC = 1 << TREE_DYNAMIC,
 	};
 
-	BVH_Manager<GodotCollisionObject3D, 2, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
+	typedef BVH_Manager<GodotCollisionObject3D, 2, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> BVH;
+	BVH bvh;
+
+	// Changed items are split in batches that find their pairing changes on the WorkerThreadPool.
+	// The changes are then sorted by the objects and subindices involved, and applied on the calling thread.
+	static constexpr uint32_t PAIR_BATCH_SIZE = 64;
+
+	struct PairBatch {
+		LocalVector<uint32_t> cull_hits;
+		LocalVector<BVH::PairChange> pairs;
+		LocalVector<BVH::PairChange> unpairs;
+	};
+
+	struct PairChangeComparator {
+		_FORCE_INLINE_ bool operator()(const BVH::PairChange &p_a, const BVH::PairChange &p_b) const;
+	};
+
+	LocalVector<PairBatch> pair_batches;
+	uint32_t pair_batch_item_count = 0;
+	LocalVector<BVH::PairChange> pair_changes;
+	LocalVector<BVH::PairChange> unpair_changes;
+
+	void _find_pair_changes(uint32_t p_batch_index, void *p_userdata);
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int, void *);
@@ -90,7 +112,7 @@ public:
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
 
-	virtual void update() override;
+	virtual void update(int p_thread_count) override;
 
 	static GodotBroadPhase3D *_create();
 	GodotBroadPhase3DBVH();
@@ -38,6 +38,8 @@
 #define collision_solver sat_calculate_penetration
 //#define collision_solver gjk_epa_calculate_penetration
 
+#define TIME_OF_IMPACT_MAX_ITERATIONS 32
+
 bool GodotCollisionSolver3D::solve_static_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result, real_t p_margin) {
 	const GodotWorldBoundaryShape3D *world_boundary = static_cast<const GodotWorldBoundaryShape3D *>(p_shape_A);
 	if (p_shape_B->get_type() == PhysicsServer3D::SHAPE_WORLD_BOUNDARY) {
@@ -587,3 +589,109 @@ bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const
 		return gjk_epa_calculate_distance(p_shape_A, p_transform_A, p_shape_B, p_transform_B, r_point_A, r_point_B); //should pass sepaxis..
 	}
 }
+
+Transform3D GodotCollisionSolver3D::ShapeMotion::interpolate(real_t p_fraction) const {
+	Transform3D result = transform;
+	const real_t angle = angular.length() * p_fraction;
+	if (!Math::is_zero_approx(angle)) {
+		const Basis rotation(angular.normalized(), angle);
+		result.basis = rotation * result.basis;
+		result.origin = center + rotation.xform(result.origin - center);
+	}
+	result.origin += linear * p_fraction;
+	return result;
+}
+
+bool GodotCollisionSolver3D::conservative_advancement(const GodotShape3D *p_shape_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const ShapeMotion &p_motion_B, real_t p_tolerance, real_t &r_fraction) {
+	// No point of either shape can move faster than this because of rotation.
+	const real_t angular_bound = p_motion_A.angular.length() * p_motion_A.radius + p_motion_B.angular.length() * p_motion_B.radius;
+	const Vector3 relative_motion = p_motion_A.linear - p_motion_B.linear;
+
+	real_t fraction = 0.0;
+	for (int i = 0; i < TIME_OF_IMPACT_MAX_ITERATIONS; i++) {
+		Vector3 point_A, point_B;
+		if (!solve_distance(p_shape_A, p_motion_A.interpolate(fraction), p_shape_B, p_motion_B.interpolate(fraction), point_A, point_B, AABB())) {
+			break; // Touching already.
+		}
+
+		const Vector3 separation = point_B - point_A;
+		const real_t distance = separation.length();
+		if (distance <= p_tolerance) {
+			break;
+		}
+
+		// Upper bound of how fast the gap closes, so advancing by distance / speed can't skip past the contact.
+		const real_t closing_speed = relative_motion.dot(separation / distance) + angular_bound;
+		if (closing_speed <= CMP_EPSILON) {
+			return false;
+		}
+
+		fraction += distance / closing_speed;
+		if (fraction > 1.0) {
+			return false;
+		}
+	}
+
+	r_fraction = fraction;
+	return true;
+}
+
+struct _ConcaveTimeOfImpactInfo {
+	const GodotShape3D *shape_A = nullptr;
+	const GodotCollisionSolver3D::ShapeMotion *motion_A = nullptr;
+	const GodotCollisionSolver3D::ShapeMotion *motion_B = nullptr;
+	real_t tolerance = 0.0;
+	real_t fraction = 1.0;
+	bool hit = false;
+};
+
+bool GodotCollisionSolver3D::concave_time_of_impact_callback(void *p_userdata, GodotShape3D *p_convex) {
+	_ConcaveTimeOfImpactInfo &info = *(static_cast<_ConcaveTimeOfImpactInfo *>(p_userdata));
+
+	real_t fraction = 0.0;
+	if (conservative_advancement(info.shape_A, *info.motion_A, p_convex, *info.motion_B, info.tolerance, fraction) && fraction < info.fraction) {
+		info.fraction = fraction;
+		info.hit = true;
+	}
+
+	// Impact at the very start of the motion, no face can be earlier.
+	return info.hit && info.fraction <= 0.0;
+}
+
+bool GodotCollisionSolver3D::solve_time_of_impact(const GodotShape3D *p_shape_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const ShapeMotion &p_motion_B, real_t p_tolerance, real_t &r_fraction) {
+	if (p_shape_A->is_concave() || p_shape_A->get_type() == PhysicsServer3D::SHAPE_WORLD_BOUNDARY) {
+		if (p_shape_B->is_concave() || p_shape_B->get_type() == PhysicsServer3D::SHAPE_WORLD_BOUNDARY) {
+			return false;
+		}
+		return solve_time_of_impact(p_shape_B, p_motion_B, p_shape_A, p_motion_A, p_tolerance, r_fraction);
+	}
+
+	if (!p_shape_B->is_concave()) {
+		return conservative_advancement(p_shape_A, p_motion_A, p_shape_B, p_motion_B, p_tolerance, r_fraction);
+	}
+
+	// Only faces of B that A can reach during the motion, in B's local space at both ends of the motion.
+	const Transform3D transform_A_end = p_motion_A.interpolate(1.0);
+	const Transform3D inv_B_begin = p_motion_B.transform.affine_inverse();
+	const Transform3D inv_B_end = p_motion_B.interpolate(1.0).affine_inverse();
+	const AABB aabb_A = p_shape_A->get_aabb();
+
+	AABB local_aabb = inv_B_begin.xform(p_motion_A.transform.xform(aabb_A));
+	local_aabb.merge_with(inv_B_begin.xform(transform_A_end.xform(aabb_A)));
+	local_aabb.merge_with(inv_B_end.xform(p_motion_A.transform.xform(aabb_A)));
+	local_aabb.merge_with(inv_B_end.xform(transform_A_end.xform(aabb_A)));
+	local_aabb.grow_by(p_motion_A.angular.length() * p_motion_A.radius + p_motion_B.angular.length() * p_motion_B.radius + p_tolerance);
+
+	_ConcaveTimeOfImpactInfo info;
+	info.shape_A = p_shape_A;
+	info.motion_A = &p_motion_A;
+	info.motion_B = &p_motion_B;
+	info.tolerance = p_tolerance;
+
+	static_cast<const GodotConcaveShape3D *>(p_shape_B)->cull(local_aabb, concave_time_of_impact_callback, &info, false);
+
+	if (info.hit) {
+		r_fraction = info.fraction;
+	}
+	return info.hit;
+}
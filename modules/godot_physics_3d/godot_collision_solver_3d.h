@@ -36,6 +36,17 @@ class GodotCollisionSolver3D {
 public:
 	typedef void (*CallbackResult)(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
+	// Motion of a shape over a step, rotating around `center` then translating, like bodies integrate velocities.
+	struct ShapeMotion {
+		Transform3D transform; // At the start of the step.
+		Vector3 center;
+		Vector3 linear;
+		Vector3 angular; // Rotation axis scaled by the angle.
+		real_t radius = 0.0; // Distance from `center` to the farthest point of the shape.
+
+		Transform3D interpolate(real_t p_fraction) const;
+	};
+
 private:
 	static bool soft_body_query_callback(uint32_t p_node_index, void *p_userdata);
 	static void soft_body_contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
@@ -46,9 +57,13 @@ private:
 	static bool solve_soft_body(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result);
 	static bool solve_concave(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool concave_distance_callback(void *p_userdata, GodotShape3D *p_convex);
+	static bool concave_time_of_impact_callback(void *p_userdata, GodotShape3D *p_convex);
+	static bool conservative_advancement(const GodotShape3D *p_shape_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const ShapeMotion &p_motion_B, real_t p_tolerance, real_t &r_fraction);
 	static bool solve_distance_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B);
 
 public:
 	static bool solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis = nullptr, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis = nullptr);
+	// Returns the first fraction of the motions at which the shapes come within `p_tolerance` of each other, if any.
+	static bool solve_time_of_impact(const GodotShape3D *p_shape_A, const ShapeMotion &p_motion_A, const GodotShape3D *p_shape_B, const ShapeMotion &p_motion_B, real_t p_tolerance, real_t &r_fraction);
 };
@@ -75,14 +75,16 @@ struct _CollectorCallback {
 	Vector3 normal;
 	Vector3 *prev_axis = nullptr;
 
-	_FORCE_INLINE_ void call(const Vector3 &p_point_A, const Vector3 &p_point_B, Vector3 p_normal) {
+	// `p_feature` identifies the contact among the supports that generated it, so it can be matched
+	// across frames while the same features touch. 0 means the contact has no stable identity.
+	_FORCE_INLINE_ void call(const Vector3 &p_point_A, const Vector3 &p_point_B, Vector3 p_normal, int p_feature = 0) {
 		if (p_normal.dot(p_point_B - p_point_A) < 0) {
 			p_normal = -p_normal;
 		}
 		if (swap) {
-			callback(p_point_B, 0, p_point_A, 0, -p_normal, userdata);
+			callback(p_point_B, p_feature, p_point_A, p_feature, -p_normal, userdata);
 		} else {
-			callback(p_point_A, 0, p_point_B, 0, p_normal, userdata);
+			callback(p_point_A, p_feature, p_point_B, p_feature, p_normal, userdata);
 		}
 	}
 };
@@ -296,9 +298,17 @@ static void _generate_contacts_face_face(const Vector3 *p_points_A, int p_point_
 	Vector3 *clipbuf_dst = _clipbuf2;
 	int clipbuf_len = p_point_count_A;
 
+	// Feature IDs of the clipped points: A vertices keep their index, intersections are identified
+	// by the clipping edge of B and the IDs of the A edge they cut.
+	int _featurebuf1[max_clip];
+	int _featurebuf2[max_clip];
+	int *featurebuf_src = _featurebuf1;
+	int *featurebuf_dst = _featurebuf2;
+
 	// copy A points to clipbuf_src
 	for (int i = 0; i < p_point_count_A; i++) {
 		clipbuf_src[i] = p_points_A[i];
+		featurebuf_src[i] = i + 1;
 	}
 
 	Plane plane_B(p_points_B[0], p_points_B[1], p_points_B[2]);
@@ -329,6 +339,7 @@ static void _generate_contacts_face_face(const Vector3 *p_points_A, int p_point_
 			if (dist0 <= 0) { // behind plane
 
 				ERR_FAIL_COND(dst_idx >= max_clip);
+				featurebuf_dst[dst_idx] = featurebuf_src[j];
 				clipbuf_dst[dst_idx++] = clipbuf_src[j];
 			}
 
@@ -343,12 +354,14 @@ static void _generate_contacts_face_face(const Vector3 *p_points_A, int p_point_
 
 				ERR_FAIL_COND(dst_idx >= max_clip);
 				clipbuf_dst[dst_idx] = inters;
+				featurebuf_dst[dst_idx] = ((i + 1) << 16) | ((featurebuf_src[j] & 0xFF) << 8) | (featurebuf_src[j_n] & 0xFF);
 				dst_idx++;
 			}
 		}
 
 		clipbuf_len = dst_idx;
 		SWAP(clipbuf_src, clipbuf_dst);
+		SWAP(featurebuf_src, featurebuf_dst);
 	}
 
 	// generate contacts
@@ -363,7 +376,7 @@ static void _generate_contacts_face_face(const Vector3 *p_points_A, int p_point_
 			continue;
 		}
 
-		p_callback->call(clipbuf_src[i], closest_B, plane_B.get_normal());
+		p_callback->call(clipbuf_src[i], closest_B, plane_B.get_normal(), featurebuf_src[i]);
 	}
 }
 
@@ -35,11 +35,13 @@
 
 class GodotBody3D;
 class GodotSoftBody3D;
+struct GodotSolverBodies3D;
 
 class GodotConstraint3D {
 	GodotBody3D **_body_ptr;
 	int _body_count;
 	uint64_t island_step;
+	uint64_t setup_step;
 	int priority;
 	bool disabled_collisions_between_bodies;
 
@@ -50,6 +52,7 @@ protected:
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
 		island_step = 0;
+		setup_step = 0;
 		priority = 1;
 		disabled_collisions_between_bodies = true;
 	}
@@ -61,6 +64,10 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	// Step in which `setup()` already ran, it only runs once per step.
+	_FORCE_INLINE_ uint64_t get_setup_step() const { return setup_step; }
+	_FORCE_INLINE_ void set_setup_step(uint64_t p_step) { setup_step = p_step; }
+
 	_FORCE_INLINE_ GodotBody3D **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
@@ -73,9 +80,18 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Contacts only wake up a sleeping body when `setup()` finds their shapes touching, other constraints always do.
+	virtual bool is_contact() const { return false; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// Constraints supporting it can be solved on the packed velocities of their island instead of the bodies.
+	// `gather_solver_bodies()` runs once per step before the iterations, then `solve_packed()` replaces `solve()`.
+	virtual bool can_solve_packed() const { return false; }
+	virtual void gather_solver_bodies(GodotSolverBodies3D &r_bodies) {}
+	virtual void solve_packed(real_t p_step, GodotSolverBodies3D &r_bodies) {}
+
 	virtual ~GodotConstraint3D() {}
 };
@@ -38,7 +38,9 @@
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -943,11 +945,28 @@ bool GodotPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &
 	ERR_FAIL_NULL_V(body->get_space(), false);
 	ERR_FAIL_COND_V(body->get_space()->is_locked(), false);
 
+	if (parallel_motion_tests) {
+		// Shapes were updated when the parallel tests began.
+		return body->get_space()->test_body_motion_parallel(body, p_parameters, r_result);
+	}
+
 	_update_shapes();
 
 	return body->get_space()->test_body_motion(body, p_parameters, r_result);
 }
 
+bool GodotPhysicsServer3D::begin_parallel_motion_tests() {
+	ERR_FAIL_COND_V(parallel_motion_tests, false);
+
+	_update_shapes();
+	parallel_motion_tests = true;
+	return true;
+}
+
+void GodotPhysicsServer3D::end_parallel_motion_tests() {
+	parallel_motion_tests = false;
+}
+
 PhysicsDirectBodyState3D *GodotPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -1669,6 +1688,11 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 
 void GodotPhysicsServer3D::init() {
 	stepper = memnew(GodotStep3D);
+	parallel_spaces_enabled = GLOBAL_GET("physics/3d/solver/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer3D::_step_space(uint32_t p_index, void *p_userdata) {
+	parallel_steppers[p_index]->step(parallel_spaces[p_index], parallel_step);
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
@@ -1678,11 +1702,33 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 
 	_update_shapes();
 
+	if (parallel_spaces_enabled && active_spaces.size() > 1) {
+		// Spaces share no bodies or constraints, and each one queues what its step reports
+		// until flush_queries() calls back from this thread.
+		for (GodotSpace3D *E : active_spaces) {
+			parallel_spaces.push_back(E);
+		}
+		while (parallel_steppers.size() < parallel_spaces.size()) {
+			GodotStep3D *space_stepper = memnew(GodotStep3D);
+			// The pool is already busy with the other spaces.
+			space_stepper->set_thread_count(1);
+			parallel_steppers.push_back(space_stepper);
+		}
+		parallel_step = p_step;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, nullptr, parallel_spaces.size(), -1, true, SNAME("Physics3DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		parallel_spaces.clear();
+	} else {
+		for (GodotSpace3D *E : active_spaces) {
+			stepper->step(E, p_step);
+		}
+	}
+
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
 	for (GodotSpace3D *E : active_spaces) {
-		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1749,6 +1795,10 @@ void GodotPhysicsServer3D::end_sync() {
 
 void GodotPhysicsServer3D::finish() {
 	memdelete(stepper);
+	for (GodotStep3D *space_stepper : parallel_steppers) {
+		memdelete(space_stepper);
+	}
+	parallel_steppers.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
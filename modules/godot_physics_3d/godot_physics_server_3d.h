@@ -51,10 +51,18 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	bool using_threads = false;
 	bool doing_sync = false;
 	bool flushing_queries = false;
+	bool parallel_motion_tests = false;
 
 	GodotStep3D *stepper = nullptr;
 	HashSet<GodotSpace3D *> active_spaces;
 
+	// Active spaces stepped concurrently, each by the stepper with the same index.
+	bool parallel_spaces_enabled = false;
+	real_t parallel_step = 0.0;
+	LocalVector<GodotSpace3D *> parallel_spaces;
+	LocalVector<GodotStep3D *> parallel_steppers;
+	void _step_space(uint32_t p_index, void *p_userdata = nullptr);
+
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace3D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea3D, true> area_owner;
@@ -76,6 +84,8 @@ public:
 		Vector3 *ptr = nullptr;
 	};
 
+	static GodotPhysicsServer3D *get_godot_singleton() { return godot_singleton; }
+
 	static void _shape_col_cbk(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	virtual RID world_boundary_shape_create() override;
@@ -255,6 +265,8 @@ public:
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) override;
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) override;
+	virtual bool begin_parallel_motion_tests() override;
+	virtual void end_parallel_motion_tests() override;
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override;
@@ -383,6 +395,10 @@ public:
 
 	virtual bool is_flushing_queries() const override { return flushing_queries; }
 
+	// Steps independent spaces concurrently on the WorkerThreadPool, see `physics/3d/solver/step_spaces_in_parallel`.
+	void set_parallel_spaces_enabled(bool p_enabled) { parallel_spaces_enabled = p_enabled; }
+	bool is_parallel_spaces_enabled() const { return parallel_spaces_enabled; }
+
 	int get_process_info(ProcessInfo p_info) override;
 
 	GodotPhysicsServer3D(bool p_using_threads = false);
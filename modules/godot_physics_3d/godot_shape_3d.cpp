@@ -1330,15 +1330,42 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
+void GodotConcavePolygonShape3D::_quantize(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const {
+	// Round outwards, so quantized bounds always contain the original ones.
+	const Vector3 from = (p_aabb.position - bvh_origin) * bvh_quantize_scale;
+	const Vector3 to = (p_aabb.position + p_aabb.size - bvh_origin) * bvh_quantize_scale;
+	for (int i = 0; i < 3; i++) {
+		r_min[i] = (uint16_t)CLAMP(Math::floor(from[i]), 0, UINT16_MAX);
+		r_max[i] = (uint16_t)CLAMP(Math::ceil(to[i]), 0, UINT16_MAX);
 	}
+}
+
+AABB GodotConcavePolygonShape3D::_dequantize(const BVH &p_node) const {
+	const Vector3 from = bvh_origin + Vector3(p_node.min[0], p_node.min[1], p_node.min[2]) * bvh_dequantize_scale;
+	const Vector3 to = bvh_origin + Vector3(p_node.max[0], p_node.max[1], p_node.max[2]) * bvh_dequantize_scale;
+	return AABB(from, to - from);
+}
+
+void GodotConcavePolygonShape3D::_cull_segment(_SegmentCullParams *p_params) const {
+	const BVH *nodes = bvh.ptr();
+	const int node_count = bvh.size();
+
+	int idx = 0;
+	while (idx < node_count) {
+		const BVH &node = nodes[idx];
+		const bool hit = _dequantize(node).intersects_segment(p_params->from, p_params->to);
+
+		if (node.face_or_skip < 0) {
+			idx += hit ? 1 : -node.face_or_skip;
+			continue;
+		}
+		idx++;
+
+		if (!hit) {
+			continue;
+		}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
+		const Face *f = &p_params->faces[node.face_or_skip];
 		GodotFaceShape3D *face = p_params->face;
 		face->normal = f->normal;
 		face->vertex[0] = p_params->vertices[f->indices[0]];
@@ -1347,7 +1374,7 @@ void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_
 
 		Vector3 res;
 		Vector3 normal;
-		int face_index = params_bvh->face_index;
+		int face_index = node.face_or_skip;
 		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
 			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
 			if ((d > 0) && (d < p_params->min_d)) {
@@ -1358,13 +1385,6 @@ void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_
 				p_params->collisions++;
 			}
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
 	}
 }
 
@@ -1376,7 +1396,6 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face;
 	face.backface_collision = backface_collision && p_hit_back_faces;
@@ -1388,12 +1407,11 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 
 	params.faces = fr;
 	params.vertices = vr;
-	params.bvh = br;
 
 	params.face = &face;
 
 	// cull
-	_cull_segment(0, &params);
+	_cull_segment(&params);
 
 	if (params.collisions > 0) {
 		r_result = params.result;
@@ -1413,38 +1431,42 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+void GodotConcavePolygonShape3D::_cull(_CullParams *p_params) const {
+	uint16_t query_min[3];
+	uint16_t query_max[3];
+	_quantize(p_params->aabb, query_min, query_max);
 
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
+	const BVH *nodes = bvh.ptr();
+	const int node_count = bvh.size();
+
+	int idx = 0;
+	while (idx < node_count) {
+		const BVH &node = nodes[idx];
+		// Kept free of branches, so it compiles to a few integer compares.
+		const bool overlap = (node.min[0] <= query_max[0]) & (node.max[0] >= query_min[0]) &
+				(node.min[1] <= query_max[1]) & (node.max[1] >= query_min[1]) &
+				(node.min[2] <= query_max[2]) & (node.max[2] >= query_min[2]);
+
+		if (node.face_or_skip < 0) {
+			idx += overlap ? 1 : -node.face_or_skip;
+			continue;
+		}
+		idx++;
+
+		if (!overlap) {
+			continue;
+		}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
+		const Face *f = &p_params->faces[node.face_or_skip];
 		GodotFaceShape3D *face = p_params->face;
 		face->normal = f->normal;
 		face->vertex[0] = p_params->vertices[f->indices[0]];
 		face->vertex[1] = p_params->vertices[f->indices[1]];
 		face->vertex[2] = p_params->vertices[f->indices[2]];
 		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
-		}
-
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
+			return;
 		}
 	}
-
-	return false;
 }
 
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
@@ -1454,11 +1476,13 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	}
 
 	AABB local_aabb = p_local_aabb;
+	if (!local_aabb.intersects(get_aabb())) {
+		return;
+	}
 
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face; // use this to send in the callback
 	face.backface_collision = backface_collision;
@@ -1469,12 +1493,11 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	params.face = &face;
 	params.faces = fr;
 	params.vertices = vr;
-	params.bvh = br;
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	_cull(&params);
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1571,24 +1594,18 @@ _Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int
 void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
 	int idx = p_idx;
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
-
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	_quantize(p_bvh_tree->aabb, p_bvh_array[idx].min, p_bvh_array[idx].max);
 
+	if (p_bvh_tree->face_index >= 0) {
+		p_bvh_array[idx].face_or_skip = p_bvh_tree->face_index;
 	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
-
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
+		// Branches always have both children, the left one right after them.
+		++p_idx;
+		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+		++p_idx;
 		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
 
-	} else {
-		p_bvh_array[p_idx].right = -1;
+		p_bvh_array[idx].face_or_skip = -(p_idx - idx + 1);
 	}
 
 	memdelete(p_bvh_tree);
@@ -1642,7 +1659,14 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	int count = 0;
 	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
 
-	bvh.resize(count + 1);
+	bvh_origin = _aabb.position;
+	for (int i = 0; i < 3; i++) {
+		// Flat axes are quantized to zero and always overlap.
+		bvh_quantize_scale[i] = _aabb.size[i] > CMP_EPSILON ? UINT16_MAX / _aabb.size[i] : 0.0;
+		bvh_dequantize_scale[i] = _aabb.size[i] / UINT16_MAX;
+	}
+
+	bvh.resize(count);
 
 	BVH *bvh_arrayw2 = bvh.ptrw();
 
@@ -2033,35 +2057,103 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 		aabb_max[i]++;
 	}
 
-	int start_x = MAX(0, aabb_min[0]);
-	int end_x = MIN(width - 1, aabb_max[0]);
-	int start_z = MAX(0, aabb_min[2]);
-	int end_z = MIN(depth - 1, aabb_max[2]);
-
 	GodotFaceShape3D face;
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
+	_CullParams params;
+	params.start_x = MAX(0, aabb_min[0]);
+	params.end_x = MIN(width - 1, aabb_max[0]);
+	params.start_z = MAX(0, aabb_min[2]);
+	params.end_z = MIN(depth - 1, aabb_max[2]);
+	params.min_height = local_aabb.position.y;
+	params.max_height = local_aabb.position.y + local_aabb.size.y;
+	params.callback = p_callback;
+	params.userdata = p_userdata;
+	params.face = &face;
+
+	if (height_pyramid.is_empty() || params.start_x >= params.end_x || params.start_z >= params.end_z) {
+		return;
+	}
+
+	const int top_level = height_pyramid.size() - 1;
+	const PyramidLevel &top = height_pyramid[top_level];
+	for (int block_z = 0; block_z < top.depth; block_z++) {
+		for (int block_x = 0; block_x < top.width; block_x++) {
+			if (_cull_block(top_level, block_x, block_z, params)) {
+				return;
+			}
+		}
+	}
+}
+
+bool GodotHeightMapShape3D::_cull_block(int p_level, int p_block_x, int p_block_z, const _CullParams &p_params) const {
+	const int block_size = HEIGHT_PYRAMID_BLOCK_SIZE << p_level;
+	const int x0 = p_block_x * block_size;
+	const int z0 = p_block_z * block_size;
+	if (x0 >= p_params.end_x || x0 + block_size <= p_params.start_x || z0 >= p_params.end_z || z0 + block_size <= p_params.start_z) {
+		return false;
+	}
+
+	const PyramidLevel &level = height_pyramid[p_level];
+	const Range &range = level.ranges[p_block_z * level.width + p_block_x];
+	if (range.min > p_params.max_height || range.max < p_params.min_height) {
+		return false;
+	}
+
+	if (p_level > 0) {
+		const PyramidLevel &child_level = height_pyramid[p_level - 1];
+		const int child_end_x = MIN(p_block_x * 2 + 2, child_level.width);
+		const int child_end_z = MIN(p_block_z * 2 + 2, child_level.depth);
+		for (int child_z = p_block_z * 2; child_z < child_end_z; child_z++) {
+			for (int child_x = p_block_x * 2; child_x < child_end_x; child_x++) {
+				if (_cull_block(p_level - 1, child_x, child_z, p_params)) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	GodotFaceShape3D &face = *p_params.face;
+	const int start_x = MAX(x0, p_params.start_x);
+	const int end_x = MIN(x0 + block_size, p_params.end_x);
+	const int start_z = MAX(z0, p_params.start_z);
+	const int end_z = MIN(z0 + block_size, p_params.end_z);
+
 	for (int z = start_z; z < end_z; z++) {
 		for (int x = start_x; x < end_x; x++) {
+			Vector3 p00, p10, p01, p11;
+			_get_point(x, z, p00);
+			_get_point(x + 1, z, p10);
+			_get_point(x, z + 1, p01);
+			_get_point(x + 1, z + 1, p11);
+
 			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+			if (MAX(p00.y, MAX(p10.y, p01.y)) >= p_params.min_height && MIN(p00.y, MIN(p10.y, p01.y)) <= p_params.max_height) {
+				face.vertex[0] = p00;
+				face.vertex[1] = p10;
+				face.vertex[2] = p01;
+				face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+				if (p_params.callback(p_params.userdata, &face)) {
+					return true;
+				}
 			}
 
 			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+			if (MAX(p10.y, MAX(p11.y, p01.y)) >= p_params.min_height && MIN(p10.y, MIN(p11.y, p01.y)) <= p_params.max_height) {
+				face.vertex[0] = p10;
+				face.vertex[1] = p11;
+				face.vertex[2] = p01;
+				face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+				if (p_params.callback(p_params.userdata, &face)) {
+					return true;
+				}
 			}
 		}
 	}
+
+	return false;
 }
 
 Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -2143,6 +2235,66 @@ void GodotHeightMapShape3D::_build_accelerator() {
 	}
 }
 
+void GodotHeightMapShape3D::_build_height_pyramid() {
+	height_pyramid.clear();
+
+	const int cell_width = width - 1;
+	const int cell_depth = depth - 1;
+	if (cell_width < 1 || cell_depth < 1) {
+		return;
+	}
+
+	// Blocks include the vertices on their far edges, which are shared with the next blocks.
+	PyramidLevel base;
+	base.width = (cell_width + HEIGHT_PYRAMID_BLOCK_SIZE - 1) / HEIGHT_PYRAMID_BLOCK_SIZE;
+	base.depth = (cell_depth + HEIGHT_PYRAMID_BLOCK_SIZE - 1) / HEIGHT_PYRAMID_BLOCK_SIZE;
+	base.ranges.resize(base.width * base.depth);
+	for (int block_z = 0; block_z < base.depth; block_z++) {
+		const int z0 = block_z * HEIGHT_PYRAMID_BLOCK_SIZE;
+		const int z_end = MIN(z0 + HEIGHT_PYRAMID_BLOCK_SIZE, cell_depth);
+		for (int block_x = 0; block_x < base.width; block_x++) {
+			const int x0 = block_x * HEIGHT_PYRAMID_BLOCK_SIZE;
+			const int x_end = MIN(x0 + HEIGHT_PYRAMID_BLOCK_SIZE, cell_width);
+
+			Range r;
+			r.min = _get_height(x0, z0);
+			r.max = r.min;
+			for (int z = z0; z <= z_end; z++) {
+				for (int x = x0; x <= x_end; x++) {
+					const real_t height = _get_height(x, z);
+					r.min = MIN(r.min, height);
+					r.max = MAX(r.max, height);
+				}
+			}
+			base.ranges[block_z * base.width + block_x] = r;
+		}
+	}
+	height_pyramid.push_back(base);
+
+	while (height_pyramid[height_pyramid.size() - 1].width > 1 || height_pyramid[height_pyramid.size() - 1].depth > 1) {
+		const PyramidLevel &child_level = height_pyramid[height_pyramid.size() - 1];
+
+		PyramidLevel level;
+		level.width = (child_level.width + 1) / 2;
+		level.depth = (child_level.depth + 1) / 2;
+		level.ranges.resize(level.width * level.depth);
+		for (int block_z = 0; block_z < level.depth; block_z++) {
+			for (int block_x = 0; block_x < level.width; block_x++) {
+				Range r = child_level.ranges[(block_z * 2) * child_level.width + block_x * 2];
+				for (int child_z = block_z * 2; child_z < MIN(block_z * 2 + 2, child_level.depth); child_z++) {
+					for (int child_x = block_x * 2; child_x < MIN(block_x * 2 + 2, child_level.width); child_x++) {
+						const Range &child = child_level.ranges[child_z * child_level.width + child_x];
+						r.min = MIN(r.min, child.min);
+						r.max = MAX(r.max, child.max);
+					}
+				}
+				level.ranges[block_z * level.width + block_x] = r;
+			}
+		}
+		height_pyramid.push_back(level);
+	}
+}
+
 void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
 	heights = p_heights;
 	width = p_width;
@@ -2160,6 +2312,7 @@ void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width,
 	aabb_new.position -= local_origin;
 
 	_build_accelerator();
+	_build_height_pyramid();
 
 	configure(aabb_new);
 }
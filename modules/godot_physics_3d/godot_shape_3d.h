@@ -315,15 +315,19 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Node bounds are quantized to 16 bits inside the shape AABB. Nodes are stored depth-first,
+	// so a subtree is contiguous and can be skipped without a stack.
 	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Face index for leaves, negated node count of the subtree for branches.
+		int32_t face_or_skip = 0;
 	};
 
 	Vector<BVH> bvh;
+	Vector3 bvh_origin;
+	Vector3 bvh_quantize_scale;
+	Vector3 bvh_dequantize_scale;
 
 	struct _CullParams {
 		AABB aabb;
@@ -331,7 +335,6 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		void *userdata = nullptr;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
 		GodotFaceShape3D *face = nullptr;
 	};
 
@@ -341,7 +344,6 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		Vector3 dir;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
 		GodotFaceShape3D *face = nullptr;
 
 		Vector3 result;
@@ -353,8 +355,11 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	void _quantize(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const;
+	AABB _dequantize(const BVH &p_node) const;
+
+	void _cull_segment(_SegmentCullParams *p_params) const;
+	void _cull(_CullParams *p_params) const;
 
 	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
 
@@ -399,6 +404,29 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 
 	static const int BOUNDS_CHUNK_SIZE = 16;
 
+	// Min/max heights of square blocks of cells, each level doubling the block size of the previous one
+	// until a single block covers the whole map, so culling can skip blocks outside the queried heights.
+	struct PyramidLevel {
+		LocalVector<Range> ranges;
+		int width = 0;
+		int depth = 0;
+	};
+	LocalVector<PyramidLevel> height_pyramid;
+
+	static const int HEIGHT_PYRAMID_BLOCK_SIZE = 4;
+
+	struct _CullParams {
+		int start_x = 0;
+		int end_x = 0;
+		int start_z = 0;
+		int end_z = 0;
+		real_t min_height = 0.0;
+		real_t max_height = 0.0;
+		QueryCallback callback = nullptr;
+		void *userdata = nullptr;
+		GodotFaceShape3D *face = nullptr;
+	};
+
 	_FORCE_INLINE_ const Range &_get_bounds_chunk(int p_x, int p_z) const {
 		return bounds_grid[(p_z * bounds_grid_width) + p_x];
 	}
@@ -416,6 +444,8 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
 
 	void _build_accelerator();
+	void _build_height_pyramid();
+	bool _cull_block(int p_level, int p_block_x, int p_block_z, const _CullParams &p_params) const;
 
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  godot_solver_bodies_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "godot_body_3d.h"
+
+#include "core/templates/local_vector.h"
+
+// Velocity state of the bodies in a constraint island, gathered into contiguous arrays so the solver
+// iterations don't have to go through the body objects for every impulse.
+// Rigid bodies belong to a single island, they get one entry which `scatter()` writes back.
+// Static and kinematic bodies can be shared by islands solved in parallel, so they get a read-only
+// entry for each constraint using them.
+struct GodotSolverBodies3D {
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<Vector3> linear_velocity;
+	LocalVector<Vector3> angular_velocity;
+	LocalVector<Vector3> biased_linear_velocity;
+	LocalVector<Vector3> biased_angular_velocity;
+	LocalVector<real_t> inv_mass;
+	LocalVector<Basis> inv_inertia_tensor;
+
+	void clear();
+	uint32_t gather(GodotBody3D *p_body);
+	void scatter() const;
+
+	// Same as the GodotBody3D methods, with offsets relative to the center of mass.
+	_FORCE_INLINE_ void apply_impulse(uint32_t p_index, const Vector3 &p_impulse, const Vector3 &p_offset) {
+		linear_velocity[p_index] += p_impulse * inv_mass[p_index];
+		angular_velocity[p_index] += inv_inertia_tensor[p_index].xform(p_offset.cross(p_impulse));
+	}
+
+	_FORCE_INLINE_ void apply_bias_impulse(uint32_t p_index, const Vector3 &p_impulse, const Vector3 &p_offset, real_t p_max_delta_av) {
+		biased_linear_velocity[p_index] += p_impulse * inv_mass[p_index];
+		if (p_max_delta_av != 0.0) {
+			Vector3 delta_av = inv_inertia_tensor[p_index].xform(p_offset.cross(p_impulse));
+			if (p_max_delta_av > 0 && delta_av.length() > p_max_delta_av) {
+				delta_av = delta_av.normalized() * p_max_delta_av;
+			}
+			biased_angular_velocity[p_index] += delta_av;
+		}
+	}
+};
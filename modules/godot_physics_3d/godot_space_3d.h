@@ -36,16 +36,41 @@
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/templates/paged_allocator.h"
 #include "core/typedefs.h"
 
+class GodotAreaPair3D;
+class GodotArea2Pair3D;
+class GodotAreaSoftBodyPair3D;
+class GodotBodyPair3D;
+class GodotBodySoftBodyPair3D;
+
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		// Rays per worker task; batches up to this size are cast on the calling thread.
+		RAY_BATCH_CHUNK_SIZE = 64
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		int ray_count = 0;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	bool _cast_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, RayResult &r_result) const;
+	void _cast_ray_chunk(uint32_t p_chunk, RayBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -84,6 +109,13 @@ private:
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
 
+	// Pairs are created and destroyed in bulk as objects move, so they are allocated in pages.
+	PagedAllocator<GodotBodyPair3D, false, 256> body_pair_allocator;
+	PagedAllocator<GodotBodySoftBodyPair3D, false, 64> body_soft_body_pair_allocator;
+	PagedAllocator<GodotAreaPair3D, false, 256> area_pair_allocator;
+	PagedAllocator<GodotArea2Pair3D, false, 64> area2_pair_allocator;
+	PagedAllocator<GodotAreaSoftBodyPair3D, false, 64> area_soft_body_pair_allocator;
+
 	HashSet<GodotCollisionObject3D *> objects;
 
 	GodotArea3D *area = nullptr;
@@ -121,7 +153,8 @@ private:
 
 	friend class GodotPhysicsDirectSpaceState3D;
 
-	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
+	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices);
+	bool _test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices);
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
@@ -164,7 +197,7 @@ public:
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 
-	void update();
+	void update(int p_thread_count);
 	void setup();
 	void call_queries();
 
@@ -205,6 +238,8 @@ public:
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
+	// Same as test_body_motion(), but safe to call from several threads at once while the space doesn't change.
+	bool test_body_motion_parallel(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
 	GodotSpace3D();
 	~GodotSpace3D();
@@ -41,6 +41,76 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+static _FORCE_INLINE_ bool _is_sleeping_rigid_body(const GodotBody3D *p_body) {
+	return p_body->get_mode() >= PhysicsServer3D::BODY_MODE_RIGID && !p_body->is_active();
+}
+
+static bool _is_contact_with_sleeping_body(const GodotConstraint3D *p_constraint) {
+	if (!p_constraint->is_contact()) {
+		return false;
+	}
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		if (_is_sleeping_rigid_body(p_constraint->get_body_ptr()[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int GodotStep3D::_wake_up_touched_islands(const SelfList<GodotBody3D>::List *p_body_list) {
+	// Queue sleeping bodies linked to active ones by a joint or by touching shapes.
+	// Contacts that only overlap in the broadphase are left out of the islands instead.
+	const SelfList<GodotBody3D> *b = p_body_list->first();
+	while (b) {
+		GodotBody3D *body = b->self();
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			GodotConstraint3D *constraint = E.key;
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				if (i == E.value) {
+					continue;
+				}
+				GodotBody3D *other_body = constraint->get_body_ptr()[i];
+				if (!_is_sleeping_rigid_body(other_body)) {
+					continue;
+				}
+				if (constraint->is_contact()) {
+					// Setting up has side effects, so `_setup_constraint()` keeps this result.
+					constraint->set_setup_step(_step);
+					if (!constraint->setup(delta)) {
+						continue; // Not touching yet.
+					}
+				}
+				wake_queue.push_back(other_body);
+			}
+		}
+		b = b->next();
+	}
+
+	// Islands fell asleep as a whole, so wake up everything connected to the queued bodies.
+	int woken_count = 0;
+	while (!wake_queue.is_empty()) {
+		GodotBody3D *body = wake_queue[wake_queue.size() - 1];
+		wake_queue.resize(wake_queue.size() - 1);
+		if (body->is_active()) {
+			continue;
+		}
+		body->set_active(true);
+		body->integrate_forces(delta);
+		woken_count++;
+
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			GodotConstraint3D *constraint = E.key;
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				GodotBody3D *other_body = constraint->get_body_ptr()[i];
+				if (_is_sleeping_rigid_body(other_body)) {
+					wake_queue.push_back(other_body);
+				}
+			}
+		}
+	}
+	return woken_count;
+}
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -54,6 +124,9 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 		if (constraint->get_island_step() == _step) {
 			continue; // Already processed.
 		}
+		if (!_is_sleeping_rigid_body(p_body) && _is_contact_with_sleeping_body(constraint)) {
+			continue; // Not touching, see `_wake_up_touched_islands()`.
+		}
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 
@@ -114,6 +187,9 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
+	if (constraint->get_setup_step() == _step) {
+		return; // Already set up by `_wake_up_touched_islands()`.
+	}
 	constraint->setup(delta);
 }
 
@@ -130,7 +206,39 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+bool GodotStep3D::_solve_island_packed(uint32_t p_island_index) {
+	const LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+
+	uint32_t constraint_count = constraint_island.size();
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		// Mixing with constraints working on the bodies directly would solve on stale velocities.
+		if (!constraint_island[constraint_index]->can_solve_packed()) {
+			return false;
+		}
+	}
+
+	GodotSolverBodies3D &solver_bodies = island_solver_bodies[p_island_index];
+	solver_bodies.clear();
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		constraint_island[constraint_index]->gather_solver_bodies(solver_bodies);
+	}
+
+	// Contacts all have the default priority, so a single pass of iterations is enough.
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+			constraint_island[constraint_index]->solve_packed(delta, solver_bodies);
+		}
+	}
+
+	solver_bodies.scatter();
+	return true;
+}
+
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+	if (packed_solver_enabled && _solve_island_packed(p_island_index)) {
+		return;
+	}
+
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
 	int current_priority = 1;
@@ -182,7 +290,26 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 	}
 }
 
+SafeNumeric<uint64_t> GodotStep3D::step_counter;
+
+template <typename M>
+void GodotStep3D::_run_stage(M p_method, uint32_t p_count, const String &p_description) {
+	if (thread_count == 1) {
+		// Also used when the whole space is stepped from a worker thread, where waiting for
+		// a nested group task could block every thread of the pool.
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, nullptr, p_count, thread_count, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	_step = step_counter.increment();
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -219,10 +346,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		active_count++;
 	}
 
-	p_space->set_active_objects(active_count);
-
 	// Update the broadphase to register collision pairs.
-	p_space->update();
+	p_space->update(thread_count);
+
+	/* WAKE UP SLEEPING ISLANDS TOUCHED BY ACTIVE BODIES */
+
+	active_count += _wake_up_touched_islands(body_list);
+
+	p_space->set_active_objects(active_count);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -344,8 +475,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_stage(&GodotStep3D::_setup_constraint, total_constraint_count, SNAME("Physics3DConstraintSetup"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -362,10 +492,13 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	if (island_solver_bodies.size() < island_count) {
+		island_solver_bodies.resize(island_count);
+	}
+
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_stage(&GodotStep3D::_solve_island, island_count, SNAME("Physics3DConstraintSolveIslands"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -405,7 +538,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep3D::GodotStep3D() {
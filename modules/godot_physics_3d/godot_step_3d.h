@@ -30,12 +30,16 @@
 
 #pragma once
 
+#include "godot_solver_bodies_3d.h"
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
-	uint64_t _step = 1;
+	// Island stamps are unique across all steppers, so any of them can step any space.
+	static SafeNumeric<uint64_t> step_counter;
+	uint64_t _step = 0;
 
 	int iterations = 0;
 	real_t delta = 0.0;
@@ -43,15 +47,33 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotSolverBodies3D> island_solver_bodies;
+	LocalVector<GodotBody3D *> wake_queue;
 
+	bool packed_solver_enabled = true;
+	int thread_count = -1;
+
+	template <typename M>
+	void _run_stage(M p_method, uint32_t p_count, const String &p_description);
+	int _wake_up_touched_islands(const SelfList<GodotBody3D>::List *p_body_list);
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	bool _solve_island_packed(uint32_t p_island_index);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
+	// Limits the worker tasks used by each parallel stage, -1 uses the whole WorkerThreadPool
+	// and 1 runs the stages on the calling thread.
+	void set_thread_count(int p_thread_count) { thread_count = p_thread_count; }
+	int get_thread_count() const { return thread_count; }
+
+	// Solves islands made only of contacts between bodies on packed velocities, see GodotSolverBodies3D.
+	void set_packed_solver_enabled(bool p_enabled) { packed_solver_enabled = p_enabled; }
+	bool is_packed_solver_enabled() const { return packed_solver_enabled; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
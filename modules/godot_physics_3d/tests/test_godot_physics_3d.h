@@ -0,0 +1,567 @@
+/**************************************************************************/
+/*  test_godot_physics_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+#include "../godot_shape_3d.h"
+#include "../godot_space_3d.h"
+#include "../godot_step_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/thread.h"
+#include "scene/3d/physics/character_body_3d.h"
+#include "scene/3d/physics/collision_shape_3d.h"
+#include "scene/3d/physics/static_body_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/3d/box_shape_3d.h"
+#include "scene/resources/3d/capsule_shape_3d.h"
+#include "servers/physics_3d/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics3D {
+
+// A space with the bodies and shapes created for a test, all freed when it goes out of scope.
+struct PhysicsTestScene {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space;
+	GodotSpace3D *godot_space = nullptr;
+	GodotStep3D stepper;
+	LocalVector<RID> bodies;
+	LocalVector<RID> shapes;
+
+	RID create_box_shape(const Vector3 &p_half_extents) {
+		RID shape = ps->box_shape_create();
+		ps->shape_set_data(shape, p_half_extents);
+		shapes.push_back(shape);
+		return shape;
+	}
+
+	RID add_body(PhysicsServer3D::BodyMode p_mode, RID p_shape, const Transform3D &p_transform) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, p_mode);
+		ps->body_add_shape(body, p_shape);
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, p_transform);
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+		return body;
+	}
+
+	// Static box with its top at y = 0.
+	RID add_floor(real_t p_half_size) {
+		return add_body(PhysicsServer3D::BODY_MODE_STATIC, create_box_shape(Vector3(p_half_size, 0.5, p_half_size)), Transform3D(Basis(), Vector3(0, -0.5, 0)));
+	}
+
+	// Steps the space directly, without going through the server.
+	void step(int p_frames, double p_delta = 1.0 / 60.0) {
+		for (int i = 0; i < p_frames; i++) {
+			stepper.step(godot_space, p_delta);
+		}
+	}
+
+	PhysicsTestScene() {
+		space = ps->space_create();
+		GodotPhysicsDirectSpaceState3D *space_state = Object::cast_to<GodotPhysicsDirectSpaceState3D>(ps->space_get_direct_state(space));
+		REQUIRE(space_state);
+		godot_space = space_state->space;
+	}
+
+	~PhysicsTestScene() {
+		for (const RID &body : bodies) {
+			ps->free_rid(body);
+		}
+		for (const RID &shape : shapes) {
+			ps->free_rid(shape);
+		}
+		ps->free_rid(space);
+	}
+};
+
+struct StackResult {
+	real_t drift = 0.0; // Horizontal distance the top box moved away from its initial position.
+	real_t sag = 0.0; // How much lower than its initial position the top box ended up.
+	real_t speed = 0.0; // Linear speed of the top box in the last step.
+};
+
+// Stacks unit boxes on a static floor, slightly offset from each other, and lets them settle.
+static StackResult simulate_stack(int p_box_count, int p_solver_iterations, int p_frames) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	PhysicsTestScene scene;
+	ps->space_set_param(scene.space, PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS, p_solver_iterations);
+
+	scene.add_floor(10);
+	RID box_shape = scene.create_box_shape(Vector3(0.5, 0.5, 0.5));
+	RID top;
+	for (int i = 0; i < p_box_count; i++) {
+		top = scene.add_body(PhysicsServer3D::BODY_MODE_RIGID, box_shape, Transform3D(Basis(), Vector3((i % 2) ? 0.02 : -0.02, 0.5 + i, 0)));
+	}
+
+	const Vector3 initial_top = Transform3D(ps->body_get_state(top, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+
+	scene.step(p_frames);
+
+	const Vector3 top_origin = Transform3D(ps->body_get_state(top, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+	StackResult result;
+	result.drift = Vector2(top_origin.x - initial_top.x, top_origin.z - initial_top.z).length();
+	result.sag = initial_top.y - top_origin.y;
+	result.speed = Vector3(ps->body_get_state(top, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)).length();
+
+	return result;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Box stack settles") {
+	const StackResult result = simulate_stack(5, 8, 180);
+
+	CHECK(result.drift < 0.1);
+	CHECK(result.sag < 0.25);
+	CHECK(result.speed < 0.1);
+}
+
+struct BodyResult {
+	Transform3D transform;
+	Vector3 linear_velocity;
+	Vector3 angular_velocity;
+};
+
+// Drops columns of boxes with a slight tilt so they collapse into piles, and returns the final state of the boxes.
+static LocalVector<BodyResult> simulate_piles(int p_grid_size, int p_column_height, int p_frames, bool p_packed_solver, int p_thread_count = -1) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	PhysicsTestScene scene;
+
+	scene.add_floor(p_grid_size * 2);
+	RID box_shape = scene.create_box_shape(Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	for (int x = 0; x < p_grid_size; x++) {
+		for (int z = 0; z < p_grid_size; z++) {
+			for (int y = 0; y < p_column_height; y++) {
+				const Basis tilt = Basis(Vector3(0, 1, 0), 0.1 * y).rotated(Vector3(1, 0, 0), 0.02 * ((x + z) % 3));
+				boxes.push_back(scene.add_body(PhysicsServer3D::BODY_MODE_RIGID, box_shape, Transform3D(tilt, Vector3(x * 1.6 + 0.1 * y, 0.6 + y * 1.05, z * 1.6))));
+			}
+		}
+	}
+
+	scene.stepper.set_packed_solver_enabled(p_packed_solver);
+	scene.stepper.set_thread_count(p_thread_count);
+	scene.step(p_frames);
+
+	LocalVector<BodyResult> results;
+	for (const RID &box : boxes) {
+		BodyResult result;
+		result.transform = ps->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		result.linear_velocity = ps->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		result.angular_velocity = ps->body_get_state(box, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+		results.push_back(result);
+	}
+
+	return results;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Packed solver matches solving on bodies") {
+	// Short enough that the piles are still collapsing, with many contacts changing every step.
+	const int grid_size = 3;
+	const int column_height = 4;
+	const int frames = 90;
+
+	const LocalVector<BodyResult> direct_results = simulate_piles(grid_size, column_height, frames, false);
+	const LocalVector<BodyResult> packed_results = simulate_piles(grid_size, column_height, frames, true);
+
+	REQUIRE_EQ(packed_results.size(), direct_results.size());
+	for (uint32_t i = 0; i < direct_results.size(); i++) {
+		CHECK(packed_results[i].transform.is_equal_approx(direct_results[i].transform));
+		CHECK(packed_results[i].linear_velocity.is_equal_approx(direct_results[i].linear_velocity));
+		CHECK(packed_results[i].angular_velocity.is_equal_approx(direct_results[i].angular_velocity));
+	}
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Stepping on worker threads matches stepping on one thread") {
+	// Enough boxes for the broadphase to find pairs in several batches.
+	const int grid_size = 6;
+	const int column_height = 3;
+	const int frames = 60;
+
+	const LocalVector<BodyResult> serial_results = simulate_piles(grid_size, column_height, frames, true, 1);
+	const LocalVector<BodyResult> threaded_results = simulate_piles(grid_size, column_height, frames, true);
+
+	REQUIRE_EQ(threaded_results.size(), serial_results.size());
+	for (uint32_t i = 0; i < serial_results.size(); i++) {
+		CHECK(threaded_results[i].transform.is_equal_approx(serial_results[i].transform));
+		CHECK(threaded_results[i].linear_velocity.is_equal_approx(serial_results[i].linear_velocity));
+	}
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Sleeping islands wake up as a whole when touched") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	PhysicsTestScene scene;
+
+	scene.add_floor(10);
+	RID box_shape = scene.create_box_shape(Vector3(0.5, 0.5, 0.5));
+
+	// A sleeping stack of two boxes, and a third one falling on it from above.
+	RID boxes[3];
+	for (int i = 0; i < 3; i++) {
+		boxes[i] = scene.add_body(PhysicsServer3D::BODY_MODE_RIGID, box_shape, Transform3D(Basis(), Vector3(0, i < 2 ? 0.5 + i : 6.0, 0)));
+	}
+	ps->body_set_state(boxes[0], PhysicsServer3D::BODY_STATE_SLEEPING, true);
+	ps->body_set_state(boxes[1], PhysicsServer3D::BODY_STATE_SLEEPING, true);
+
+	scene.step(10);
+	CHECK(bool(ps->body_get_state(boxes[0], PhysicsServer3D::BODY_STATE_SLEEPING)));
+	CHECK(bool(ps->body_get_state(boxes[1], PhysicsServer3D::BODY_STATE_SLEEPING)));
+	CHECK_EQ(scene.godot_space->get_active_objects(), 1);
+
+	// The bottom box is only touched by the middle one, but wakes up with the rest of its island.
+	bool bottom_woke_up = false;
+	for (int i = 0; i < 120 && !bottom_woke_up; i++) {
+		scene.step(1);
+		bottom_woke_up = !bool(ps->body_get_state(boxes[0], PhysicsServer3D::BODY_STATE_SLEEPING));
+	}
+	CHECK(bottom_woke_up);
+	CHECK_FALSE(bool(ps->body_get_state(boxes[1], PhysicsServer3D::BODY_STATE_SLEEPING)));
+}
+
+// Shoots a thin plate at a thin wall at x = 5 with a 30 Hz step, and returns where the plate ended up.
+static real_t shoot_plate_at_wall(RID p_wall_shape, bool p_continuous_cd) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	PhysicsTestScene scene;
+
+	scene.add_body(PhysicsServer3D::BODY_MODE_STATIC, p_wall_shape, Transform3D(Basis(), Vector3(5, 0, 0)));
+
+	RID plate_shape = scene.create_box_shape(Vector3(0.02, 0.5, 0.5));
+	RID plate = scene.add_body(PhysicsServer3D::BODY_MODE_RIGID, plate_shape, Transform3D(Basis(Vector3(0, 1, 0), 0.2), Vector3()));
+	ps->body_set_enable_continuous_collision_detection(plate, p_continuous_cd);
+	ps->body_set_state(plate, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(200, 0, 0));
+	ps->body_set_state(plate, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0, 0, 5));
+
+	scene.step(30, 1.0 / 30.0);
+	return Transform3D(ps->body_get_state(plate, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.x;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Continuous collision detection stops fast thin bodies") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID wall_shape;
+
+	SUBCASE("Box wall") {
+		wall_shape = ps->box_shape_create();
+		ps->shape_set_data(wall_shape, Vector3(0.02, 5, 5));
+	}
+
+	SUBCASE("Concave wall") {
+		wall_shape = ps->concave_polygon_shape_create();
+		PackedVector3Array faces = { Vector3(0, -5, -5), Vector3(0, 5, -5), Vector3(0, -5, 5), Vector3(0, 5, -5), Vector3(0, 5, 5), Vector3(0, -5, 5) };
+		Dictionary data;
+		data["faces"] = faces;
+		data["backface_collision"] = true;
+		ps->shape_set_data(wall_shape, data);
+	}
+
+	// The plate moves almost 7 units per step, so it goes through without continuous collision detection.
+	CHECK(shoot_plate_at_wall(wall_shape, false) > 5.0);
+	CHECK(shoot_plate_at_wall(wall_shape, true) < 5.0);
+
+	ps->free_rid(wall_shape);
+}
+
+static real_t terrain_height(real_t p_x, real_t p_z) {
+	return 6.0 * Math::sin(p_x * 0.05) * Math::cos(p_z * 0.04) + 0.5 * Math::sin(p_x * 0.7 + p_z * 0.3);
+}
+
+static Vector<real_t> make_terrain_heights(int p_size) {
+	Vector<real_t> heights;
+	heights.resize(p_size * p_size);
+	real_t *w = heights.ptrw();
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			w[z * p_size + x] = terrain_height(x, z);
+		}
+	}
+	return heights;
+}
+
+static Dictionary make_heightmap_data(int p_size) {
+	Dictionary data;
+	data["width"] = p_size;
+	data["depth"] = p_size;
+	data["heights"] = make_terrain_heights(p_size);
+	data["min_height"] = -6.5;
+	data["max_height"] = 6.5;
+	return data;
+}
+
+// Same triangles as a heightmap of the same size, centered the same way.
+static Dictionary make_terrain_mesh_data(int p_size) {
+	const Vector<real_t> heights = make_terrain_heights(p_size);
+	const real_t offset = 0.5 * (p_size - 1);
+
+	PackedVector3Array faces;
+	faces.resize((p_size - 1) * (p_size - 1) * 6);
+	Vector3 *w = faces.ptrw();
+	int i = 0;
+	for (int z = 0; z < p_size - 1; z++) {
+		for (int x = 0; x < p_size - 1; x++) {
+			const Vector3 p00(x - offset, heights[z * p_size + x], z - offset);
+			const Vector3 p10(x + 1 - offset, heights[z * p_size + x + 1], z - offset);
+			const Vector3 p01(x - offset, heights[(z + 1) * p_size + x], z + 1 - offset);
+			const Vector3 p11(x + 1 - offset, heights[(z + 1) * p_size + x + 1], z + 1 - offset);
+			w[i++] = p00;
+			w[i++] = p10;
+			w[i++] = p01;
+			w[i++] = p10;
+			w[i++] = p11;
+			w[i++] = p01;
+		}
+	}
+
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = false;
+	return data;
+}
+
+static bool collect_face(void *p_userdata, GodotShape3D *p_convex) {
+	const GodotFaceShape3D *face = static_cast<GodotFaceShape3D *>(p_convex);
+	static_cast<LocalVector<Face3> *>(p_userdata)->push_back(Face3(face->vertex[0], face->vertex[1], face->vertex[2]));
+	return false;
+}
+
+// Culling may return extra faces, but must not miss any face overlapping the queried AABB.
+static void check_cull_finds_overlapping_faces(const GodotConcaveShape3D &p_shape, const Vector<Vector3> &p_faces) {
+	RandomPCG rng(1234);
+	for (int i = 0; i < 50; i++) {
+		const Vector3 size(rng.random(0.2, 6.0), rng.random(0.2, 6.0), rng.random(0.2, 6.0));
+		const Vector3 position(rng.random(-36.0, 30.0), rng.random(-8.0, 6.0), rng.random(-36.0, 30.0));
+		const AABB query(position, size);
+
+		LocalVector<Face3> culled;
+		p_shape.cull(query, collect_face, &culled, false);
+
+		for (int f = 0; f < p_faces.size(); f += 3) {
+			const Face3 face(p_faces[f], p_faces[f + 1], p_faces[f + 2]);
+			if (!face.get_aabb().intersects(query)) {
+				continue;
+			}
+			bool found = false;
+			for (const Face3 &culled_face : culled) {
+				if (culled_face.vertex[0] == face.vertex[0] && culled_face.vertex[1] == face.vertex[1] && culled_face.vertex[2] == face.vertex[2]) {
+					found = true;
+					break;
+				}
+			}
+			CHECK_MESSAGE(found, vformat("Face %d overlapping %s was not culled.", f / 3, query));
+		}
+	}
+
+	// Nothing to return above the highest point.
+	LocalVector<Face3> culled;
+	p_shape.cull(AABB(Vector3(-10, 20, -10), Vector3(20, 1, 20)), collect_face, &culled, false);
+	CHECK(culled.is_empty());
+}
+
+TEST_CASE("[GodotPhysics3D] Heightmap and concave polygon shapes cull overlapping faces") {
+	const int size = 65;
+	const Dictionary mesh_data = make_terrain_mesh_data(size);
+	const Vector<Vector3> faces = mesh_data["faces"];
+
+	SUBCASE("Heightmap") {
+		GodotHeightMapShape3D shape;
+		shape.set_data(make_heightmap_data(size));
+		check_cull_finds_overlapping_faces(shape, faces);
+	}
+
+	SUBCASE("Concave polygon") {
+		GodotConcavePolygonShape3D shape;
+		shape.set_data(mesh_data);
+		check_cull_finds_overlapping_faces(shape, faces);
+	}
+}
+
+static int state_sync_count = 0;
+static int off_main_thread_state_sync_count = 0;
+
+static void count_state_sync(PhysicsDirectBodyState3D *p_state) {
+	state_sync_count++;
+	if (!Thread::is_main_thread()) {
+		off_main_thread_state_sync_count++;
+	}
+}
+
+// Drops rows of boxes in each of many small spaces, steps them all through the server like the main loop does,
+// and returns the final transforms of the boxes.
+static LocalVector<Transform3D> simulate_small_spaces(int p_space_count, int p_boxes_per_space, int p_frames, bool p_parallel) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	GodotPhysicsServer3D *godot_ps = GodotPhysicsServer3D::get_godot_singleton();
+	REQUIRE(godot_ps);
+	const bool was_parallel = godot_ps->is_parallel_spaces_enabled();
+	godot_ps->set_parallel_spaces_enabled(p_parallel);
+
+	LocalVector<PhysicsTestScene *> scenes;
+	LocalVector<RID> boxes;
+	for (int i = 0; i < p_space_count; i++) {
+		PhysicsTestScene *scene = memnew(PhysicsTestScene);
+		ps->space_set_active(scene->space, true);
+		scenes.push_back(scene);
+
+		scene->add_floor(10);
+		RID box_shape = scene->create_box_shape(Vector3(0.5, 0.5, 0.5));
+
+		// Each space drops its boxes from a different height, so their results differ.
+		for (int j = 0; j < p_boxes_per_space; j++) {
+			RID box = scene->add_body(PhysicsServer3D::BODY_MODE_RIGID, box_shape, Transform3D(Basis(), Vector3((j % 4) * 1.2, 0.6 + (j / 4) * 1.1 + (i % 8) * 0.25, 0)));
+			ps->body_set_state_sync_callback(box, callable_mp_static(&count_state_sync));
+			boxes.push_back(box);
+		}
+	}
+
+	state_sync_count = 0;
+	off_main_thread_state_sync_count = 0;
+	for (int i = 0; i < p_frames; i++) {
+		ps->step(1.0 / 60.0);
+		ps->flush_queries();
+	}
+
+	LocalVector<Transform3D> transforms;
+	for (const RID &box : boxes) {
+		transforms.push_back(ps->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM));
+	}
+
+	for (PhysicsTestScene *scene : scenes) {
+		memdelete(scene);
+	}
+
+	godot_ps->set_parallel_spaces_enabled(was_parallel);
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Spaces stepped in parallel match spaces stepped serially") {
+	const int space_count = 32;
+	const int boxes_per_space = 3;
+	const int frames = 60;
+
+	const LocalVector<Transform3D> serial_transforms = simulate_small_spaces(space_count, boxes_per_space, frames, false);
+	const int serial_state_sync_count = state_sync_count;
+	const LocalVector<Transform3D> parallel_transforms = simulate_small_spaces(space_count, boxes_per_space, frames, true);
+
+	REQUIRE_EQ(parallel_transforms.size(), serial_transforms.size());
+	for (uint32_t i = 0; i < serial_transforms.size(); i++) {
+		CHECK(parallel_transforms[i].origin.is_equal_approx(serial_transforms[i].origin));
+	}
+
+	// Callbacks are all called on the main thread, once the spaces are done stepping.
+	CHECK_EQ(state_sync_count, serial_state_sync_count);
+	CHECK_GT(state_sync_count, 0);
+	CHECK_EQ(off_main_thread_state_sync_count, 0);
+}
+
+// Walks a grid of characters towards its center over a floor, moving them one by one with `move_and_slide()`,
+// or all at once with `move_and_slide_batch()`, and returns where the characters ended up.
+static LocalVector<Vector3> simulate_crowd(int p_side, real_t p_spacing, int p_frames, bool p_batched) {
+	const double delta = 1.0 / 60.0;
+	// Characters moved outside of a physics frame use the process delta.
+	SceneTree::get_singleton()->process(delta);
+
+	StaticBody3D *floor = memnew(StaticBody3D);
+	CollisionShape3D *floor_collision = memnew(CollisionShape3D);
+	Ref<BoxShape3D> floor_shape;
+	floor_shape.instantiate();
+	floor_shape->set_size(Vector3(p_side * p_spacing + 20.0, 1.0, p_side * p_spacing + 20.0));
+	floor_collision->set_shape(floor_shape);
+	floor->add_child(floor_collision);
+	floor->set_position(Vector3(0, -0.5, 0));
+	SceneTree::get_singleton()->get_root()->add_child(floor);
+
+	Ref<CapsuleShape3D> capsule_shape;
+	capsule_shape.instantiate();
+	capsule_shape->set_radius(0.4);
+	capsule_shape->set_height(1.8);
+
+	TypedArray<CharacterBody3D> characters;
+	const real_t offset = (p_side - 1) * p_spacing * 0.5;
+	for (int i = 0; i < p_side * p_side; i++) {
+		CharacterBody3D *character = memnew(CharacterBody3D);
+		CollisionShape3D *collision = memnew(CollisionShape3D);
+		collision->set_shape(capsule_shape);
+		character->add_child(collision);
+		character->set_position(Vector3((i % p_side) * p_spacing - offset, 1.0, (i / p_side) * p_spacing - offset));
+		SceneTree::get_singleton()->get_root()->add_child(character);
+		characters.push_back(character);
+	}
+
+	PackedVector3Array velocities;
+	velocities.resize(characters.size());
+	for (int frame = 0; frame < p_frames; frame++) {
+		for (int i = 0; i < characters.size(); i++) {
+			const CharacterBody3D *character = Object::cast_to<CharacterBody3D>(characters[i]);
+			Vector3 velocity = -character->get_position().normalized() * 2.0;
+			velocity.y = character->is_on_floor() ? 0.0 : character->get_velocity().y - 9.8 * delta;
+			velocities.set(i, velocity);
+		}
+
+		if (p_batched) {
+			CharacterBody3D::move_and_slide_batch(characters, velocities);
+		} else {
+			for (int i = 0; i < characters.size(); i++) {
+				CharacterBody3D *character = Object::cast_to<CharacterBody3D>(characters[i]);
+				character->set_velocity(velocities[i]);
+				character->move_and_slide();
+			}
+		}
+	}
+
+	LocalVector<Vector3> positions;
+	for (int i = 0; i < characters.size(); i++) {
+		CharacterBody3D *character = Object::cast_to<CharacterBody3D>(characters[i]);
+		positions.push_back(character->get_position());
+		memdelete(character);
+	}
+	memdelete(floor);
+
+	return positions;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Characters moved in a batch match characters moved one by one") {
+	REQUIRE(GodotPhysicsServer3D::get_godot_singleton());
+
+	// Far enough apart that the characters never touch, so the order they are moved in doesn't matter.
+	const int side = 4;
+	const real_t spacing = 4.0;
+	const int frames = 60;
+
+	const LocalVector<Vector3> serial_positions = simulate_crowd(side, spacing, frames, false);
+	const LocalVector<Vector3> batched_positions = simulate_crowd(side, spacing, frames, true);
+
+	REQUIRE_EQ(batched_positions.size(), serial_positions.size());
+	for (uint32_t i = 0; i < serial_positions.size(); i++) {
+		CHECK(batched_positions[i].is_equal_approx(serial_positions[i]));
+		// The characters fell onto the floor.
+		CHECK(batched_positions[i].y < 1.0);
+	}
+}
+
+} // namespace TestGodotPhysics3D
@@ -47,6 +47,12 @@ Error ImageLoaderWebP::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitFiel
 	Vector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_length();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
+
+	const uint8_t *mapped = f->get_buffer_mapped(src_image_len);
+	if (mapped) {
+		return WebPCommon::webp_load_image_from_buffer(p_image.ptr(), mapped, src_image_len);
+	}
+
 	src_image.resize(src_image_len);
 
 	uint8_t *w = src_image.ptrw();
@@ -67,4 +73,5 @@ ImageLoaderWebP::ImageLoaderWebP() {
 	Image::webp_lossy_packer = WebPCommon::_webp_lossy_pack;
 	Image::webp_lossless_packer = WebPCommon::_webp_lossless_pack;
 	Image::webp_unpacker = WebPCommon::_webp_unpack;
+	Image::webp_unpacker_ptr = WebPCommon::_webp_unpack_ptr;
 }
@@ -120,9 +120,13 @@ Vector<uint8_t> _webp_packer(const Ref<Image> &p_image, float p_quality, bool p_
 }
 
 Ref<Image> _webp_unpack(const Vector<uint8_t> &p_buffer) {
-	int size = p_buffer.size();
-	ERR_FAIL_COND_V(size <= 0, Ref<Image>());
-	const uint8_t *r = p_buffer.ptr();
+	return _webp_unpack_ptr(p_buffer.ptr(), p_buffer.size());
+}
+
+Ref<Image> _webp_unpack_ptr(const uint8_t *p_data, int p_size) {
+	int size = p_size;
+	ERR_FAIL_COND_V(size < 12, Ref<Image>());
+	const uint8_t *r = p_data;
 
 	// A WebP file uses a RIFF header, which starts with "RIFF____WEBP".
 	ERR_FAIL_COND_V(r[0] != 'R' || r[1] != 'I' || r[2] != 'F' || r[3] != 'F' || r[8] != 'W' || r[9] != 'E' || r[10] != 'B' || r[11] != 'P', Ref<Image>());
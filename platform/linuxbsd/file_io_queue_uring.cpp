@@ -0,0 +1,318 @@
+/**************************************************************************/
+/*  file_io_queue_uring.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_io_queue_uring.h"
+
+#ifdef __linux__
+
+#include "core/config/project_settings.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+
+// IORING_OP_READ and IORING_OP_FADVISE came along with this flag (Linux 5.6).
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define URING_OPS_AVAILABLE
+#endif
+#endif
+
+void FileIOQueueURing::_close() {
+	if (sqes) {
+		munmap(sqes, sqes_size);
+		sqes = nullptr;
+	}
+	if (cq_ring && cq_ring != sq_ring) {
+		munmap(cq_ring, cq_ring_size);
+	}
+	cq_ring = nullptr;
+	if (sq_ring) {
+		munmap(sq_ring, sq_ring_size);
+		sq_ring = nullptr;
+	}
+	if (ring_fd != -1) {
+		::close(ring_fd);
+		ring_fd = -1;
+	}
+}
+
+void FileIOQueueURing::read_batch(FileIOQueue::Request *const *p_requests, uint32_t p_count) {
+#ifdef URING_OPS_AVAILABLE
+	DEV_ASSERT(p_count <= sq_entries);
+	if (broken) {
+		FileIOQueue::Backend::read_batch(p_requests, p_count);
+		return;
+	}
+
+	LocalVector<FileIOQueue::Request *> fallback;
+	LocalVector<int> fds;
+	LocalVector<uint64_t> lengths;
+	LocalVector<uint8_t> in_flight;
+	fds.resize(p_count);
+	lengths.resize(p_count);
+	in_flight.resize(p_count);
+
+	uint32_t tail = *sq_tail;
+	uint32_t queued = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		FileIOQueue::Request *request = p_requests[i];
+		fds[i] = -1;
+		in_flight[i] = false;
+		if (request->canceled.is_set()) {
+			continue;
+		}
+
+		String path = request->path;
+		if (path.begins_with("res://") || path.begins_with("user://")) {
+			path = ProjectSettings::get_singleton()->globalize_path(path);
+		}
+		if (request->through_file_access || path.contains("://") || request->length > (int64_t)INT32_MAX) {
+			fallback.push_back(request);
+			continue;
+		}
+
+		const int fd = ::open(path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+		if (fd == -1) {
+			request->error = errno == ENOENT ? ERR_FILE_NOT_FOUND : ERR_FILE_CANT_OPEN;
+			continue;
+		}
+		fds[i] = fd;
+
+		uint64_t length = request->length;
+		if (request->length < 0) {
+			struct stat st = {};
+			if (fstat(fd, &st) != 0) {
+				request->error = ERR_FILE_CANT_READ;
+				continue;
+			}
+			length = (uint64_t)st.st_size > request->offset ? st.st_size - request->offset : 0;
+		}
+		lengths[i] = length;
+
+		io_uring_sqe *sqe = &sqes[tail & *sq_mask];
+		memset(sqe, 0, sizeof(io_uring_sqe));
+		sqe->fd = fd;
+		sqe->off = request->offset;
+		sqe->user_data = i;
+		if (request->prefetch) {
+			sqe->opcode = IORING_OP_FADVISE;
+			sqe->len = length > UINT32_MAX ? 0 : length; // Zero means until the end of the file.
+			sqe->fadvise_advice = POSIX_FADV_WILLNEED;
+		} else {
+			if (length > (uint64_t)INT32_MAX || request->data.resize(length) != OK) {
+				fallback.push_back(request);
+				continue;
+			}
+			sqe->opcode = IORING_OP_READ;
+			sqe->addr = (uint64_t)request->data.ptrw();
+			sqe->len = length;
+		}
+		sq_array[tail & *sq_mask] = tail & *sq_mask;
+		in_flight[i] = true;
+		tail++;
+		queued++;
+	}
+
+	if (queued > 0) {
+		__atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+		uint32_t to_submit = queued;
+		uint32_t completed = 0;
+		while (completed < queued) {
+			const int ret = syscall(__NR_io_uring_enter, ring_fd, to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+			const int error = errno;
+			// The kernel may have consumed some entries even if the call failed, its head tells which.
+			to_submit = tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+			if (ret < 0 && error != EINTR && error != EAGAIN && error != EBUSY) {
+				if (to_submit > 0) {
+					// Take back the entries the kernel hasn't seen, so the next batch doesn't submit them.
+					// They are read without io_uring, but the ones already submitted must still complete
+					// before their buffers and files go away.
+					ERR_PRINT(vformat("io_uring_enter() failed with errno %d, reading %d files without io_uring.", error, to_submit));
+					tail -= to_submit;
+					for (uint32_t pos = tail; pos != tail + to_submit; pos++) {
+						const uint32_t index = sqes[sq_array[pos & *sq_mask]].user_data;
+						in_flight[index] = false;
+						if (!p_requests[index]->prefetch) {
+							p_requests[index]->data.clear();
+							fallback.push_back(p_requests[index]);
+						}
+					}
+					__atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+					queued -= to_submit;
+					to_submit = 0;
+					continue;
+				}
+
+				// Waiting for completions failed as well, there's no telling when the kernel is done with the
+				// submitted reads. Stop using the ring altogether.
+				ERR_PRINT(vformat("io_uring_enter() failed with errno %d while waiting for reads, io_uring won't be used anymore.", error));
+				broken = true;
+				break;
+			}
+
+			uint32_t head = *cq_head;
+			while (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+				const io_uring_cqe *cqe = &cqes[head & *cq_mask];
+				const uint32_t index = cqe->user_data;
+				FileIOQueue::Request *request = p_requests[index];
+				const int res = cqe->res;
+				head++;
+				completed++;
+				in_flight[index] = false;
+
+				if (request->prefetch) {
+					continue; // Only a hint, errors don't matter.
+				}
+				if (res == -EINVAL || res == -EOPNOTSUPP) {
+					// Old kernel without IORING_OP_READ.
+					request->data.clear();
+					fallback.push_back(request);
+					continue;
+				}
+				if (res < 0) {
+					request->data.clear();
+					request->error = ERR_FILE_CANT_READ;
+					continue;
+				}
+
+				// Short reads happen at the end of the file, or when the kernel splits large reads.
+				uint64_t read = res;
+				while (read < lengths[index]) {
+					const ssize_t more = pread(fds[index], request->data.ptrw() + read, lengths[index] - read, request->offset + read);
+					if (more <= 0) {
+						break;
+					}
+					read += more;
+				}
+				if (read < lengths[index]) {
+					request->data.resize(read);
+				}
+			}
+			__atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+		}
+	}
+
+	if (broken) {
+		// The kernel may still write into these buffers and read from these files, keep them alive.
+		for (uint32_t i = 0; i < p_count; i++) {
+			if (!in_flight[i]) {
+				continue;
+			}
+			FileIOQueue::Request *request = p_requests[i];
+			abandoned_buffers.push_back(request->data);
+			request->data = Vector<uint8_t>();
+			fds[i] = -1;
+			if (!request->prefetch) {
+				fallback.push_back(request);
+			}
+		}
+	}
+
+	for (int fd : fds) {
+		if (fd != -1) {
+			::close(fd);
+		}
+	}
+
+	if (!fallback.is_empty()) {
+		FileIOQueue::Backend::read_batch(fallback.ptr(), fallback.size());
+	}
+#else
+	FileIOQueue::Backend::read_batch(p_requests, p_count);
+#endif // URING_OPS_AVAILABLE
+}
+
+FileIOQueueURing::FileIOQueueURing() {
+#ifdef URING_OPS_AVAILABLE
+	io_uring_params params = {};
+	ring_fd = syscall(__NR_io_uring_setup, RING_ENTRIES, &params);
+	if (ring_fd < 0) {
+		ring_fd = -1;
+		print_verbose(vformat("io_uring is not available (errno %d), using the default file I/O queue.", errno));
+		return;
+	}
+
+	sq_entries = params.sq_entries;
+	sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (single_mmap) {
+		sq_ring_size = MAX(sq_ring_size, cq_ring_size);
+	}
+
+	void *mapping = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+	if (mapping == MAP_FAILED) {
+		_close();
+		return;
+	}
+	sq_ring = (uint8_t *)mapping;
+
+	if (single_mmap) {
+		cq_ring = sq_ring;
+	} else {
+		mapping = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+		if (mapping == MAP_FAILED) {
+			_close();
+			return;
+		}
+		cq_ring = (uint8_t *)mapping;
+	}
+
+	sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	mapping = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+	if (mapping == MAP_FAILED) {
+		_close();
+		return;
+	}
+	sqes = (io_uring_sqe *)mapping;
+
+	sq_head = (uint32_t *)(sq_ring + params.sq_off.head);
+	sq_tail = (uint32_t *)(sq_ring + params.sq_off.tail);
+	sq_mask = (uint32_t *)(sq_ring + params.sq_off.ring_mask);
+	sq_array = (uint32_t *)(sq_ring + params.sq_off.array);
+	cq_head = (uint32_t *)(cq_ring + params.cq_off.head);
+	cq_tail = (uint32_t *)(cq_ring + params.cq_off.tail);
+	cq_mask = (uint32_t *)(cq_ring + params.cq_off.ring_mask);
+	cqes = (io_uring_cqe *)(cq_ring + params.cq_off.cqes);
+#endif // URING_OPS_AVAILABLE
+}
+
+FileIOQueueURing::~FileIOQueueURing() {
+	_close();
+}
+
+#endif // __linux__
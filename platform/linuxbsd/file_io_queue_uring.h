@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  file_io_queue_uring.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_io_queue.h"
+
+#ifdef __linux__
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// Serves FileIOQueue batches with io_uring, so a single I/O thread keeps many
+// reads in flight. Falls back to the default backend if the kernel (or a
+// seccomp policy) doesn't allow io_uring.
+class FileIOQueueURing : public FileIOQueue::Backend {
+	static constexpr uint32_t RING_ENTRIES = 32;
+
+	int ring_fd = -1;
+	uint32_t sq_entries = 0;
+	// Set when the ring can't be trusted anymore, every read then goes through the default backend.
+	bool broken = false;
+	// Buffers of reads that never completed, the kernel may still write into them.
+	LocalVector<Vector<uint8_t>> abandoned_buffers;
+
+	uint8_t *sq_ring = nullptr;
+	size_t sq_ring_size = 0;
+	uint8_t *cq_ring = nullptr;
+	size_t cq_ring_size = 0;
+	io_uring_sqe *sqes = nullptr;
+	size_t sqes_size = 0;
+
+	uint32_t *sq_head = nullptr;
+	uint32_t *sq_tail = nullptr;
+	uint32_t *sq_mask = nullptr;
+	uint32_t *sq_array = nullptr;
+	uint32_t *cq_head = nullptr;
+	uint32_t *cq_tail = nullptr;
+	uint32_t *cq_mask = nullptr;
+	io_uring_cqe *cqes = nullptr;
+
+	void _close();
+
+public:
+	virtual void read_batch(FileIOQueue::Request *const *p_requests, uint32_t p_count) override;
+	virtual uint32_t get_max_batch_size() const override { return sq_entries; }
+	virtual uint32_t get_thread_count() const override { return 1; }
+	virtual bool is_valid() const override { return ring_fd != -1; }
+	virtual bool is_asynchronous() const override { return !broken; }
+
+	FileIOQueueURing();
+	~FileIOQueueURing();
+};
+
+#endif // __linux__
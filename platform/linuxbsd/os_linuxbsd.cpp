@@ -30,9 +30,12 @@
 
 #include "os_linuxbsd.h"
 
+#include "file_io_queue_uring.h"
+
 #include "core/io/certs_compressed.gen.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_io_queue.h"
 #include "core/os/main_loop.h"
 #ifdef SDL_ENABLED
 #include "drivers/sdl/joypad_sdl.h"
@@ -160,6 +163,10 @@ void OS_LinuxBSD::initialize() {
 
 	OS_Unix::initialize_core();
 
+#ifdef __linux__
+	FileIOQueue::make_default_backend<FileIOQueueURing>();
+#endif
+
 	system_dir_desktop_cache = get_system_dir(SYSTEM_DIR_DESKTOP);
 }
 
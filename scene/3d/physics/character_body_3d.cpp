@@ -30,6 +30,9 @@
 
 #include "character_body_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
+
 #ifndef DISABLE_DEPRECATED
 #include "servers/physics_3d/physics_server_3d_extension.h"
 #endif
@@ -41,6 +44,11 @@ bool CharacterBody3D::move_and_slide() {
 	// Hack in order to work with calling from _process as well as from _physics_process; calling from thread is risky
 	double delta = Engine::get_singleton()->is_in_physics_frame() ? get_physics_process_delta_time() : get_process_delta_time();
 
+	Vector3 current_platform_velocity = _prepare_move_and_slide();
+	return _move_and_slide(delta, current_platform_velocity);
+}
+
+Vector3 CharacterBody3D::_prepare_move_and_slide() {
 	for (int i = 0; i < 3; i++) {
 		if (locked_axis & (1 << i)) {
 			velocity[i] = 0.0;
@@ -87,6 +95,12 @@ bool CharacterBody3D::move_and_slide() {
 		}
 	}
 
+	return current_platform_velocity;
+}
+
+bool CharacterBody3D::_move_and_slide(double p_delta, const Vector3 &p_platform_velocity) {
+	Vector3 current_platform_velocity = p_platform_velocity;
+
 	motion_results.clear();
 
 	bool was_on_floor = collision_state.floor;
@@ -95,7 +109,7 @@ bool CharacterBody3D::move_and_slide() {
 	last_motion = Vector3();
 
 	if (!current_platform_velocity.is_zero_approx()) {
-		PhysicsServer3D::MotionParameters parameters(get_global_transform(), current_platform_velocity * delta, margin);
+		PhysicsServer3D::MotionParameters parameters(_get_motion_transform(), current_platform_velocity * p_delta, margin);
 		parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
 
 		parameters.exclude_bodies.insert(platform_rid);
@@ -104,7 +118,7 @@ bool CharacterBody3D::move_and_slide() {
 		}
 
 		PhysicsServer3D::MotionResult floor_result;
-		if (move_and_collide(parameters, floor_result, false, false)) {
+		if (_move_and_collide(parameters, floor_result, false, false)) {
 			motion_results.push_back(floor_result);
 
 			CollisionState result_state;
@@ -113,13 +127,13 @@ bool CharacterBody3D::move_and_slide() {
 	}
 
 	if (motion_mode == MOTION_MODE_GROUNDED) {
-		_move_and_slide_grounded(delta, was_on_floor);
+		_move_and_slide_grounded(p_delta, was_on_floor);
 	} else {
-		_move_and_slide_floating(delta);
+		_move_and_slide_floating(p_delta);
 	}
 
 	// Compute real velocity.
-	real_velocity = get_position_delta() / delta;
+	real_velocity = (_get_motion_transform().origin - previous_position) / p_delta;
 
 	if (platform_on_leave != PLATFORM_ON_LEAVE_DO_NOTHING) {
 		// Add last platform velocity when just left a moving platform.
@@ -134,6 +148,100 @@ bool CharacterBody3D::move_and_slide() {
 	return motion_results.size() > 0;
 }
 
+PackedVector3Array CharacterBody3D::move_and_slide_batch(const TypedArray<CharacterBody3D> &p_bodies, const PackedVector3Array &p_velocities) {
+	ERR_FAIL_COND_V_MSG(!p_velocities.is_empty() && p_velocities.size() != p_bodies.size(), PackedVector3Array(), "The velocities must be empty, or match the bodies one to one.");
+
+	MoveAndSlideBatch batch;
+	HashSet<CharacterBody3D *> batched_bodies;
+	batch.bodies.reserve(p_bodies.size());
+	for (int i = 0; i < p_bodies.size(); i++) {
+		CharacterBody3D *body = Object::cast_to<CharacterBody3D>(p_bodies[i]);
+		ERR_CONTINUE_MSG(body == nullptr || !body->is_inside_tree(), vformat("Body %d in the batch is not a CharacterBody3D inside the scene tree.", i));
+		ERR_CONTINUE_MSG(batched_bodies.has(body), vformat("Body %d is already in the batch.", i));
+		batched_bodies.insert(body);
+		if (!p_velocities.is_empty()) {
+			body->velocity = p_velocities[i];
+		}
+		batch.bodies.push_back(body);
+	}
+
+	if (!batch.bodies.is_empty()) {
+		// Same as move_and_slide(), all bodies share the frame they are moved in.
+		batch.delta = Engine::get_singleton()->is_in_physics_frame() ? batch.bodies[0]->get_physics_process_delta_time() : batch.bodies[0]->get_process_delta_time();
+	}
+
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	batch.platform_velocities.resize(batch.bodies.size());
+	for (uint32_t i = 0; i < batch.bodies.size(); i++) {
+		batch.platform_velocities[i] = batch.bodies[i]->_prepare_move_and_slide();
+	}
+
+	if (batch.bodies.size() > 1 && physics_server->begin_parallel_motion_tests()) {
+		for (CharacterBody3D *body : batch.bodies) {
+			body->batched_motion = true;
+			body->batched_transform = body->get_global_transform();
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&CharacterBody3D::_move_and_slide_batched, &batch, batch.bodies.size(), -1, true, SNAME("CharacterBody3DMoveAndSlideBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		physics_server->end_parallel_motion_tests();
+
+		for (CharacterBody3D *body : batch.bodies) {
+			body->batched_motion = false;
+			for (const PhysicsServer3D::MotionCollision &collision : body->batched_platform_collisions) {
+				body->_set_platform_data(collision);
+			}
+			body->batched_platform_collisions.clear();
+			if (body->batched_transform != body->get_global_transform()) {
+				body->set_global_transform(body->batched_transform);
+			}
+		}
+	} else {
+		for (uint32_t i = 0; i < batch.bodies.size(); i++) {
+			batch.bodies[i]->_move_and_slide(batch.delta, batch.platform_velocities[i]);
+		}
+	}
+
+	PackedVector3Array velocities;
+	velocities.resize(p_bodies.size());
+	Vector3 *velocities_ptrw = velocities.ptrw();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		const CharacterBody3D *body = Object::cast_to<CharacterBody3D>(p_bodies[i]);
+		velocities_ptrw[i] = body ? body->velocity : Vector3();
+	}
+	return velocities;
+}
+
+void CharacterBody3D::_move_and_slide_batched(void *p_batch, uint32_t p_index) {
+	MoveAndSlideBatch *batch = static_cast<MoveAndSlideBatch *>(p_batch);
+	batch->bodies[p_index]->_move_and_slide(batch->delta, batch->platform_velocities[p_index]);
+}
+
+Transform3D CharacterBody3D::_get_motion_transform() const {
+	return batched_motion ? batched_transform : get_global_transform();
+}
+
+void CharacterBody3D::_set_motion_transform(const Transform3D &p_transform) {
+	if (batched_motion) {
+		batched_transform = p_transform;
+	} else {
+		set_global_transform(p_transform);
+	}
+}
+
+bool CharacterBody3D::_move_and_collide(const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult &r_result, bool p_test_only, bool p_cancel_sliding) {
+	if (!batched_motion) {
+		return move_and_collide(p_parameters, r_result, p_test_only, p_cancel_sliding);
+	}
+
+	bool colliding = move_and_collide(p_parameters, r_result, true, p_cancel_sliding);
+	if (!p_test_only) {
+		batched_transform = p_parameters.from;
+		batched_transform.origin += r_result.travel;
+	}
+	return colliding;
+}
+
 void CharacterBody3D::_move_and_slide_grounded(double p_delta, bool p_was_on_floor) {
 	Vector3 motion = velocity * p_delta;
 	Vector3 motion_slide_up = motion.slide(up_direction);
@@ -160,12 +268,12 @@ void CharacterBody3D::_move_and_slide_grounded(double p_delta, bool p_was_on_flo
 	Vector3 total_travel;
 
 	for (int iteration = 0; iteration < max_slides; ++iteration) {
-		PhysicsServer3D::MotionParameters parameters(get_global_transform(), motion, margin);
+		PhysicsServer3D::MotionParameters parameters(_get_motion_transform(), motion, margin);
 		parameters.max_collisions = 6; // There can be 4 collisions between 2 walls + 2 more for the floor.
 		parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
 
 		PhysicsServer3D::MotionResult result;
-		bool collided = move_and_collide(parameters, result, false, !sliding_enabled);
+		bool collided = _move_and_collide(parameters, result, false, !sliding_enabled);
 
 		last_motion = result.travel;
 
@@ -191,11 +299,11 @@ void CharacterBody3D::_move_and_slide_grounded(double p_delta, bool p_was_on_flo
 			}
 
 			if (collision_state.floor && floor_stop_on_slope && (velocity.normalized() + up_direction).length() < 0.01) {
-				Transform3D gt = get_global_transform();
+				Transform3D gt = _get_motion_transform();
 				if (result.travel.length() <= margin + CMP_EPSILON) {
 					gt.origin -= result.travel;
 				}
-				set_global_transform(gt);
+				_set_motion_transform(gt);
 				velocity = Vector3();
 				motion = Vector3();
 				last_motion = Vector3();
@@ -227,7 +335,7 @@ void CharacterBody3D::_move_and_slide_grounded(double p_delta, bool p_was_on_flo
 						apply_default_sliding = false;
 						if (p_was_on_floor && !vel_dir_facing_up) {
 							// Cancel the motion.
-							Transform3D gt = get_global_transform();
+							Transform3D gt = _get_motion_transform();
 							real_t travel_total = result.travel.length();
 							real_t cancel_dist_max = MIN(0.1, margin * 20);
 							if (travel_total <= margin + CMP_EPSILON) {
@@ -243,7 +351,7 @@ void CharacterBody3D::_move_and_slide_grounded(double p_delta, bool p_was_on_flo
 								result.travel = result.travel.slide(up_direction);
 								motion = result.remainder;
 							}
-							set_global_transform(gt);
+							_set_motion_transform(gt);
 							// Determines if you are on the ground, and limits the possibility of climbing on the walls because of the approximations.
 							_snap_on_floor(true, false);
 						} else {
@@ -366,9 +474,9 @@ void CharacterBody3D::_move_and_slide_grounded(double p_delta, bool p_was_on_flo
 		else if (floor_constant_speed && first_slide && _on_floor_if_snapped(p_was_on_floor, vel_dir_facing_up)) {
 			can_apply_constant_speed = false;
 			sliding_enabled = true;
-			Transform3D gt = get_global_transform();
+			Transform3D gt = _get_motion_transform();
 			gt.origin = gt.origin - result.travel;
-			set_global_transform(gt);
+			_set_motion_transform(gt);
 
 			// Slide using the intersection between the motion plane and the floor plane,
 			// in order to keep the direction intact.
@@ -407,11 +515,11 @@ void CharacterBody3D::_move_and_slide_floating(double p_delta) {
 
 	bool first_slide = true;
 	for (int iteration = 0; iteration < max_slides; ++iteration) {
-		PhysicsServer3D::MotionParameters parameters(get_global_transform(), motion, margin);
+		PhysicsServer3D::MotionParameters parameters(_get_motion_transform(), motion, margin);
 		parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
 
 		PhysicsServer3D::MotionResult result;
-		bool collided = move_and_collide(parameters, result, false, false);
+		bool collided = _move_and_collide(parameters, result, false, false);
 
 		last_motion = result.travel;
 
@@ -429,9 +537,9 @@ void CharacterBody3D::_move_and_slide_floating(double p_delta) {
 			if (wall_min_slide_angle != 0 && Math::acos(wall_normal.dot(-velocity.normalized())) < wall_min_slide_angle + FLOOR_ANGLE_THRESHOLD) {
 				motion = Vector3();
 				if (result.travel.length() < margin + CMP_EPSILON) {
-					Transform3D gt = get_global_transform();
+					Transform3D gt = _get_motion_transform();
 					gt.origin -= result.travel;
-					set_global_transform(gt);
+					_set_motion_transform(gt);
 				}
 			} else if (first_slide) {
 				Vector3 motion_slide_norm = result.remainder.slide(wall_normal).normalized();
@@ -461,13 +569,13 @@ void CharacterBody3D::apply_floor_snap() {
 	// Snap by at least collision margin to keep floor state consistent.
 	real_t length = MAX(floor_snap_length, margin);
 
-	PhysicsServer3D::MotionParameters parameters(get_global_transform(), -up_direction * length, margin);
+	PhysicsServer3D::MotionParameters parameters(_get_motion_transform(), -up_direction * length, margin);
 	parameters.max_collisions = 4;
 	parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
 	parameters.collide_separation_ray = true;
 
 	PhysicsServer3D::MotionResult result;
-	if (move_and_collide(parameters, result, true, false)) {
+	if (_move_and_collide(parameters, result, true, false)) {
 		CollisionState result_state;
 		// Apply direction for floor only.
 		_set_collision_direction(result, result_state, CollisionState(true, false, false));
@@ -484,7 +592,7 @@ void CharacterBody3D::apply_floor_snap() {
 			}
 
 			parameters.from.origin += result.travel;
-			set_global_transform(parameters.from);
+			_set_motion_transform(parameters.from);
 		}
 	}
 }
@@ -505,13 +613,13 @@ bool CharacterBody3D::_on_floor_if_snapped(bool p_was_on_floor, bool p_vel_dir_f
 	// Snap by at least collision margin to keep floor state consistent.
 	real_t length = MAX(floor_snap_length, margin);
 
-	PhysicsServer3D::MotionParameters parameters(get_global_transform(), -up_direction * length, margin);
+	PhysicsServer3D::MotionParameters parameters(_get_motion_transform(), -up_direction * length, margin);
 	parameters.max_collisions = 4;
 	parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
 	parameters.collide_separation_ray = true;
 
 	PhysicsServer3D::MotionResult result;
-	if (move_and_collide(parameters, result, true, false)) {
+	if (_move_and_collide(parameters, result, true, false)) {
 		CollisionState result_state;
 		// Don't apply direction for any type.
 		_set_collision_direction(result, result_state, CollisionState());
@@ -611,6 +719,12 @@ void CharacterBody3D::_set_collision_direction(const PhysicsServer3D::MotionResu
 }
 
 void CharacterBody3D::_set_platform_data(const PhysicsServer3D::MotionCollision &p_collision) {
+	if (batched_motion) {
+		// The body state of the physics server can only be accessed from the main thread.
+		batched_platform_collisions.push_back(p_collision);
+		return;
+	}
+
 	PhysicsDirectBodyState3D *bs = PhysicsServer3D::get_singleton()->body_get_direct_state(p_collision.collider);
 	if (bs == nullptr) {
 		return;
@@ -865,6 +979,7 @@ void CharacterBody3D::_notification(int p_what) {
 
 void CharacterBody3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("move_and_slide"), &CharacterBody3D::move_and_slide);
+	ClassDB::bind_static_method("CharacterBody3D", D_METHOD("move_and_slide_batch", "bodies", "velocities"), &CharacterBody3D::move_and_slide_batch, DEFVAL(PackedVector3Array()));
 	ClassDB::bind_method(D_METHOD("apply_floor_snap"), &CharacterBody3D::apply_floor_snap);
 
 	ClassDB::bind_method(D_METHOD("set_velocity", "velocity"), &CharacterBody3D::set_velocity);
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
 #include "scene/3d/physics/kinematic_collision_3d.h"
 #include "scene/3d/physics/physics_body_3d.h"
 
@@ -47,6 +48,7 @@ public:
 		PLATFORM_ON_LEAVE_DO_NOTHING,
 	};
 	bool move_and_slide();
+	static PackedVector3Array move_and_slide_batch(const TypedArray<CharacterBody3D> &p_bodies, const PackedVector3Array &p_velocities = PackedVector3Array());
 	void apply_floor_snap();
 
 	const Vector3 &get_velocity() const;
@@ -164,6 +166,25 @@ private:
 	Vector<PhysicsServer3D::MotionResult> motion_results;
 	Vector<Ref<KinematicCollision3D>> slide_colliders;
 
+	// Set while move_and_slide_batch() moves the body on a worker thread. The body
+	// only moves its own copy of the transform, and keeps the platforms it touched,
+	// until the batch is applied back on the main thread.
+	bool batched_motion = false;
+	Transform3D batched_transform;
+	LocalVector<PhysicsServer3D::MotionCollision> batched_platform_collisions;
+
+	struct MoveAndSlideBatch {
+		double delta = 0.0;
+		LocalVector<CharacterBody3D *> bodies;
+		LocalVector<Vector3> platform_velocities;
+	};
+
+	static void _move_and_slide_batched(void *p_batch, uint32_t p_index);
+	Vector3 _prepare_move_and_slide();
+	bool _move_and_slide(double p_delta, const Vector3 &p_platform_velocity);
+	Transform3D _get_motion_transform() const;
+	void _set_motion_transform(const Transform3D &p_transform);
+	bool _move_and_collide(const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult &r_result, bool p_test_only = false, bool p_cancel_sliding = true);
 	void _move_and_slide_floating(double p_delta);
 	void _move_and_slide_grounded(double p_delta, bool p_was_on_floor);
 
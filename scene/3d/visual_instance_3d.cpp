@@ -74,6 +74,7 @@ void VisualInstance3D::set_instance_use_identity_transform(bool p_enable) {
 }
 
 void VisualInstance3D::fti_update_servers_xform() {
+	// Note that SceneTreeFTI uploads the xforms of visual instances in batches, keep in sync.
 	if (!_is_using_identity_transform()) {
 		RS::get_singleton()->instance_set_transform(get_instance(), _get_cached_global_transform_interpolated());
 	}
@@ -55,6 +55,11 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, Engine);
 SafeNumeric<uint64_t> Node::total_node_count{ 0 };
 #endif
 
+SafeNumeric<uint32_t> Node::tree_structure_generation{ 0 };
+
+// Bounds the per-node resolved paths cache, it is cleared when full.
+static constexpr uint32_t RESOLVED_PATHS_CACHE_MAX = 32;
+
 thread_local Node *Node::current_process_thread_group = nullptr;
 
 void Node::_notification(int p_notification) {
@@ -1450,7 +1455,9 @@ void Node::set_name(const StringName &p_name) {
 		data.parent->_validate_child_name(this, true);
 		bool success = data.parent->data.children.replace_key(old_name, data.name);
 		ERR_FAIL_COND_MSG(!success, "Renaming child in hashtable failed, this is a bug.");
+		data.parent->_release_serial_child_name(old_name);
 	}
+	_tree_structure_changed();
 
 	if (data.unique_name_in_owner && data.owner) {
 		_acquire_unique_name_in_owner();
@@ -1516,7 +1523,7 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 	/* Make sure the name is unique */
 
 	if (p_force_human_readable) {
-		//this approach to autoset node names is human readable but very slow
+		//this approach to autoset node names is human readable but slower
 
 		StringName name = p_child->data.name;
 		_generate_serial_child_name(p_child, name);
@@ -1624,6 +1631,40 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 		nums = "";
 	}
 
+	if (nums.is_empty() || (nums[0] != '0' && nums.length() < 10)) {
+		// Canonical numbering, so the per-base hint can be used to skip numbers
+		// known to be taken instead of probing every sibling name in turn.
+		if (nums.is_empty()) {
+			// Name was undecorated so skip to 2 for a more natural result
+			name_string += nnsep;
+		}
+		if (!data.serial_child_name_hints) {
+			data.serial_child_name_hints = memnew((HashMap<StringName, SerialChildNameHint>));
+		}
+		HashMap<StringName, SerialChildNameHint>::Iterator H = data.serial_child_name_hints->find(name_string);
+		if (!H) {
+			H = data.serial_child_name_hints->insert(name_string, SerialChildNameHint());
+		}
+		SerialChildNameHint &hint = H->value;
+
+		const uint32_t start = nums.is_empty() ? 2 : (uint32_t)nums.to_int();
+		const bool contiguous = start <= hint.next;
+		for (uint32_t num = contiguous ? hint.next : start;; num++) {
+			StringName attempt = name_string + itos(num);
+
+			existing = data.children.getptr(attempt);
+			if (existing == nullptr || *existing == p_child) {
+				if (contiguous) {
+					// Everything below this number has now been seen taken.
+					hint.next = num;
+				}
+				hint.count++;
+				name = attempt;
+				return;
+			}
+		}
+	}
+
 	for (;;) {
 		StringName attempt = name_string + nums;
 
@@ -1634,13 +1675,44 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 			name = attempt;
 			return;
 		} else {
-			if (nums.length() == 0) {
-				// Name was undecorated so skip to 2 for a more natural result
-				nums = "2";
-				name_string += nnsep; // Add separator because nums.length() > 0 was false
-			} else {
-				nums = increase_numeric_string(nums);
-			}
+			nums = increase_numeric_string(nums);
+		}
+	}
+}
+
+void Node::_release_serial_child_name(const StringName &p_name) const {
+	if (!data.serial_child_name_hints || data.serial_child_name_hints->is_empty()) {
+		return;
+	}
+
+	// A serial name becoming free must lower the hint for its base, so that
+	// generated names keep filling the lowest free number first.
+	const String name_string = p_name;
+	int base_length = name_string.length();
+	while (base_length > 0 && is_digit(name_string[base_length - 1])) {
+		base_length--;
+	}
+	const int nums_length = name_string.length() - base_length;
+	if (nums_length == 0 || nums_length >= 10 || name_string[base_length] == '0') {
+		return;
+	}
+
+	HashMap<StringName, SerialChildNameHint>::Iterator E = data.serial_child_name_hints->find(name_string.substr(0, base_length));
+	if (!E) {
+		return;
+	}
+	E->value.next = MIN(E->value.next, (uint32_t)name_string.substr(base_length).to_int());
+
+	// Names of this base that were not generated are not counted, so the hint may be
+	// erased while some are left. That only means the next name is probed from 2 again.
+	if (E->value.count > 0) {
+		E->value.count--;
+	}
+	if (E->value.count == 0) {
+		data.serial_child_name_hints->remove(E);
+		if (data.serial_child_name_hints->is_empty()) {
+			memdelete(data.serial_child_name_hints);
+			data.serial_child_name_hints = nullptr;
 		}
 	}
 }
@@ -1739,11 +1811,14 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 	ERR_FAIL_COND(p_child->data.parent != this);
 
 	/**
-	 *  Do not change the data.internal_children*cache counters here.
+	 *  Do not change the data.internal_children*cache counters here,
+	 *  unless the slot is trimmed from the end of the cache.
 	 *  Because if nodes are re-added, the indices can remain
 	 *  greater-than-everything indices and children added remain
 	 *  properly ordered.
 	 *
+	 *  If the cache is valid, the child slot is just cleared and
+	 *  compacted lazily, which keeps the order without re-sorting.
 	 *  All children indices and counters will be updated next time the
 	 *  cache is re-generated.
 	 */
@@ -1756,9 +1831,47 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 
 	data.blocked--;
 
-	data.children_cache_dirty = true;
+	if (!data.children_cache_dirty) {
+		uint32_t slot = p_child->data.index;
+		if (p_child->data.internal_mode == INTERNAL_MODE_DISABLED) {
+			slot += data.internal_children_front_count_cache;
+		} else if (p_child->data.internal_mode == INTERNAL_MODE_BACK) {
+			slot += data.internal_children_front_count_cache + data.external_children_count_cache;
+		}
+		DEV_ASSERT(slot < data.children_cache.size() && data.children_cache[slot] == p_child);
+		data.children_cache[slot] = nullptr;
+		if (!data.children_cache_holes.is_empty() && data.children_cache_holes[data.children_cache_holes.size() - 1] > slot) {
+			data.children_cache_holes_sorted = false;
+		}
+		data.children_cache_holes.push_back(slot);
+
+		// Trim cleared slots at the end, so removing the last children keeps the cache compact.
+		uint32_t trimmed = 0;
+		while (!data.children_cache.is_empty() && data.children_cache[data.children_cache.size() - 1] == nullptr) {
+			const int last = data.children_cache.size() - 1;
+			if (last < data.internal_children_front_count_cache) {
+				data.internal_children_front_count_cache--;
+			} else if (last < data.internal_children_front_count_cache + data.external_children_count_cache) {
+				data.external_children_count_cache--;
+			} else {
+				data.internal_children_back_count_cache--;
+			}
+			data.children_cache.resize(last);
+			trimmed++;
+		}
+		if (trimmed > 0) {
+			// The trimmed slots are the last holes once sorted, usually only the one just added.
+			if (trimmed > 1) {
+				_sort_children_cache_holes();
+			}
+			data.children_cache_holes.resize(data.children_cache_holes.size() - trimmed);
+		}
+	}
+
 	bool success = data.children.erase(p_child->data.name);
 	ERR_FAIL_COND_MSG(!success, "Children name does not match parent name in hashtable, this is a bug.");
+	_release_serial_child_name(p_child->data.name);
+	_tree_structure_changed();
 
 	p_child->data.parent = nullptr;
 	p_child->data.index = -1;
@@ -1772,15 +1885,26 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 }
 
 void Node::_update_children_cache_impl() const {
-	// Assign children
-	data.children_cache.resize(data.children.size());
-	int idx = 0;
-	for (const KeyValue<StringName, Node *> &K : data.children) {
-		data.children_cache[idx] = K.value;
-		idx++;
-	}
-	// Sort them
-	data.children_cache.sort_custom<ComparatorByIndex>();
+	if (data.children_cache_dirty) {
+		// Assign children
+		data.children_cache.resize(data.children.size());
+		int idx = 0;
+		for (const KeyValue<StringName, Node *> &K : data.children) {
+			data.children_cache[idx] = K.value;
+			idx++;
+		}
+		// Sort them
+		data.children_cache.sort_custom<ComparatorByIndex>();
+	} else {
+		// Only removals happened, drop the cleared slots keeping the order.
+		uint32_t to = 0;
+		for (uint32_t from = 0; from < data.children_cache.size(); from++) {
+			if (data.children_cache[from]) {
+				data.children_cache[to++] = data.children_cache[from];
+			}
+		}
+		data.children_cache.resize(to);
+	}
 	// Update indices
 	data.external_children_count_cache = 0;
 	data.internal_children_back_count_cache = 0;
@@ -1800,6 +1924,68 @@ void Node::_update_children_cache_impl() const {
 		}
 	}
 	data.children_cache_dirty = false;
+	data.children_cache_holes.clear();
+	data.children_cache_holes_sorted = true;
+}
+
+void Node::_sort_children_cache_holes() const {
+	if (!data.children_cache_holes_sorted) {
+		data.children_cache_holes.sort();
+		data.children_cache_holes_sorted = true;
+	}
+}
+
+uint32_t Node::_count_children_cache_holes(uint32_t p_from, uint32_t p_to) const {
+	if (data.children_cache_holes.is_empty()) {
+		return 0;
+	}
+	_sort_children_cache_holes();
+	// Number of holes before a slot, found by bisecting the sorted hole slots.
+	auto holes_before = [this](uint32_t p_slot) {
+		uint32_t lo = 0;
+		uint32_t hi = data.children_cache_holes.size();
+		while (lo < hi) {
+			const uint32_t mid = (lo + hi) / 2;
+			if (data.children_cache_holes[mid] < p_slot) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		return lo;
+	};
+	return holes_before(p_to) - holes_before(p_from);
+}
+
+uint32_t Node::_get_children_cache_slot(uint32_t p_index) const {
+	_sort_children_cache_holes();
+	// There are `hole - i` children before the i-th hole, so the slot is past the holes with at most
+	// `p_index` children before them. Bisect for the first hole with more.
+	uint32_t lo = 0;
+	uint32_t hi = data.children_cache_holes.size();
+	while (lo < hi) {
+		const uint32_t mid = (lo + hi) / 2;
+		if (data.children_cache_holes[mid] - mid <= p_index) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return p_index + lo;
+}
+
+int Node::_get_child_index_with_holes(const Node *p_child, bool p_include_internal) const {
+	uint32_t section_start = 0;
+	if (p_child->data.internal_mode == INTERNAL_MODE_DISABLED) {
+		section_start = data.internal_children_front_count_cache;
+	} else if (p_child->data.internal_mode == INTERNAL_MODE_BACK) {
+		section_start = data.internal_children_front_count_cache + data.external_children_count_cache;
+	}
+	const uint32_t slot = section_start + p_child->data.index;
+	if (!p_include_internal) {
+		return p_child->data.index - _count_children_cache_holes(section_start, slot);
+	}
+	return slot - _count_children_cache_holes(0, slot);
 }
 
 template <bool p_include_internal>
@@ -1828,27 +2014,31 @@ int Node::get_child_count(bool p_include_internal) const {
 		return data.children.size();
 	}
 
-	_update_children_cache();
-	return data.children_cache.size() - data.internal_children_front_count_cache - data.internal_children_back_count_cache;
+	_update_children_cache_sparse();
+	const uint32_t front = data.internal_children_front_count_cache;
+	return data.external_children_count_cache - _count_children_cache_holes(front, front + data.external_children_count_cache);
 }
 
 Node *Node::get_child(int p_index, bool p_include_internal) const {
 	ERR_THREAD_GUARD_V(nullptr);
-	_update_children_cache();
+	_update_children_cache_sparse();
 
 	if (p_include_internal) {
+		const int count = data.children_cache.size() - data.children_cache_holes.size();
 		if (p_index < 0) {
-			p_index += data.children_cache.size();
+			p_index += count;
 		}
-		ERR_FAIL_INDEX_V(p_index, (int)data.children_cache.size(), nullptr);
-		return data.children_cache[p_index];
+		ERR_FAIL_INDEX_V(p_index, count, nullptr);
+		return data.children_cache[_get_children_cache_slot(p_index)];
 	} else {
+		const uint32_t front_slots = data.internal_children_front_count_cache;
+		const int front = front_slots - _count_children_cache_holes(0, front_slots);
+		const int count = data.external_children_count_cache - _count_children_cache_holes(front_slots, front_slots + data.external_children_count_cache);
 		if (p_index < 0) {
-			p_index += (int)data.children_cache.size() - data.internal_children_front_count_cache - data.internal_children_back_count_cache;
+			p_index += count;
 		}
-		ERR_FAIL_INDEX_V(p_index, (int)data.children_cache.size() - data.internal_children_front_count_cache - data.internal_children_back_count_cache, nullptr);
-		p_index += data.internal_children_front_count_cache;
-		return data.children_cache[p_index];
+		ERR_FAIL_INDEX_V(p_index, count, nullptr);
+		return data.children_cache[_get_children_cache_slot(front + p_index)];
 	}
 }
 
@@ -1897,6 +2087,21 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 
 	ERR_FAIL_COND_V_MSG(!data.tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
 
+	// A single name is already one hash lookup, only cache deeper paths.
+	const bool cacheable = p_path.get_name_count() > 1;
+	const uint32_t generation = tree_structure_generation.get();
+	if (cacheable && data.resolved_paths_cache) {
+		if (data.resolved_paths_generation == generation) {
+			Node *const *cached = data.resolved_paths_cache->getptr(p_path);
+			if (cached) {
+				return *cached;
+			}
+		} else {
+			data.resolved_paths_cache->clear();
+			data.resolved_paths_generation = generation;
+		}
+	}
+
 	Node *current = nullptr;
 	Node *root = nullptr;
 
@@ -1948,6 +2153,17 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 		current = next;
 	}
 
+	if (cacheable && current) {
+		// Only found nodes are cached, adding nodes can't change an existing resolution.
+		if (!data.resolved_paths_cache) {
+			data.resolved_paths_cache = memnew((HashMap<NodePath, Node *>));
+			data.resolved_paths_generation = generation;
+		} else if (data.resolved_paths_cache->size() >= RESOLVED_PATHS_CACHE_MAX) {
+			data.resolved_paths_cache->clear();
+		}
+		data.resolved_paths_cache->insert(p_path, current);
+	}
+
 	return current;
 }
 
@@ -2217,6 +2433,7 @@ void Node::_release_unique_name_in_owner() {
 		return; // Ignore.
 	}
 	data.owner->data.owned_unique_nodes.erase(key);
+	_tree_structure_changed();
 }
 
 void Node::_acquire_unique_name_in_owner() {
@@ -2231,6 +2448,7 @@ void Node::_acquire_unique_name_in_owner() {
 		return;
 	}
 	data.owner->data.owned_unique_nodes[key] = this;
+	_tree_structure_changed(); // May shadow a unique name of the owner's owner.
 }
 
 void Node::set_unique_name_in_owner(bool p_enabled) {
@@ -2294,6 +2512,7 @@ void Node::_clean_up_owner() {
 	data.owner->data.owned.erase(data.OW);
 	data.owner = nullptr;
 	data.OW = nullptr;
+	_tree_structure_changed(); // Unique names are resolved through the owner.
 }
 
 Node *Node::find_common_parent_with(const Node *p_node) const {
@@ -4134,6 +4353,13 @@ Node::~Node() {
 	data.children.clear();
 	data.children_cache.clear();
 
+	if (data.serial_child_name_hints) {
+		memdelete(data.serial_child_name_hints);
+	}
+	if (data.resolved_paths_cache) {
+		memdelete(data.resolved_paths_cache);
+	}
+
 	ERR_FAIL_COND(data.parent);
 	ERR_FAIL_COND(data.children_cache.size());
 
@@ -136,6 +136,8 @@ public:
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> total_node_count;
 #endif
+	// Changes whenever a node is removed, renamed or its unique name is released, invalidating resolved paths.
+	static SafeNumeric<uint32_t> tree_structure_generation;
 	enum {
 		UNIQUE_SCENE_ID_UNASSIGNED = 0
 	};
@@ -191,6 +193,11 @@ private:
 		bool operator()(const Node *p_a, const Node *p_b) const { return p_b->data.physics_process_priority == p_a->data.physics_process_priority ? p_b->is_greater_than(p_a) : p_b->data.physics_process_priority > p_a->data.physics_process_priority; }
 	};
 
+	struct SerialChildNameHint {
+		uint32_t next = 2; // Lowest number that may still be free.
+		uint32_t count = 0; // Children named from this base by the hint, it's erased when none are left.
+	};
+
 	// This Data struct is to avoid namespace pollution in derived classes.
 	struct Data {
 		String scene_file_path;
@@ -202,6 +209,10 @@ private:
 		HashMap<StringName, Node *> children;
 		mutable bool children_cache_dirty = false;
 		mutable LocalVector<Node *> children_cache;
+		mutable LocalVector<uint32_t> children_cache_holes; // Slots of removed children still left (null) in the cache.
+		mutable bool children_cache_holes_sorted = true; // Holes are appended as children are removed, and only sorted for lookups.
+		// Per base name (including separator), where to start generating serial child names.
+		mutable HashMap<StringName, SerialChildNameHint> *serial_child_name_hints = nullptr;
 		HashMap<StringName, Node *> owned_unique_nodes;
 		bool unique_name_in_owner = false;
 		InternalMode internal_mode = INTERNAL_MODE_DISABLED;
@@ -292,6 +303,10 @@ private:
 
 		mutable NodePath *path_cache = nullptr;
 
+		// Multi-level paths resolved by get_node_or_null(), valid while the tree structure generation is unchanged.
+		mutable HashMap<NodePath, Node *> *resolved_paths_cache = nullptr;
+		mutable uint32_t resolved_paths_generation = 0;
+
 	} data;
 
 	String _get_tree_string_pretty(const String &p_prefix, bool p_last);
@@ -303,6 +318,7 @@ private:
 
 	void _validate_child_name(Node *p_child, bool p_force_human_readable = false);
 	void _generate_serial_child_name(const Node *p_child, StringName &name) const;
+	void _release_serial_child_name(const StringName &p_name) const;
 
 	void _propagate_reverse_notification(int p_notification);
 	void _propagate_deferred_notification(int p_notification, bool p_reverse);
@@ -341,13 +357,29 @@ private:
 
 	void _clean_up_owner();
 
+	_FORCE_INLINE_ static void _tree_structure_changed() { tree_structure_generation.increment(); }
+
 	_FORCE_INLINE_ void _update_children_cache() const {
-		if (unlikely(data.children_cache_dirty)) {
+		if (unlikely(data.children_cache_dirty || !data.children_cache_holes.is_empty())) {
+			_update_children_cache_impl();
+		}
+	}
+
+	// Same as above, but leaves up to about sqrt(n) holes from removed children in the cache,
+	// so queries in between removals don't compact it every time. Index lookups must go
+	// through _get_children_cache_slot() and _count_children_cache_holes() then.
+	_FORCE_INLINE_ void _update_children_cache_sparse() const {
+		const uint32_t holes = data.children_cache_holes.size();
+		if (unlikely(data.children_cache_dirty || (holes > 16 && holes * holes > data.children_cache.size()))) {
 			_update_children_cache_impl();
 		}
 	}
 
 	void _update_children_cache_impl() const;
+	void _sort_children_cache_holes() const;
+	uint32_t _count_children_cache_holes(uint32_t p_from, uint32_t p_to) const;
+	uint32_t _get_children_cache_slot(uint32_t p_index) const;
+	int _get_child_index_with_holes(const Node *p_child, bool p_include_internal) const;
 
 	// Process group management
 	void _add_process_group();
@@ -588,7 +620,10 @@ public:
 		if (!data.parent) {
 			return data.index;
 		}
-		data.parent->_update_children_cache();
+		data.parent->_update_children_cache_sparse();
+		if (unlikely(!data.parent->data.children_cache_holes.is_empty())) {
+			return data.parent->_get_child_index_with_holes(this, p_include_internal);
+		}
 
 		if (!p_include_internal) {
 			return data.index;
@@ -715,6 +715,8 @@ bool SceneTree::process(double p_time) {
 		_flush_scene_change();
 	}
 
+	_process_incremental_attachments();
+
 	process_timers(p_time, false); //go through timers
 	process_tweens(p_time, false);
 
@@ -857,6 +859,8 @@ void SceneTree::finalize() {
 		_flush_delete_queue();
 	}
 
+	_clear_incremental_attachments();
+
 	MainLoop::finalize();
 
 	// Cleanup timers.
@@ -1616,6 +1620,116 @@ void SceneTree::queue_delete(RequiredParam<Object> rp_object) {
 	delete_queue.push_back(p_object->get_instance_id());
 }
 
+void SceneTree::_detach_for_incremental_attach(Node *p_node, LocalVector<IncrementalAttach::Entry> &r_entries) {
+	// Internal children are left in place, their owners usually expect them to be there at all times.
+	const int count = p_node->get_child_count(false);
+	if (count == 0) {
+		return;
+	}
+
+	LocalVector<Node *> children;
+	children.resize(count);
+	for (int i = 0; i < count; i++) {
+		children[i] = p_node->get_child(i, false);
+	}
+	// Removing from the back keeps the children cache compact.
+	for (int i = count - 1; i >= 0; i--) {
+		p_node->remove_child(children[i]);
+	}
+
+	for (Node *child : children) {
+		r_entries.push_back({ p_node->get_instance_id(), child->get_instance_id() });
+		// Nodes with a script are attached with all their children at once, so `_ready()` still finds them.
+		if (!child->get_script_instance()) {
+			_detach_for_incremental_attach(child, r_entries);
+		}
+	}
+}
+
+void SceneTree::add_child_incremental(RequiredParam<Node> rp_parent, RequiredParam<Node> rp_node, double p_time_budget_msec) {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "Adding children incrementally is only allowed from the main thread.");
+	EXTRACT_PARAM_OR_FAIL(p_parent, rp_parent);
+	EXTRACT_PARAM_OR_FAIL(p_node, rp_node);
+	ERR_FAIL_COND_MSG(p_parent->get_tree() != this, vformat("Can't add child '%s' incrementally, parent '%s' is not inside this SceneTree.", p_node->get_name(), p_parent->get_name()));
+	ERR_FAIL_COND_MSG(p_node->get_parent(), vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_node->get_name(), p_parent->get_name(), p_node->get_parent()->get_name()));
+	ERR_FAIL_COND(p_time_budget_msec < 0.0);
+
+	IncrementalAttach attach;
+	attach.node = p_node->get_instance_id();
+	attach.time_budget_usec = p_time_budget_msec * 1000.0;
+	// Same as for descendants, a node with a script is attached with all its children, so `_ready()` still finds them.
+	if (!p_node->get_script_instance()) {
+		_detach_for_incremental_attach(p_node, attach.entries);
+	}
+
+	p_parent->add_child(p_node);
+
+	if (unlikely(p_node->get_parent() != p_parent)) {
+		// Adding failed, put the subtree back together as it was.
+		for (const IncrementalAttach::Entry &entry : attach.entries) {
+			ObjectDB::get_instance<Node>(entry.parent)->add_child(ObjectDB::get_instance<Node>(entry.child));
+		}
+		return;
+	}
+
+	// Progress is always reported from the next frame on, even if there is nothing left to attach.
+	incremental_attachments.push_back(attach);
+}
+
+void SceneTree::_process_incremental_attachments() {
+	List<IncrementalAttach>::Element *E = incremental_attachments.front();
+	while (E) {
+		List<IncrementalAttach>::Element *N = E->next();
+		IncrementalAttach &attach = E->get();
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		while (attach.attached < attach.entries.size()) {
+			const IncrementalAttach::Entry &entry = attach.entries[attach.attached++];
+			Node *child = ObjectDB::get_instance<Node>(entry.child);
+			if (!child || child->get_parent()) {
+				continue; // Freed or reparented meanwhile.
+			}
+			Node *parent = ObjectDB::get_instance<Node>(entry.parent);
+			if (parent) {
+				parent->add_child(child);
+			} else {
+				// The parent was freed, nothing else references the child anymore.
+				memdelete(child);
+			}
+			if (OS::get_singleton()->get_ticks_usec() - begin >= attach.time_budget_usec) {
+				break;
+			}
+		}
+
+		const ObjectID node_id = attach.node;
+		const int attached = attach.attached;
+		const int total = attach.entries.size();
+		if (attached == total) {
+			// Erase before emitting, as the signal may start new attachments.
+			incremental_attachments.erase(E);
+		}
+
+		Node *node = ObjectDB::get_instance<Node>(node_id);
+		if (node) {
+			emit_signal(SNAME("incremental_attach_progress"), node, attached, total);
+		}
+
+		E = N;
+	}
+}
+
+void SceneTree::_clear_incremental_attachments() {
+	for (const IncrementalAttach &attach : incremental_attachments) {
+		for (uint32_t i = attach.attached; i < attach.entries.size(); i++) {
+			Node *child = ObjectDB::get_instance<Node>(attach.entries[i].child);
+			if (child && !child->get_parent()) {
+				memdelete(child);
+			}
+		}
+	}
+	incremental_attachments.clear();
+}
+
 int SceneTree::get_node_count() const {
 	return nodes_in_tree_count;
 }
@@ -1898,6 +2012,7 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_physics_interpolation_enabled"), &SceneTree::is_physics_interpolation_enabled);
 
 	ClassDB::bind_method(D_METHOD("queue_delete", "obj"), &SceneTree::queue_delete);
+	ClassDB::bind_method(D_METHOD("add_child_incremental", "parent", "node", "time_budget_msec"), &SceneTree::add_child_incremental, DEFVAL(2.0));
 
 	MethodInfo mi;
 	mi.name = "call_group_flags";
@@ -1958,6 +2073,7 @@ void SceneTree::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("node_removed", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
 	ADD_SIGNAL(MethodInfo("node_renamed", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
 	ADD_SIGNAL(MethodInfo("node_configuration_warning_changed", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
+	ADD_SIGNAL(MethodInfo("incremental_attach_progress", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node"), PropertyInfo(Variant::INT, "attached"), PropertyInfo(Variant::INT, "total")));
 
 	ADD_SIGNAL(MethodInfo("process_frame"));
 	ADD_SIGNAL(MethodInfo("physics_frame"));
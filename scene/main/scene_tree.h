@@ -186,6 +186,19 @@ private:
 
 	List<ObjectID> delete_queue;
 
+	struct IncrementalAttach {
+		struct Entry {
+			ObjectID parent;
+			ObjectID child;
+		};
+		ObjectID node;
+		LocalVector<Entry> entries; // In tree order, so parents are attached before their children.
+		uint32_t attached = 0;
+		uint64_t time_budget_usec = 0;
+	};
+
+	List<IncrementalAttach> incremental_attachments;
+
 	uint64_t accessibility_upd_per_sec = 0;
 	bool accessibility_force_update = true;
 	HashSet<ObjectID> accessibility_change_queue;
@@ -249,6 +262,10 @@ private:
 	void _call_group(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	void _flush_delete_queue();
+
+	void _detach_for_incremental_attach(Node *p_node, LocalVector<IncrementalAttach::Entry> &r_entries);
+	void _process_incremental_attachments();
+	void _clear_incremental_attachments();
 	// Optimization.
 	friend class CanvasItem;
 	friend class Node3D;
@@ -409,6 +426,8 @@ public:
 
 	void queue_delete(RequiredParam<Object> rp_object);
 
+	void add_child_incremental(RequiredParam<Node> rp_parent, RequiredParam<Node> rp_node, double p_time_budget_msec = 2.0);
+
 	Vector<Node *> get_nodes_in_group(const StringName &p_group);
 	Node *get_first_node_in_group(const StringName &p_group);
 	bool has_group(const StringName &p_identifier) const;
@@ -35,6 +35,7 @@
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "scene/3d/visual_instance_3d.h"
 
@@ -462,7 +463,7 @@ void SceneTreeFTI::node_3d_notify_delete(Node3D *p_node) {
 #endif
 }
 
-void SceneTreeFTI::_update_dirty_nodes(Node *p_node, uint32_t p_current_half_frame, float p_interpolation_fraction, bool p_active, const Transform3D *p_parent_global_xform, int p_depth) {
+void SceneTreeFTI::_update_dirty_nodes(Node *p_node, uint32_t p_current_half_frame, bool p_active, const Transform3D *p_parent_global_xform, int p_depth, int32_t p_parent_entry) {
 	Node3D *s = Object::cast_to<Node3D>(p_node);
 
 #ifdef DEBUG_ENABLED
@@ -481,7 +482,7 @@ void SceneTreeFTI::_update_dirty_nodes(Node *p_node, uint32_t p_current_half_fra
 	// so we should still recurse to children.
 	if (!s) {
 		for (Node *node : p_node->iterate_children()) {
-			_update_dirty_nodes(node, p_current_half_frame, p_interpolation_fraction, p_active, nullptr, p_depth + 1);
+			_update_dirty_nodes(node, p_current_half_frame, p_active, nullptr, p_depth + 1);
 		}
 		return;
 	}
@@ -527,6 +528,7 @@ void SceneTreeFTI::_update_dirty_nodes(Node *p_node, uint32_t p_current_half_fra
 		s->data.fti_global_xform_interp_set = p_active;
 	}
 
+	int32_t entry_id = -1;
 	if (p_active) {
 #ifdef GODOT_SCENE_TREE_FTI_PRINT_TREE
 		bool dirty = s->_test_dirty_bits(Node3D::DIRTY_GLOBAL_INTERPOLATED_TRANSFORM);
@@ -540,49 +542,45 @@ void SceneTreeFTI::_update_dirty_nodes(Node *p_node, uint32_t p_current_half_fra
 		}
 #endif
 
-		// First calculate our local xform.
-		// This will either use interpolation, or just use the current local if not interpolated.
-		Transform3D local_interp;
-		if (s->is_physics_interpolated()) {
-			// There may be no need to interpolate if the node has not been moved recently
-			// and is therefore not on the tick list...
-			if (s->data.fti_on_tick_xform_list) {
-				// Make sure to call `get_transform()` rather than using local_transform directly, because
-				// local_transform may be dirty and need updating from rotation / scale.
-				TransformInterpolator::interpolate_transform_3d(s->data.local_transform_prev, s->get_transform(), local_interp, p_interpolation_fraction);
-			} else {
-				local_interp = s->get_transform();
-			}
-		} else {
-			local_interp = s->get_transform();
-		}
+		// Only gather the local xforms here, interpolation and concatenation
+		// of the parent xforms are done as a batch in `_update_gathered_nodes()`.
+		UpdateEntry entry;
+		entry.node = s;
 
-		// Concatenate parent xform.
 		if (!s->is_set_as_top_level()) {
-			if (p_parent_global_xform) {
-				s->data.global_transform_interpolated = s->data.fti_is_identity_xform ? *p_parent_global_xform : ((*p_parent_global_xform) * local_interp);
+			if (p_parent_entry != -1) {
+				entry.parent_entry = p_parent_entry;
+			} else if (p_parent_global_xform) {
+				entry.parent_global_xform = p_parent_global_xform;
 			} else {
-				const Node3D *parent = s->get_parent_node_3d();
+				Node3D *parent = s->get_parent_node_3d();
 
 				if (parent) {
-					const Transform3D &parent_glob = parent->data.fti_global_xform_interp_set ? parent->data.global_transform_interpolated : parent->get_global_transform();
-					s->data.global_transform_interpolated = s->data.fti_is_identity_xform ? parent_glob : parent_glob * local_interp;
-				} else {
-					s->data.global_transform_interpolated = local_interp;
+					if (parent->data.fti_global_xform_interp_set) {
+						entry.parent_global_xform = &parent->data.global_transform_interpolated;
+					} else {
+						if (parent->_test_dirty_bits(Node3D::DIRTY_GLOBAL_TRANSFORM)) {
+							_ALLOW_DISCARD_ parent->get_global_transform();
+						}
+						entry.parent_global_xform = &parent->data.global_transform;
+					}
 				}
 			}
-		} else {
-			s->data.global_transform_interpolated = local_interp;
 		}
 
-		// Watch for this, disable_scale can cause incredibly confusing bugs
-		// and must be checked for when calculating global xforms.
-		if (s->data.disable_scale) {
-			s->data.global_transform_interpolated.basis.orthonormalize();
-		}
+		entry_id = data.update_entries.size();
+		data.update_entries.push_back(entry);
+
+		// Make sure to call `get_transform()` rather than using local_transform directly, because
+		// local_transform may be dirty and need updating from rotation / scale.
+		data.update_local_xforms.push_back(s->get_transform());
 
-		// Upload to RenderingServer the interpolated global xform.
-		s->fti_update_servers_xform();
+		// There may be no need to interpolate if the node has not been moved recently
+		// and is therefore not on the tick list...
+		if (s->is_physics_interpolated() && s->data.fti_on_tick_xform_list) {
+			data.interpolate_prev_xforms.push_back(s->data.local_transform_prev);
+			data.interpolate_entries.push_back(entry_id);
+		}
 
 		// Ensure branches are only processed once on each traversal.
 		s->data.fti_processed = true;
@@ -596,9 +594,96 @@ void SceneTreeFTI::_update_dirty_nodes(Node *p_node, uint32_t p_current_half_fra
 	s->_clear_dirty_bits(Node3D::DIRTY_GLOBAL_INTERPOLATED_TRANSFORM);
 
 	// Recurse to children.
+	// If our interpolated xform is used and is part of this batch, the children must refer to our entry.
+	int32_t children_parent_entry = s->data.fti_global_xform_interp_set ? entry_id : -1;
 	for (Node *node : p_node->iterate_children()) {
-		_update_dirty_nodes(node, p_current_half_frame, p_interpolation_fraction, p_active, s->data.fti_global_xform_interp_set ? &s->data.global_transform_interpolated : &s->data.global_transform, p_depth + 1);
+		_update_dirty_nodes(node, p_current_half_frame, p_active, s->data.fti_global_xform_interp_set ? &s->data.global_transform_interpolated : &s->data.global_transform, p_depth + 1, children_parent_entry);
+	}
+}
+
+void SceneTreeFTI::_interpolate_xforms_threaded(uint32_t p_chunk, float p_interpolation_fraction) {
+	uint32_t from = p_chunk * data.interpolate_threaded_chunk_size;
+	uint32_t to = MIN(from + data.interpolate_threaded_chunk_size, data.interpolate_entries.size());
+
+	for (uint32_t n = from; n < to; n++) {
+		Transform3D &local = data.update_local_xforms[data.interpolate_entries[n]];
+		Transform3D curr = local;
+		TransformInterpolator::interpolate_transform_3d(data.interpolate_prev_xforms[n], curr, local, p_interpolation_fraction);
+	}
+}
+
+void SceneTreeFTI::_update_gathered_nodes(float p_interpolation_fraction) {
+	// Interpolating is independent for each node, and the most expensive part,
+	// so for large batches it is spread over the worker threads.
+	uint32_t num_interpolated = data.interpolate_entries.size();
+	if (num_interpolated >= data.interpolate_threaded_min) {
+		uint32_t num_chunks = Math::division_round_up(num_interpolated, data.interpolate_threaded_chunk_size);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTreeFTI::_interpolate_xforms_threaded, p_interpolation_fraction, num_chunks, -1, true, SNAME("SceneTreeFTIInterpolate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t n = 0; n < num_interpolated; n++) {
+			Transform3D &local = data.update_local_xforms[data.interpolate_entries[n]];
+			Transform3D curr = local;
+			TransformInterpolator::interpolate_transform_3d(data.interpolate_prev_xforms[n], curr, local, p_interpolation_fraction);
+		}
+	}
+
+	// Concatenate parent xforms, parents always come before their children.
+	for (uint32_t n = 0; n < data.update_entries.size(); n++) {
+		const UpdateEntry &entry = data.update_entries[n];
+		Node3D *s = entry.node;
+		const Transform3D &local_interp = data.update_local_xforms[n];
+
+		const Transform3D *parent_glob = entry.parent_entry != -1 ? &data.update_entries[entry.parent_entry].node->data.global_transform_interpolated : entry.parent_global_xform;
+		if (parent_glob) {
+			s->data.global_transform_interpolated = s->data.fti_is_identity_xform ? *parent_glob : ((*parent_glob) * local_interp);
+		} else {
+			s->data.global_transform_interpolated = local_interp;
+		}
+
+		// Watch for this, disable_scale can cause incredibly confusing bugs
+		// and must be checked for when calculating global xforms.
+		if (s->data.disable_scale) {
+			s->data.global_transform_interpolated.basis.orthonormalize();
+		}
 	}
+
+	// Upload to RenderingServer the interpolated global xforms.
+	// Visual instances are sent in a single batch, other nodes update the servers themselves.
+	Vector<RID> batch_instances;
+	Vector<Transform3D> batch_xforms;
+	batch_instances.resize(data.update_entries.size());
+	batch_xforms.resize(data.update_entries.size());
+	RID *batch_instances_w = batch_instances.ptrw();
+	Transform3D *batch_xforms_w = batch_xforms.ptrw();
+	uint32_t batch_size = 0;
+
+	for (uint32_t n = 0; n < data.update_entries.size(); n++) {
+		Node3D *s = data.update_entries[n].node;
+		VisualInstance3D *vi = Object::cast_to<VisualInstance3D>(s);
+
+		// Equivalent to `VisualInstance3D::fti_update_servers_xform()`.
+		if (vi) {
+			if (!s->_is_using_identity_transform()) {
+				batch_instances_w[batch_size] = vi->get_instance();
+				batch_xforms_w[batch_size] = s->data.global_transform_interpolated;
+				batch_size++;
+			}
+		} else {
+			s->fti_update_servers_xform();
+		}
+	}
+
+	if (batch_size) {
+		batch_instances.resize(batch_size);
+		batch_xforms.resize(batch_size);
+		RS::get_singleton()->instances_set_transforms(batch_instances, batch_xforms);
+	}
+
+	data.update_entries.clear();
+	data.update_local_xforms.clear();
+	data.interpolate_prev_xforms.clear();
+	data.interpolate_entries.clear();
 }
 
 void SceneTreeFTI::frame_update(Node *p_root, bool p_frame_start) {
@@ -664,7 +749,7 @@ void SceneTreeFTI::frame_update(Node *p_root, bool p_frame_start) {
 		// Reference approach.
 		// Traverse the entire scene tree.
 		// Slow, but robust.
-		_update_dirty_nodes(p_root, half_frame, interpolation_fraction, false);
+		_update_dirty_nodes(p_root, half_frame, false);
 	} else {
 		// Optimized approach.
 		// Traverse from depth lists.
@@ -709,13 +794,15 @@ void SceneTreeFTI::frame_update(Node *p_root, bool p_frame_start) {
 					continue;
 				}
 
-				_update_dirty_nodes(s, half_frame, interpolation_fraction, true);
+				_update_dirty_nodes(s, half_frame, true);
 			}
 		}
 
 		_clear_depth_lists();
 	}
 
+	_update_gathered_nodes(interpolation_fraction);
+
 	if (print_debug_stats) {
 		uint64_t after = OS::get_singleton()->get_ticks_usec();
 		print_line(String(data.use_optimized_traversal_method ? "FTI optimized" : "FTI reference") + " nodes traversed : " + itos(data.debug_node_count) + (skipped == 0 ? "" : ", skipped " + itos(skipped)) + ", processed : " + itos(data.debug_nodes_processed) + ", took " + itos(after - before) + " usec " + (data.frame_start ? "(start)" : "(end)"));
@@ -30,12 +30,12 @@
 
 #pragma once
 
+#include "core/math/transform_3d.h"
 #include "core/os/mutex.h"
 #include "core/templates/local_vector.h"
 
 class Node3D;
 class Node;
-struct Transform3D;
 class SceneTreeFTITests;
 
 #ifdef DEV_ENABLED
@@ -76,9 +76,24 @@ class SceneTreeFTI {
 		TM_DEBUG,
 	};
 
+	// A node found active by the traversal, whose interpolated global xform is updated in a batch.
+	struct UpdateEntry {
+		Node3D *node = nullptr;
+
+		// The parent global xform, when the parent is not updated in the same batch.
+		const Transform3D *parent_global_xform = nullptr;
+
+		// Otherwise the index of the parent entry, which always comes first.
+		int32_t parent_entry = -1;
+	};
+
 	struct Data {
 		static const uint32_t scene_tree_depth_limit = 48;
 
+		// Below this number of xforms to interpolate, it is not worth using worker threads.
+		static const uint32_t interpolate_threaded_min = 512;
+		static const uint32_t interpolate_threaded_chunk_size = 64;
+
 		// Prev / Curr lists of Node3Ds having local xforms pumped.
 		LocalVector<Node3D *> tick_xform_list[2];
 
@@ -94,6 +109,16 @@ class SceneTreeFTI {
 		LocalVector<Node3D *> request_reset_list;
 		LocalVector<Node3D *> dirty_node_depth_lists[scene_tree_depth_limit];
 
+		// Batch gathered by the traversal, in tree order.
+		LocalVector<UpdateEntry> update_entries;
+
+		// Local xform of each entry, replaced by the interpolated local xform.
+		LocalVector<Transform3D> update_local_xforms;
+
+		// Contiguous previous xforms (and their entries) of the entries needing interpolation.
+		LocalVector<Transform3D> interpolate_prev_xforms;
+		LocalVector<uint32_t> interpolate_entries;
+
 		// When we are using two alternating lists,
 		// which one is current.
 		uint32_t mirror = 0;
@@ -123,7 +148,9 @@ class SceneTreeFTI {
 	SceneTreeFTITests *_tests = nullptr;
 #endif
 
-	void _update_dirty_nodes(Node *p_node, uint32_t p_current_half_frame, float p_interpolation_fraction, bool p_active, const Transform3D *p_parent_global_xform = nullptr, int p_depth = 0);
+	void _update_dirty_nodes(Node *p_node, uint32_t p_current_half_frame, bool p_active, const Transform3D *p_parent_global_xform = nullptr, int p_depth = 0, int32_t p_parent_entry = -1);
+	void _update_gathered_nodes(float p_interpolation_fraction);
+	void _interpolate_xforms_threaded(uint32_t p_chunk, float p_interpolation_fraction);
 	void _update_request_resets();
 
 	void _reset_flags(Node *p_node);
@@ -155,6 +155,7 @@ public:
 	virtual Dictionary get_tags() const override;
 
 	virtual double get_length() const override; //if supported, otherwise return 0
+	virtual uint64_t get_estimated_memory_usage() const override { return data_bytes; }
 
 	virtual bool is_monophonic() const override;
 
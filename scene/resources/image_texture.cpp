@@ -135,6 +135,13 @@ RID ImageTexture::get_rid() const {
 	return texture;
 }
 
+uint64_t ImageTexture::get_estimated_memory_usage() const {
+	if (w == 0 || h == 0) {
+		return 0;
+	}
+	return Image::get_image_data_size(w, h, format, mipmaps);
+}
+
 bool ImageTexture::has_alpha() const {
 	return (format == Image::FORMAT_LA8 || format == Image::FORMAT_RGBA8);
 }
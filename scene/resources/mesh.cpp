@@ -2009,6 +2009,20 @@ RID ArrayMesh::get_rid() const {
 	return mesh;
 }
 
+uint64_t ArrayMesh::get_estimated_memory_usage() const {
+	const RenderingServer *rs = RenderingServer::get_singleton();
+	uint64_t size = 0;
+	for (const Surface &surface : surfaces) {
+		uint64_t vertex_stride = rs->mesh_surface_get_format_vertex_stride(surface.format, surface.array_length);
+		vertex_stride += rs->mesh_surface_get_format_normal_tangent_stride(surface.format, surface.array_length);
+		vertex_stride += rs->mesh_surface_get_format_attribute_stride(surface.format, surface.array_length);
+		vertex_stride += rs->mesh_surface_get_format_skin_stride(surface.format, surface.array_length);
+		size += vertex_stride * surface.array_length;
+		size += uint64_t(rs->mesh_surface_get_format_index_stride(surface.format, surface.array_length)) * surface.index_array_length;
+	}
+	return size;
+}
+
 AABB ArrayMesh::get_aabb() const {
 	return aabb;
 }
@@ -127,6 +127,7 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query);
+	Dictionary _intersect_rays(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
 	TypedArray<Dictionary> _intersect_point(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
@@ -163,6 +164,10 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Casts `p_ray_count` rays sharing the filters in `p_parameters` (its `from` and `to` are ignored).
+	// Writes one result per ray and whether it hit to `r_hits`, and returns the amount of rays that hit.
+	// The default implementation calls `intersect_ray()` for each ray; servers can override it to batch the work.
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits);
 
 	struct ShapeResult {
 		RID rid;
@@ -572,6 +577,12 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) = 0;
 
+	// Between these calls, body_test_motion() can be called from several WorkerThreadPool tasks at once, started by the
+	// calling thread while it waits for them. Nothing else may change the server meanwhile. Returns false when the server
+	// doesn't support it, motion tests must then stay on the calling thread.
+	virtual bool begin_parallel_motion_tests() { return false; }
+	virtual void end_parallel_motion_tests() {}
+
 	/* SOFT BODY */
 
 	virtual RID soft_body_create() = 0;
@@ -117,6 +117,12 @@ class PhysicsDirectSpaceState3DDummy : public PhysicsDirectSpaceState3D {
 
 public:
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override { return false; }
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) override {
+		for (int i = 0; i < p_ray_count; i++) {
+			r_hits[i] = false;
+		}
+		return 0;
+	}
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override { return 0; }
 
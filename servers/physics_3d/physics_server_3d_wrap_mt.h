@@ -65,6 +65,7 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	WorkerThreadPool::TaskID server_task_id = WorkerThreadPool::INVALID_TASK_ID;
 	bool exit = false;
 	bool create_thread = false;
+	bool parallel_motion_tests = false;
 	SafeFlag doing_sync;
 
 	void _assign_mt_ids(WorkerThreadPool::TaskID p_pump_task_id);
@@ -272,10 +273,22 @@ public:
 	FUNC2(body_set_ray_pickable, RID, bool);
 
 	bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) override {
-		ERR_FAIL_COND_V(!Thread::is_main_thread(), false);
+		ERR_FAIL_COND_V(!Thread::is_main_thread() && !parallel_motion_tests, false);
 		return physics_server_3d->body_test_motion(p_body, p_parameters, r_result);
 	}
 
+	bool begin_parallel_motion_tests() override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), false);
+		parallel_motion_tests = physics_server_3d->begin_parallel_motion_tests();
+		return parallel_motion_tests;
+	}
+
+	void end_parallel_motion_tests() override {
+		ERR_FAIL_COND(!Thread::is_main_thread());
+		parallel_motion_tests = false;
+		physics_server_3d->end_parallel_motion_tests();
+	}
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), nullptr);
@@ -915,30 +915,39 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
 
-	if (instance->layer_mask == p_mask) {
+	_instance_set_layer_mask(instance, p_mask, nullptr);
+}
+
+void RendererSceneCull::_instance_set_layer_mask(Instance *p_instance, uint32_t p_mask, HashSet<Instance *> *r_shadow_dirty_lights) {
+	if (p_instance->layer_mask == p_mask) {
 		return;
 	}
 
 	// Particles always need to be unpaired. Geometry may need to be unpaired, but only if lights or decals use pairing.
 	// Needs to happen before layer mask changes so we can avoid attempting to unpair something that was never paired.
-	if (instance->base_type == RS::INSTANCE_PARTICLES ||
-			(((geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT)) || (geometry_instance_pair_mask & (1 << RS::INSTANCE_DECAL))) && ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK))) {
-		_unpair_instance(instance);
-		singleton->_instance_queue_update(instance, false, false);
+	if (p_instance->base_type == RS::INSTANCE_PARTICLES ||
+			(((geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT)) || (geometry_instance_pair_mask & (1 << RS::INSTANCE_DECAL))) && ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK))) {
+		_unpair_instance(p_instance);
+		singleton->_instance_queue_update(p_instance, false, false);
 	}
 
-	instance->layer_mask = p_mask;
-	if (instance->scenario && instance->array_index >= 0) {
-		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+	p_instance->layer_mask = p_mask;
+	if (p_instance->scenario && p_instance->array_index >= 0) {
+		p_instance->scenario->instance_data[p_instance->array_index].layer_mask = p_mask;
 	}
 
-	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
-		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && p_instance->base_data) {
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
 		ERR_FAIL_NULL(geom->geometry_instance);
 		geom->geometry_instance->set_layer_mask(p_mask);
 
 		if (geom->can_cast_shadows) {
 			for (HashSet<RendererSceneCull::Instance *>::Iterator I = geom->lights.begin(); I != geom->lights.end(); ++I) {
+				if (r_shadow_dirty_lights) {
+					// Batched, lights shared by the instances are made dirty once afterwards.
+					r_shadow_dirty_lights->insert(*I);
+					continue;
+				}
 				InstanceLightData *light = static_cast<InstanceLightData *>((*I)->base_data);
 				light->make_shadow_dirty();
 			}
@@ -976,11 +985,8 @@ void RendererSceneCull::instance_geometry_set_transparency(RID p_instance, float
 	}
 }
 
-void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
-	Instance *instance = instance_owner.get_or_null(p_instance);
-	ERR_FAIL_NULL(instance);
-
-	if (instance->transform == p_transform) {
+void RendererSceneCull::_instance_set_transform(Instance *p_instance, const Transform3D &p_transform) {
+	if (p_instance->transform == p_transform) {
 		return; // Must be checked to avoid worst evil.
 	}
 
@@ -992,8 +998,15 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
+}
+
+void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_NULL(instance);
+
+	_instance_set_transform(instance, p_transform);
 }
 
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
@@ -1038,44 +1051,51 @@ void RendererSceneCull::instance_set_visible(RID p_instance, bool p_visible) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
 
-	if (instance->visible == p_visible) {
+	_instance_set_visible(instance, p_visible, nullptr);
+}
+
+void RendererSceneCull::_instance_set_visible(Instance *p_instance, bool p_visible, HashSet<RID> *r_hidden_dynamic_lights) {
+	if (p_instance->visible == p_visible) {
 		return;
 	}
 
-	instance->visible = p_visible;
+	p_instance->visible = p_visible;
 
 	if (p_visible) {
-		if (instance->scenario != nullptr) {
-			_instance_queue_update(instance, true, false);
+		if (p_instance->scenario != nullptr) {
+			_instance_queue_update(p_instance, true, false);
 		}
-	} else if (instance->indexer_id.is_valid()) {
-		_unpair_instance(instance);
+	} else if (p_instance->indexer_id.is_valid()) {
+		_unpair_instance(p_instance);
 	}
 
-	if (instance->base_type == RS::INSTANCE_LIGHT) {
-		InstanceLightData *light = static_cast<InstanceLightData *>(instance->base_data);
-		if (instance->scenario && RSG::light_storage->light_get_type(instance->base) != RS::LIGHT_DIRECTIONAL && light->bake_mode == RS::LIGHT_BAKE_DYNAMIC) {
+	if (p_instance->base_type == RS::INSTANCE_LIGHT) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
+		if (p_instance->scenario && RSG::light_storage->light_get_type(p_instance->base) != RS::LIGHT_DIRECTIONAL && light->bake_mode == RS::LIGHT_BAKE_DYNAMIC) {
 			if (p_visible) {
-				instance->scenario->dynamic_lights.push_back(light->instance);
+				p_instance->scenario->dynamic_lights.push_back(light->instance);
+			} else if (r_hidden_dynamic_lights) {
+				// Batched, removed from the scenario in a single pass afterwards.
+				r_hidden_dynamic_lights->insert(light->instance);
 			} else {
-				instance->scenario->dynamic_lights.erase(light->instance);
+				p_instance->scenario->dynamic_lights.erase(light->instance);
 			}
 		}
 	}
 
-	if (instance->base_type == RS::INSTANCE_PARTICLES_COLLISION) {
-		InstanceParticlesCollisionData *collision = static_cast<InstanceParticlesCollisionData *>(instance->base_data);
+	if (p_instance->base_type == RS::INSTANCE_PARTICLES_COLLISION) {
+		InstanceParticlesCollisionData *collision = static_cast<InstanceParticlesCollisionData *>(p_instance->base_data);
 		RSG::particles_storage->particles_collision_instance_set_active(collision->instance, p_visible);
 	}
 
-	if (instance->base_type == RS::INSTANCE_FOG_VOLUME) {
-		InstanceFogVolumeData *volume = static_cast<InstanceFogVolumeData *>(instance->base_data);
+	if (p_instance->base_type == RS::INSTANCE_FOG_VOLUME) {
+		InstanceFogVolumeData *volume = static_cast<InstanceFogVolumeData *>(p_instance->base_data);
 		scene_render->fog_volume_instance_set_active(volume->instance, p_visible);
 	}
 
-	if (instance->base_type == RS::INSTANCE_OCCLUDER) {
-		if (instance->scenario) {
-			RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(instance->scenario->self, p_instance, instance->base, instance->transform, p_visible);
+	if (p_instance->base_type == RS::INSTANCE_OCCLUDER) {
+		if (p_instance->scenario) {
+			RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(p_instance->scenario->self, p_instance->self, p_instance->base, p_instance->transform, p_visible);
 		}
 	}
 }
@@ -1159,6 +1179,65 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 	}
 }
 
+void RendererSceneCull::instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_transform(instance, transforms[i]);
+	}
+}
+
+void RendererSceneCull::instances_set_visible(const Vector<RID> &p_instances, bool p_visible) {
+	HashSet<RID> hidden_dynamic_lights;
+	HashSet<Scenario *> scenarios;
+
+	for (const RID &rid : p_instances) {
+		Instance *instance = instance_owner.get_or_null(rid);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_visible(instance, p_visible, &hidden_dynamic_lights);
+		if (instance->scenario) {
+			scenarios.insert(instance->scenario);
+		}
+	}
+
+	if (hidden_dynamic_lights.is_empty()) {
+		return;
+	}
+
+	// Erasing each hidden light from the dynamic lights is quadratic when hiding many lights.
+	for (Scenario *scenario : scenarios) {
+		uint32_t to = 0;
+		for (uint32_t from = 0; from < scenario->dynamic_lights.size(); from++) {
+			if (!hidden_dynamic_lights.has(scenario->dynamic_lights[from])) {
+				scenario->dynamic_lights[to++] = scenario->dynamic_lights[from];
+			}
+		}
+		scenario->dynamic_lights.resize(to);
+	}
+}
+
+void RendererSceneCull::instances_set_layer_mask(const Vector<RID> &p_instances, uint32_t p_mask) {
+	HashSet<Instance *> shadow_dirty_lights;
+
+	for (const RID &rid : p_instances) {
+		Instance *instance = instance_owner.get_or_null(rid);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_layer_mask(instance, p_mask, &shadow_dirty_lights);
+	}
+
+	for (Instance *light_instance : shadow_dirty_lights) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(light_instance->base_data);
+		light->make_shadow_dirty();
+	}
+}
+
 Vector<ObjectID> RendererSceneCull::instances_cull_aabb(const AABB &p_aabb, RID p_scenario) const {
 	Vector<ObjectID> instances;
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
@@ -1561,6 +1640,19 @@ void RendererSceneCull::instance_geometry_set_shader_parameter(RID p_instance, c
 	instance->instance_uniforms.set(instance->self, p_parameter, p_value);
 }
 
+void RendererSceneCull::instances_geometry_set_shader_parameter(const Vector<RID> &p_instances, const StringName &p_parameter, const Vector<Variant> &p_values) {
+	ERR_FAIL_COND(p_instances.size() != p_values.size());
+
+	const RID *instances = p_instances.ptr();
+	const Variant *values = p_values.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		instance->instance_uniforms.set(instance->self, p_parameter, values[i]);
+	}
+}
+
 Variant RendererSceneCull::instance_geometry_get_shader_parameter(RID p_instance, const StringName &p_parameter) const {
 	const Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL_V(instance, Variant());
@@ -1017,6 +1017,13 @@ public:
 	LocalVector<Vector2> camera_jitter_array;
 	RenderingLightCuller *light_culler = nullptr;
 
+private:
+	// Per-instance parts of the setters below, shared with their batch versions.
+	void _instance_set_layer_mask(Instance *p_instance, uint32_t p_mask, HashSet<Instance *> *r_shadow_dirty_lights);
+	void _instance_set_transform(Instance *p_instance, const Transform3D &p_transform);
+	void _instance_set_visible(Instance *p_instance, bool p_visible, HashSet<RID> *r_hidden_dynamic_lights);
+
+public:
 	virtual RID instance_allocate();
 	virtual void instance_initialize(RID p_rid);
 
@@ -1043,6 +1050,10 @@ public:
 
 	virtual void instance_set_ignore_culling(RID p_instance, bool p_enabled);
 
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
+	virtual void instances_set_visible(const Vector<RID> &p_instances, bool p_visible);
+	virtual void instances_set_layer_mask(const Vector<RID> &p_instances, uint32_t p_mask);
+
 	bool _update_instance_visibility_depth(Instance *p_instance);
 	void _update_instance_visibility_dependencies(Instance *p_instance) const;
 
@@ -1065,6 +1076,7 @@ public:
 	virtual void instance_geometry_get_shader_parameter_list(RID p_instance, List<PropertyInfo> *p_parameters) const;
 	virtual Variant instance_geometry_get_shader_parameter(RID p_instance, const StringName &p_parameter) const;
 	virtual Variant instance_geometry_get_shader_parameter_default_value(RID p_instance, const StringName &p_parameter) const;
+	virtual void instances_geometry_set_shader_parameter(const Vector<RID> &p_instances, const StringName &p_parameter, const Vector<Variant> &p_values);
 
 	virtual void mesh_generate_pipelines(RID p_mesh, bool p_background_compilation);
 	virtual uint32_t get_pipeline_compilations(RS::PipelineSource p_source);
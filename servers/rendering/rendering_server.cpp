@@ -102,6 +102,56 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+static Vector<RID> to_rid_vector(const TypedArray<RID> &p_rids) {
+	Vector<RID> rids;
+	rids.resize(p_rids.size());
+	RID *w = rids.ptrw();
+	for (int i = 0; i < p_rids.size(); ++i) {
+		w[i] = p_rids[i];
+	}
+	return rids;
+}
+
+void RenderingServer::_instances_set_transforms_bind(const TypedArray<RID> &p_instances, const Vector<float> &p_transforms) {
+	ERR_FAIL_COND_MSG(p_transforms.size() != p_instances.size() * 12, "The transforms buffer must contain 12 floats per instance.");
+
+	Vector<Transform3D> transforms;
+	transforms.resize(p_instances.size());
+	Transform3D *w = transforms.ptrw();
+	const float *r = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); ++i) {
+		// Same row-major layout as the MultiMesh buffer.
+		const float *data = &r[i * 12];
+		w[i].basis.rows[0] = Vector3(data[0], data[1], data[2]);
+		w[i].basis.rows[1] = Vector3(data[4], data[5], data[6]);
+		w[i].basis.rows[2] = Vector3(data[8], data[9], data[10]);
+		w[i].origin = Vector3(data[3], data[7], data[11]);
+	}
+
+	instances_set_transforms(to_rid_vector(p_instances), transforms);
+}
+
+void RenderingServer::_instances_set_visible_bind(const TypedArray<RID> &p_instances, bool p_visible) {
+	instances_set_visible(to_rid_vector(p_instances), p_visible);
+}
+
+void RenderingServer::_instances_set_layer_mask_bind(const TypedArray<RID> &p_instances, uint32_t p_mask) {
+	instances_set_layer_mask(to_rid_vector(p_instances), p_mask);
+}
+
+void RenderingServer::_instances_geometry_set_shader_parameter_bind(const TypedArray<RID> &p_instances, const StringName &p_parameter, const Array &p_values) {
+	ERR_FAIL_COND_MSG(p_values.size() != p_instances.size(), "There must be one value per instance.");
+
+	Vector<Variant> values;
+	values.resize(p_values.size());
+	Variant *w = values.ptrw();
+	for (int i = 0; i < p_values.size(); ++i) {
+		w[i] = p_values[i];
+	}
+
+	instances_geometry_set_shader_parameter(to_rid_vector(p_instances), p_parameter, values);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -3275,6 +3325,11 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_geometry_get_shader_parameter_default_value", "instance", "parameter"), &RenderingServer::instance_geometry_get_shader_parameter_default_value);
 	ClassDB::bind_method(D_METHOD("instance_geometry_get_shader_parameter_list", "instance"), &RenderingServer::_instance_geometry_get_shader_parameter_list);
 
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &RenderingServer::_instances_set_transforms_bind);
+	ClassDB::bind_method(D_METHOD("instances_set_visible", "instances", "visible"), &RenderingServer::_instances_set_visible_bind);
+	ClassDB::bind_method(D_METHOD("instances_set_layer_mask", "instances", "mask"), &RenderingServer::_instances_set_layer_mask_bind);
+	ClassDB::bind_method(D_METHOD("instances_geometry_set_shader_parameter", "instances", "parameter", "values"), &RenderingServer::_instances_geometry_set_shader_parameter_bind);
+
 	ClassDB::bind_method(D_METHOD("instances_cull_aabb", "aabb", "scenario"), &RenderingServer::_instances_cull_aabb_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_ray", "from", "to", "scenario"), &RenderingServer::_instances_cull_ray_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_convex", "convex", "scenario"), &RenderingServer::_instances_cull_convex_bind, DEFVAL(RID()));
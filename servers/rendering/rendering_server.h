@@ -1474,6 +1474,15 @@ public:
 
 	virtual void instance_set_ignore_culling(RID p_instance, bool p_enabled) = 0;
 
+	// Batch versions of the above, to avoid paying the per-call overhead for many instances.
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) = 0;
+	virtual void instances_set_visible(const Vector<RID> &p_instances, bool p_visible) = 0;
+	virtual void instances_set_layer_mask(const Vector<RID> &p_instances, uint32_t p_mask) = 0;
+
+	void _instances_set_transforms_bind(const TypedArray<RID> &p_instances, const Vector<float> &p_transforms);
+	void _instances_set_visible_bind(const TypedArray<RID> &p_instances, bool p_visible);
+	void _instances_set_layer_mask_bind(const TypedArray<RID> &p_instances, uint32_t p_mask);
+
 	// Don't use these in a game!
 	virtual Vector<ObjectID> instances_cull_aabb(const AABB &p_aabb, RID p_scenario = RID()) const = 0;
 	virtual Vector<ObjectID> instances_cull_ray(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const = 0;
@@ -1518,6 +1527,9 @@ public:
 	virtual Variant instance_geometry_get_shader_parameter_default_value(RID p_instance, const StringName &) const = 0;
 	virtual void instance_geometry_get_shader_parameter_list(RID p_instance, List<PropertyInfo> *p_parameters) const = 0;
 
+	virtual void instances_geometry_set_shader_parameter(const Vector<RID> &p_instances, const StringName &p_parameter, const Vector<Variant> &p_values) = 0;
+	void _instances_geometry_set_shader_parameter_bind(const TypedArray<RID> &p_instances, const StringName &p_parameter, const Array &p_values);
+
 	/* Bake 3D objects */
 
 	enum BakeChannels {
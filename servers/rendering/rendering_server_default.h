@@ -917,6 +917,10 @@ public:
 
 	FUNC2(instance_set_ignore_culling, RID, bool)
 
+	FUNC2(instances_set_transforms, const Vector<RID> &, const Vector<Transform3D> &)
+	FUNC2(instances_set_visible, const Vector<RID> &, bool)
+	FUNC2(instances_set_layer_mask, const Vector<RID> &, uint32_t)
+
 	// don't use these in a game!
 	FUNC2RC(Vector<ObjectID>, instances_cull_aabb, const AABB &, RID)
 	FUNC3RC(Vector<ObjectID>, instances_cull_ray, const Vector3 &, const Vector3 &, RID)
@@ -935,6 +939,7 @@ public:
 	FUNC2RC(Variant, instance_geometry_get_shader_parameter, RID, const StringName &)
 	FUNC2RC(Variant, instance_geometry_get_shader_parameter_default_value, RID, const StringName &)
 	FUNC2C(instance_geometry_get_shader_parameter_list, RID, List<PropertyInfo> *)
+	FUNC3(instances_geometry_set_shader_parameter, const Vector<RID> &, const StringName &, const Vector<Variant> &)
 
 	FUNC3R(TypedArray<Image>, bake_render_uv2, RID, const TypedArray<RID> &, const Size2i &)
 
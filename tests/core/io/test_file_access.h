@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/file_io_queue.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -248,4 +249,70 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Memory mapped read") {
+	const String file_path = TestUtils::get_data_path("testdata.csv");
+	Error err = OK;
+	Ref<FileAccess> mapped = FileAccess::open_mapped(file_path, &err);
+	if (err == ERR_UNAVAILABLE) {
+		return; // The platform can't map files.
+	}
+	REQUIRE(mapped.is_valid());
+
+	const Vector<uint8_t> reference = FileAccess::get_file_as_bytes(file_path);
+	CHECK(mapped->get_length() == (uint64_t)reference.size());
+
+	const Span<uint8_t> span = mapped->get_mapped_span();
+	REQUIRE(span.size() == (uint64_t)reference.size());
+	CHECK(memcmp(span.ptr(), reference.ptr(), reference.size()) == 0);
+
+	// Zero-copy reads point into the span and advance the position.
+	mapped->seek(4);
+	const uint8_t *ptr = mapped->get_buffer_mapped(8);
+	CHECK(ptr == span.ptr() + 4);
+	CHECK(mapped->get_position() == 12);
+	CHECK(mapped->get_buffer_mapped(reference.size()) == nullptr);
+	CHECK(mapped->get_position() == 12);
+
+	// Regular reads behave like any other file.
+	mapped->seek(0);
+	CHECK(mapped->get_buffer(reference.size() * 2) == reference);
+	CHECK(mapped->eof_reached());
+
+	ERR_PRINT_OFF;
+	CHECK_FALSE(mapped->store_8(0));
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[FileAccess] Batched reads through FileIOQueue") {
+	FileIOQueue *queue = FileIOQueue::get_singleton();
+	REQUIRE(queue != nullptr);
+
+	const String file_path = TestUtils::get_data_path("testdata.csv");
+	const Vector<uint8_t> reference = FileAccess::get_file_as_bytes(file_path);
+	REQUIRE(reference.size() > 16);
+
+	const FileIOQueue::RequestID whole = queue->request_read(file_path);
+	const FileIOQueue::RequestID slice = queue->request_read(file_path, 4, 8, FileIOQueue::PRIORITY_HIGH);
+	const FileIOQueue::RequestID past_end = queue->request_read(file_path, reference.size() - 2, 16);
+	const FileIOQueue::RequestID missing = queue->request_read(file_path + ".missing");
+	queue->request_prefetch(file_path);
+
+	Vector<uint8_t> data;
+	CHECK(queue->wait(whole, &data) == OK);
+	CHECK(data == reference);
+
+	CHECK(queue->wait(slice, &data) == OK);
+	CHECK(data == reference.slice(4, 12));
+
+	// Reads past the end of the file are truncated.
+	CHECK(queue->wait(past_end, &data) == OK);
+	CHECK(data == reference.slice(reference.size() - 2));
+
+	CHECK(queue->wait(missing, &data) != OK);
+	CHECK(data.is_empty());
+
+	// Waited requests are released.
+	CHECK(queue->get_status(whole) == FileIOQueue::STATUS_INVALID);
+}
+
 } // namespace TestFileAccess
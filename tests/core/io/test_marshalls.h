@@ -489,4 +489,113 @@ TEST_CASE("[Marshalls] Typed dictionary decoding") {
 	CHECK(dictionary[Variant(uint64_t(0x0f123456789abcdef))] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+TEST_CASE("[Marshalls] Compact typed array encoding") {
+	int r_len;
+	Array array;
+	array.set_typed(Variant::INT, StringName(), Ref<Script>());
+	array.push_back(1);
+	array.push_back(-2);
+	uint8_t buffer[28];
+
+	CHECK(encode_variant(array, nullptr, r_len, false, true) == OK);
+	CHECK_MESSAGE(r_len == 28, "Length == 4 bytes for header + 4 bytes for array type + 4 bytes for array size + 8 bytes per element.");
+	CHECK(encode_variant(array, buffer, r_len, false, true) == OK);
+	CHECK_MESSAGE(buffer[0] == 0x1c, "Variant::ARRAY");
+	CHECK(buffer[1] == 0x00);
+	CHECK_MESSAGE(buffer[2] == 0x31, "CONTAINER_TYPE_KIND_BUILTIN | HEADER_DATA_FLAG_COMPACT_ARRAY | HEADER_DATA_FLAG_COMPACT_ARRAY_64");
+	CHECK(buffer[3] == 0x00);
+	// Elements have no header.
+	CHECK(buffer[12] == 0x01);
+	CHECK(buffer[19] == 0x00);
+	CHECK(buffer[20] == 0xfe);
+	CHECK(buffer[27] == 0xff);
+
+	Variant variant;
+	CHECK(decode_variant(variant, buffer, 28, &r_len) == OK);
+	CHECK(r_len == 28);
+	CHECK(variant == Variant(array));
+	CHECK(Array(variant).get_typed_builtin() == Variant::INT);
+
+	// Untyped arrays aren't affected.
+	Array untyped = { 1, "a" };
+	int compact_len;
+	CHECK(encode_variant(untyped, nullptr, r_len) == OK);
+	CHECK(encode_variant(untyped, nullptr, compact_len, false, true) == OK);
+	CHECK(r_len == compact_len);
+}
+
+TEST_CASE("[Marshalls] Compact typed dictionary round trip") {
+	Dictionary dict;
+	dict.set_typed(Variant::STRING, StringName(), Variant(), Variant::VECTOR3, StringName(), Variant());
+	dict["a"] = Vector3(1, 2, 3);
+	dict["bc"] = Vector3(-4, 5.5, 6);
+
+	int len;
+	int compact_len;
+	CHECK(encode_variant(dict, nullptr, len) == OK);
+	CHECK(encode_variant(dict, nullptr, compact_len, false, true) == OK);
+	CHECK_MESSAGE(compact_len == len - 4 * 4, "Keys and values don't have a header.");
+
+	Vector<uint8_t> buffer;
+	CHECK(encode_variant(dict, buffer, compact_len, false, true) == OK);
+	Variant variant;
+	int r_len;
+	CHECK(decode_variant(variant, buffer.ptr(), compact_len, &r_len) == OK);
+	CHECK(r_len == compact_len);
+	Dictionary decoded = variant;
+	CHECK(decoded.get_typed_key_builtin() == Variant::STRING);
+	CHECK(decoded.get_typed_value_builtin() == Variant::VECTOR3);
+	CHECK(decoded == dict);
+}
+
+static Variant _make_nested_variant() {
+	Dictionary dict;
+	dict["name"] = "Marshalls";
+	dict[StringName("id")] = int64_t(1) << 40;
+	dict[3] = 0.1;
+
+	Array typed;
+	typed.set_typed(Variant::STRING, StringName(), Ref<Script>());
+	typed.push_back("x");
+	typed.push_back("yz");
+	dict["typed"] = typed;
+
+	PackedInt32Array ints = { 1, -2, 3 };
+	PackedFloat64Array doubles = { 0.5, -1.25 };
+	PackedVector3Array vectors = { Vector3(1, 2, 3), Vector3(4, 5, 6) };
+	PackedColorArray colors = { Color(0.1, 0.2, 0.3, 0.4) };
+	PackedByteArray bytes = { 1, 2, 3, 4, 5 };
+	Array nested = { ints, doubles, vectors, colors, bytes, Array({ Vector2(1, 2), NodePath("a/b:c"), Variant() }) };
+	dict["nested"] = nested;
+	return dict;
+}
+
+TEST_CASE("[Marshalls] Single-pass encoding") {
+	const Variant variant = _make_nested_variant();
+
+	int len;
+	CHECK(encode_variant(variant, nullptr, len) == OK);
+	Vector<uint8_t> expected;
+	expected.resize(len);
+	CHECK(encode_variant(variant, expected.ptrw(), len) == OK);
+
+	Vector<uint8_t> buffer;
+	int r_len;
+	CHECK(encode_variant(variant, buffer, r_len) == OK);
+	CHECK(r_len == len);
+	CHECK(buffer == expected);
+
+	// A larger buffer is reused as is.
+	buffer.resize(len * 2);
+	CHECK(encode_variant(variant, buffer, r_len) == OK);
+	CHECK(r_len == len);
+	CHECK(buffer.size() == len * 2);
+	CHECK(buffer.slice(0, len) == expected);
+
+	Variant decoded;
+	CHECK(decode_variant(decoded, buffer.ptr(), r_len, &len) == OK);
+	CHECK(len == r_len);
+	CHECK(decoded == variant);
+}
+
 } // namespace TestMarshalls
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/io/delta_encoding.h"
+#include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
@@ -116,4 +118,305 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack and read back compressed files") {
+	// Compressible, but not trivially so.
+	Vector<uint8_t> data;
+	data.resize(300000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i / 7) % 61 + (i % 13 == 0 ? i / 1000 : 0);
+	}
+	const String source_path = TestUtils::get_temp_path("compressed_source.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_compression_enabled(true);
+	pck_packer.set_compression_block_size(4096);
+	CHECK(pck_packer.add_file("compressed.bin", source_path) == OK);
+	CHECK(pck_packer.add_file("encrypted.bin", source_path, true) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK_MESSAGE(
+				f->get_length() < (uint64_t)data.size() * 3 / 2,
+				"Only the encrypted copy should be stored at full size.");
+		f->seek(4);
+		CHECK_MESSAGE(f->get_32() == PACK_FORMAT_VERSION_V4, "Packs with compressed files should be V4.");
+	}
+
+	PackedData packed_data;
+	REQUIRE(packed_data.add_pack(output_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = packed_data.try_open_path("res://compressed.bin");
+	REQUIRE(f.is_valid());
+	REQUIRE(f->is_open());
+	CHECK(f->get_length() == (uint64_t)data.size());
+
+	// Whole file, spanning many blocks.
+	CHECK(f->get_buffer(data.size()) == data);
+	CHECK(f->get_buffer(1).is_empty());
+	CHECK(f->eof_reached());
+
+	// Random access across block boundaries.
+	f->seek(4090);
+	CHECK(f->get_buffer(20) == data.slice(4090, 4110));
+	f->seek(data.size() - 5);
+	CHECK(f->get_buffer(20) == data.slice(data.size() - 5));
+	f->seek(123456);
+	CHECK(f->get_8() == data[123456]);
+	CHECK(f->get_8() == data[123457]);
+
+	// A second reader is served from the shared block cache.
+	Ref<FileAccess> f2 = packed_data.try_open_path("res://compressed.bin");
+	REQUIRE(f2.is_valid());
+	CHECK(f2->get_buffer(data.size()) == data);
+}
+TEST_CASE("[PCKPacker] Refuse packs with unknown file flags") {
+	const String source_path = TestUtils::get_temp_path("flags_source.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("Some text.");
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_flags.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file("a.txt", source_path) == OK);
+	CHECK(pck_packer.add_file("b.txt", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		PackedData packed_data;
+		CHECK(packed_data.add_pack(output_pck_path, true, 0) == OK);
+		CHECK(packed_data.has_path("res://a.txt"));
+	}
+
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		f->seek(4);
+		CHECK_MESSAGE(f->get_32() == PACK_FORMAT_VERSION_V3, "Packs without compressed files should stay V3.");
+
+		// Header: magic, versions and flags, then the files base and the directory offset.
+		f->seek(32);
+		// Directory: file count, then the path length, the path padded to 4 bytes, offset, size, MD5 and flags.
+		// Only the second file gets the unknown flag.
+		const uint64_t entry_size = 4 + 8 + 8 + 8 + 16 + 4;
+		f->seek(f->get_64() + 4 + entry_size + entry_size - 4);
+		f->store_32(1 << 4);
+	}
+
+	// Reading the file as if it had no flags would return the wrong data.
+	PackedData packed_data;
+	ERR_PRINT_OFF;
+	CHECK(packed_data.add_pack(output_pck_path, true, 0) != OK);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(!packed_data.has_path("res://a.txt"), "Files before the rejected one shouldn't be registered.");
+}
+
+TEST_CASE("[PCKPacker] Deduplicate content and repack incrementally") {
+	// Incompressible content, so sizes are predictable.
+	Vector<uint8_t> data_a;
+	Vector<uint8_t> data_b;
+	data_a.resize(100000);
+	data_b.resize(100000);
+	uint32_t seed = 12345;
+	for (int i = 0; i < data_a.size(); i++) {
+		seed = seed * 1664525 + 1013904223;
+		data_a.write[i] = seed >> 24;
+		data_b.write[i] = seed >> 16;
+	}
+
+	const String source_a = TestUtils::get_temp_path("dedup_a.bin");
+	const String source_b = TestUtils::get_temp_path("dedup_b.bin");
+	const String source_a_copy = TestUtils::get_temp_path("dedup_a_copy.bin");
+	const auto write_source = [](const String &p_path, const Vector<uint8_t> &p_data) {
+		Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(p_data);
+	};
+	write_source(source_a, data_a);
+	write_source(source_b, data_b);
+	write_source(source_a_copy, data_a);
+
+	const auto pack = [&](const String &p_pck_path, const String &p_previous_pck_path) {
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(p_pck_path) == OK);
+		pck_packer.set_compression_enabled(true);
+		if (!p_previous_pck_path.is_empty()) {
+			REQUIRE(pck_packer.use_previous_pack(p_previous_pck_path) == OK);
+		}
+		CHECK(pck_packer.add_file("a.bin", source_a) == OK);
+		CHECK(pck_packer.add_file("b.bin", source_b) == OK);
+		CHECK(pck_packer.add_file("copy/a.bin", source_a_copy) == OK);
+		CHECK(pck_packer.add_file("encrypted/b.bin", source_b, true) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+		return FileAccess::get_file_as_bytes(p_pck_path);
+	};
+
+	const String first_pck_path = TestUtils::get_temp_path("output_dedup_first.pck");
+	const Vector<uint8_t> first_pck = pack(first_pck_path, String());
+	CHECK_MESSAGE(
+			first_pck.size() < data_a.size() * 4 - data_a.size() / 2,
+			"Files with identical content should be stored once.");
+
+	PackedData packed_data;
+	REQUIRE(packed_data.add_pack(first_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = packed_data.try_open_path("res://a.bin");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(data_a.size()) == data_a);
+	f = packed_data.try_open_path("res://copy/a.bin");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(data_a.size()) == data_a);
+	f = packed_data.try_open_path("res://b.bin");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(data_b.size()) == data_b);
+
+	// Encrypted files get a random IV, so matching bytes show they were copied from the previous pack.
+	const String second_pck_path = TestUtils::get_temp_path("output_dedup_second.pck");
+	CHECK_MESSAGE(
+			pack(second_pck_path, first_pck_path) == first_pck,
+			"Repacking unchanged files should reuse the stored data.");
+
+	data_b.write[500] ^= 0xFF;
+	write_source(source_b, data_b);
+	const String third_pck_path = TestUtils::get_temp_path("output_dedup_third.pck");
+	CHECK(pack(third_pck_path, second_pck_path) != first_pck);
+
+	PackedData repacked_data;
+	REQUIRE(repacked_data.add_pack(third_pck_path, true, 0) == OK);
+	f = repacked_data.try_open_path("res://a.bin");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(data_a.size()) == data_a);
+	f = repacked_data.try_open_path("res://b.bin");
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(
+			f->get_buffer(data_b.size()) == data_b,
+			"Changed files should be stored again.");
+}
+
+TEST_CASE("[PCKPacker] Repack encrypted files with a changed key") {
+	const String source_path = TestUtils::get_temp_path("rekey_source.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("Secret text, encrypted with whatever key the pack uses.");
+	}
+	const String old_key = "00112233445566778899aabbccddeeff00112233445566778899aabbccddeeff";
+	const String new_key = "ffeeddccbbaa99887766554433221100ffeeddccbbaa99887766554433221100";
+
+	const String old_pck_path = TestUtils::get_temp_path("output_rekey_old.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(old_pck_path, 32, old_key) == OK);
+		CHECK(pck_packer.add_file("e.bin", source_path, true) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+	}
+
+	const String new_pck_path = TestUtils::get_temp_path("output_rekey_new.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(new_pck_path, 32, new_key) == OK);
+		REQUIRE(pck_packer.use_previous_pack(old_pck_path) == OK);
+		CHECK(pck_packer.add_file("e.bin", source_path, true) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(new_pck_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	// Header: magic, versions and flags, then the files base and the directory offset.
+	f->seek(24);
+	const uint64_t file_base = f->get_64();
+	// Directory: file count, then the path length, the path padded to 4 bytes, and the offset.
+	f->seek(f->get_64() + 4 + 4 + 8);
+	f->seek(file_base + f->get_64());
+
+	Ref<FileAccessEncrypted> fae;
+	fae.instantiate();
+	CHECK_MESSAGE(
+			fae->open_and_parse(f, new_key.hex_decode(), FileAccessEncrypted::MODE_READ, false) == OK,
+			"Files encrypted with the old key shouldn't be copied from the previous pack.");
+	CHECK(fae->get_as_text() == FileAccess::get_file_as_string(source_path));
+}
+
+TEST_CASE("[PCKPacker] Pack and apply block delta patches") {
+	Vector<uint8_t> old_data;
+	old_data.resize(200000);
+	uint32_t seed = 777;
+	for (int i = 0; i < old_data.size(); i++) {
+		seed = seed * 1664525 + 1013904223;
+		old_data.write[i] = seed >> 24;
+	}
+	// An insertion shifts everything after it, the rest is edited in place.
+	Vector<uint8_t> new_data = old_data.slice(0, 5000);
+	for (int i = 0; i < 100; i++) {
+		new_data.push_back(i);
+	}
+	new_data.append_array(old_data.slice(5000));
+	new_data.write[150000] ^= 0xFF;
+
+	Vector<uint8_t> delta;
+	REQUIRE(DeltaEncoding::encode_block_delta(old_data, new_data, delta) == OK);
+	CHECK(DeltaEncoding::is_block_delta(delta));
+	CHECK(delta.size() < 10000);
+	Vector<uint8_t> decoded;
+	REQUIRE(DeltaEncoding::decode_delta(old_data, delta, decoded) == OK);
+	CHECK(decoded == new_data);
+
+	const String source_path = TestUtils::get_temp_path("delta_source.bin");
+	const auto write_source = [&](const Vector<uint8_t> &p_data) {
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(p_data);
+	};
+
+	write_source(old_data);
+	const String base_pck_path = TestUtils::get_temp_path("output_delta_base.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(base_pck_path) == OK);
+		pck_packer.set_compression_enabled(true);
+		CHECK(pck_packer.add_file("data.bin", source_path) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+	}
+
+	write_source(new_data);
+	const String patch_pck_path = TestUtils::get_temp_path("output_delta_patch.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(patch_pck_path) == OK);
+		pck_packer.set_compression_enabled(true);
+		REQUIRE(pck_packer.use_delta_base_pack(base_pck_path) == OK);
+		CHECK(pck_packer.add_file("data.bin", source_path) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+	}
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes(patch_pck_path).size() < 20000,
+			"Changed files should be stored as deltas against the base pack.");
+
+	PackedData packed_data;
+	REQUIRE(packed_data.add_pack(base_pck_path, true, 0) == OK);
+	REQUIRE(packed_data.add_pack(patch_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = packed_data.try_open_path("res://data.bin");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)new_data.size());
+
+	// Reads spanning copies and literals are rebuilt on demand.
+	f->seek(149990);
+	CHECK(f->get_buffer(20) == new_data.slice(149990, 150010));
+	f->seek(4990);
+	CHECK(f->get_buffer(200) == new_data.slice(4990, 5190));
+	f->seek(0);
+	CHECK(f->get_buffer(new_data.size()) == new_data);
+	CHECK(f->get_buffer(1).is_empty());
+	CHECK(f->eof_reached());
+}
 } // namespace TestPCKPacker
@@ -573,6 +573,254 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Binary packed array blobs and sub-resource loading") {
+	PackedFloat32Array floats;
+	PackedVector3Array vertices;
+	for (int i = 0; i < 4096; i++) {
+		floats.push_back(i * 0.5f);
+		vertices.push_back(Vector3(i, -i, i * 2));
+	}
+	const PackedByteArray small_bytes = { 1, 2, 3 };
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("floats", floats);
+	resource->set_meta("small_bytes", small_bytes);
+	Ref<Resource> child_resource = memnew(Resource);
+	child_resource->set_name("Child");
+	child_resource->set_meta("vertices", vertices);
+	child_resource->set_meta("nested", Array({ floats, 42 }));
+	Ref<Resource> grandchild_resource = memnew(Resource);
+	grandchild_resource->set_name("Grandchild");
+	child_resource->set_meta("child", grandchild_resource);
+	resource->set_meta("child", child_resource);
+
+	const String save_path = TestUtils::get_temp_path("resource_blobs.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	const Ref<Resource> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK_MESSAGE(
+			PackedFloat32Array(loaded->get_meta("floats")) == floats,
+			"Large packed arrays should round-trip through the blob section.");
+	CHECK_MESSAGE(
+			PackedByteArray(loaded->get_meta("small_bytes")) == small_bytes,
+			"Small packed arrays should round-trip inline.");
+	const Ref<Resource> loaded_child = loaded->get_meta("child");
+	REQUIRE(loaded_child.is_valid());
+	CHECK(PackedVector3Array(loaded_child->get_meta("vertices")) == vertices);
+	const Array nested = loaded_child->get_meta("nested");
+	REQUIRE(nested.size() == 2);
+	CHECK_MESSAGE(
+			PackedFloat32Array(nested[0]) == floats,
+			"Packed arrays nested in containers should round-trip through the blob section.");
+	CHECK(int(nested[1]) == 42);
+
+	// Only the child and what it refers to are parsed.
+	const String child_path = save_path + "::" + child_resource->get_scene_unique_id();
+	const Ref<Resource> sub_resource = ResourceLoader::load(child_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(sub_resource.is_valid());
+	CHECK(sub_resource->get_name() == "Child");
+	CHECK(PackedVector3Array(sub_resource->get_meta("vertices")) == vertices);
+	const Ref<Resource> sub_resource_child = sub_resource->get_meta("child");
+	REQUIRE(sub_resource_child.is_valid());
+	CHECK_MESSAGE(
+			sub_resource_child->get_name() == "Grandchild",
+			"Sub-resources referenced by a sub-resource loaded on its own should be parsed on first reference.");
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			ResourceLoader::load(save_path + "::Resource_missing", "", ResourceFormatLoader::CACHE_MODE_IGNORE).is_null(),
+			"Loading an unknown sub-resource should fail.");
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Resource] Retaining released resources within a cache budget") {
+	Vector<String> paths;
+	for (int i = 0; i < 3; i++) {
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_name(vformat("Retained %d", i));
+		paths.push_back(TestUtils::get_temp_path(vformat("resource_retained_%d.res", i)));
+		REQUIRE(ResourceSaver::save(resource, paths[i]) == OK);
+	}
+
+	// Resources without a size estimate count as UNKNOWN_RESOURCE_SIZE, so this retains two of them.
+	ResourceCache::set_retain_budget(ResourceCache::UNKNOWN_RESOURCE_SIZE * 2);
+	const uint64_t hits = ResourceCache::get_hit_count();
+	const uint64_t misses = ResourceCache::get_miss_count();
+	const uint64_t evictions = ResourceCache::get_eviction_count();
+
+	ObjectID first_id = ResourceLoader::load(paths[0])->get_instance_id();
+	CHECK(ResourceCache::get_miss_count() == misses + 1);
+	CHECK(ResourceCache::get_retained_memory() == ResourceCache::UNKNOWN_RESOURCE_SIZE);
+	CHECK_MESSAGE(
+			ResourceLoader::load(paths[0])->get_instance_id() == first_id,
+			"A released resource within the budget should be served from the cache.");
+	CHECK(ResourceCache::get_hit_count() == hits + 1);
+
+	ResourceLoader::load(paths[1]);
+	CHECK(ResourceCache::get_eviction_count() == evictions);
+	ResourceLoader::load(paths[2]);
+	CHECK(ResourceCache::get_miss_count() == misses + 3);
+	CHECK(ResourceCache::get_retained_memory() == ResourceCache::UNKNOWN_RESOURCE_SIZE * 2);
+	CHECK_MESSAGE(
+			ResourceCache::get_eviction_count() == evictions + 1,
+			"Exceeding the budget should evict the least recently used resource.");
+	CHECK_MESSAGE(
+			ObjectDB::get_instance(first_id) == nullptr,
+			"An evicted resource that is not referenced elsewhere should be freed.");
+
+	// Held references keep resources cached regardless of the budget, and aren't charged against it.
+	Ref<Resource> held = ResourceLoader::load(paths[1]);
+	CHECK(ResourceCache::get_hit_count() == hits + 2);
+	CHECK_MESSAGE(
+			ResourceCache::get_retained_memory() == ResourceCache::UNKNOWN_RESOURCE_SIZE,
+			"A resource in use again should no longer count against the budget.");
+	{
+		Ref<Resource> other = ResourceLoader::load(paths[2]);
+		CHECK(ResourceCache::get_retained_memory() == 0);
+	}
+	CHECK(ResourceCache::get_retained_memory() == ResourceCache::UNKNOWN_RESOURCE_SIZE);
+	ResourceCache::clear_retained();
+	CHECK(ResourceCache::get_retained_memory() == 0);
+	CHECK(ResourceLoader::load(paths[1]) == held);
+	CHECK(ResourceCache::get_hit_count() == hits + 4);
+
+	{
+		Ref<Resource> first = ResourceLoader::load(paths[0]);
+		Ref<Resource> third = ResourceLoader::load(paths[2]);
+		const uint64_t evictions_before_release = ResourceCache::get_eviction_count();
+		first.unref();
+		third.unref();
+		held.unref();
+		CHECK(ResourceCache::get_retained_memory() == ResourceCache::UNKNOWN_RESOURCE_SIZE * 3);
+		CHECK_MESSAGE(
+				ResourceCache::get_eviction_count() == evictions_before_release,
+				"Releasing resources or reading the retained memory shouldn't evict anything, only loads do.");
+	}
+
+	ResourceCache::set_retain_budget(0);
+	held.unref();
+	ResourceLoader::load(paths[2]);
+	CHECK_MESSAGE(
+			ResourceCache::get_retained_memory() == 0,
+			"Nothing should be retained without a budget.");
+}
+
+// Loads text files listing the paths of their dependencies, one per line, and records which files were loaded.
+class DependencyListResourceFormatLoader : public ResourceFormatLoader {
+	static Vector<String> _read_dependencies(const String &p_path) {
+		Vector<String> dependencies;
+		for (const String &line : FileAccess::get_file_as_string(p_path).split("\n", false)) {
+			dependencies.push_back(line);
+		}
+		return dependencies;
+	}
+
+public:
+	Mutex mutex;
+	HashSet<String> loaded;
+	bool load_dependencies = true;
+
+	Ref<Resource> load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) override {
+		Ref<Resource> resource;
+		resource.instantiate();
+		resource->set_name(p_path.get_file());
+		Array children;
+		if (load_dependencies) {
+			for (const String &dependency : _read_dependencies(p_path)) {
+				children.push_back(ResourceLoader::load(dependency));
+			}
+		}
+		resource->set_meta("children", children);
+		{
+			MutexLock lock(mutex);
+			loaded.insert(p_path.get_file());
+		}
+		if (r_error) {
+			*r_error = OK;
+		}
+		return resource;
+	}
+	void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("deplist");
+	}
+	bool handles_type(const String &p_type) const override {
+		return p_type == "Resource";
+	}
+	String get_resource_type(const String &p_path) const override {
+		return p_path.has_extension("deplist") ? "Resource" : "";
+	}
+	void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types) override {
+		for (const String &dependency : _read_dependencies(p_path)) {
+			p_dependencies->push_back(p_add_types ? dependency + "::Resource" : dependency);
+		}
+	}
+};
+
+static String describe_dependency_tree(const Ref<Resource> &p_resource) {
+	String description = p_resource->get_name() + "(";
+	const Array children = p_resource->get_meta("children");
+	for (const Variant &child : children) {
+		description += describe_dependency_tree(child);
+	}
+	return description + ")";
+}
+
+TEST_CASE("[Resource] Starting dependency loads ahead of threaded loads") {
+	const String leaf_path = TestUtils::get_temp_path("leaf.deplist");
+	const String middle_path = TestUtils::get_temp_path("middle.deplist");
+	const String root_path = TestUtils::get_temp_path("root.deplist");
+	const String contents[3][2] = {
+		{ leaf_path, "" },
+		{ middle_path, leaf_path },
+		{ root_path, middle_path + "\n" + leaf_path },
+	};
+	for (const String(&file)[2] : contents) {
+		Ref<FileAccess> f = FileAccess::open(file[0], FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(file[1]);
+	}
+
+	Ref<DependencyListResourceFormatLoader> loader;
+	loader.instantiate();
+	ResourceLoader::add_resource_format_loader(loader, true);
+
+	SUBCASE("Dependencies are queued before the dependent is parsed") {
+		// The root doesn't load anything itself, so only the threaded load can have started the others.
+		loader->load_dependencies = false;
+		REQUIRE(ResourceLoader::load_threaded_request(root_path, "", true) == OK);
+		Ref<Resource> root = ResourceLoader::load_threaded_get(root_path);
+		REQUIRE(root.is_valid());
+		CHECK(describe_dependency_tree(root) == "root.deplist()");
+
+		MutexLock lock(loader->mutex);
+		CHECK(loader->loaded.has("middle.deplist"));
+		CHECK(loader->loaded.has("leaf.deplist"));
+	}
+
+	SUBCASE("Threaded loads give the same result as loads on the calling thread") {
+		const String expected = "root.deplist(middle.deplist(leaf.deplist())leaf.deplist())";
+		{
+			Ref<Resource> root = ResourceLoader::load(root_path);
+			REQUIRE(root.is_valid());
+			CHECK(describe_dependency_tree(root) == expected);
+		}
+		{
+			REQUIRE(ResourceLoader::load_threaded_request(root_path, "", true) == OK);
+			Ref<Resource> root = ResourceLoader::load_threaded_get(root_path);
+			REQUIRE(root.is_valid());
+			CHECK(describe_dependency_tree(root) == expected);
+
+			// Dependencies are shared through the cache, as with a regular load.
+			const Array children = root->get_meta("children");
+			const Array middle_children = Ref<Resource>(children[0])->get_meta("children");
+			CHECK(middle_children[0] == children[1]);
+		}
+	}
+
+	ResourceLoader::remove_resource_format_loader(loader);
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
@@ -105,6 +105,112 @@ TEST_CASE("[Variant] Writer and parser Variant::FLOAT") {
 	CHECK_MESSAGE(float_parsed == 1.0e+100, "Should match the double literal.");
 }
 
+TEST_CASE("[Variant] Parser packed arrays read from the stream buffer") {
+	// Long enough to span several readahead blocks, so some numbers are split between them.
+	String text = "PackedFloat32Array(";
+	for (int i = 0; i < 3000; i++) {
+		if (i > 0) {
+			text += (i % 50 == 0) ? ",\n" : ", ";
+		}
+		switch (i % 4) {
+			case 0:
+				text += itos(i);
+				break;
+			case 1:
+				text += rtos(-i * 0.25);
+				break;
+			case 2:
+				text += "1.5e-3";
+				break;
+			case 3:
+				text += "inf";
+				break;
+		}
+	}
+	text += ")";
+
+	String errs;
+	int line = 1;
+	Variant buffered;
+	VariantParser::StreamString buffered_stream;
+	buffered_stream.s = text;
+	REQUIRE(VariantParser::parse(&buffered_stream, buffered, errs, line) == OK);
+	const int buffered_line = line;
+
+	// Without readahead, every character goes through the tokenizer.
+	line = 1;
+	Variant tokenized;
+	VariantParser::StreamString tokenized_stream(false);
+	tokenized_stream.s = text;
+	REQUIRE(VariantParser::parse(&tokenized_stream, tokenized, errs, line) == OK);
+
+	const PackedFloat32Array values = buffered;
+	CHECK(values.size() == 3000);
+	CHECK(values[1] == -0.25f);
+	CHECK(values[2] == 1.5e-3f);
+	CHECK(Math::is_inf(values[3]));
+	CHECK_MESSAGE(values == PackedFloat32Array(tokenized), "Both parsing paths should give the same values.");
+	CHECK_MESSAGE(buffered_line == line, "Both parsing paths should count the same lines.");
+
+	PackedVector3Array vectors;
+	for (int i = 0; i < 1000; i++) {
+		vectors.push_back(Vector3(i, -i * 0.5, 1e-5 * i));
+	}
+	String vectors_text;
+	VariantWriter::write_to_string(vectors, vectors_text);
+	VariantParser::StreamString vectors_stream;
+	vectors_stream.s = vectors_text;
+	Variant vectors_parsed;
+	REQUIRE(VariantParser::parse(&vectors_stream, vectors_parsed, errs, line) == OK);
+	CHECK(PackedVector3Array(vectors_parsed) == vectors);
+
+	ERR_PRINT_OFF;
+	VariantParser::StreamString trailing_comma_stream;
+	trailing_comma_stream.s = "PackedInt32Array(1, 2,)";
+	CHECK_MESSAGE(
+			VariantParser::parse(&trailing_comma_stream, vectors_parsed, errs, line) == ERR_PARSE_ERROR,
+			"A trailing comma should still be rejected.");
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Variant] Parser packed arrays keep reading from the stream buffer") {
+	// Spans many readahead blocks, so numbers are split at block boundaries and finished by the tokenizer.
+	String text = "PackedInt32Array(";
+	for (int i = 0; i < 5000; i++) {
+		text += (i > 0 ? ", " : "") + itos(i * 7);
+	}
+	text += ")";
+
+	String errs;
+	int line = 1;
+	Variant parsed;
+	VariantParser::StreamString stream;
+	stream.s = text;
+	REQUIRE(VariantParser::parse(&stream, parsed, errs, line) == OK);
+	CHECK(PackedInt32Array(parsed).size() == 5000);
+	CHECK(PackedInt32Array(parsed)[4999] == 4999 * 7);
+	CHECK_MESSAGE(
+			stream.buffered_skipped > (uint64_t)text.length() * 9 / 10,
+			"Numbers after a block boundary should be read from the buffer again.");
+
+	// Every "inf" goes through the tokenizer, the numbers in between shouldn't.
+	text = "PackedFloat32Array(";
+	for (int i = 0; i < 5000; i++) {
+		text += (i > 0 ? ", " : "") + (i % 10 == 0 ? String("inf") : itos(i * 7));
+	}
+	text += ")";
+
+	VariantParser::StreamString inf_stream;
+	inf_stream.s = text;
+	REQUIRE(VariantParser::parse(&inf_stream, parsed, errs, line) == OK);
+	CHECK(PackedFloat32Array(parsed).size() == 5000);
+	CHECK(Math::is_inf(PackedFloat32Array(parsed)[10]));
+	CHECK(PackedFloat32Array(parsed)[11] == 77.0f);
+	CHECK_MESSAGE(
+			inf_stream.buffered_skipped > (uint64_t)text.length() * 3 / 4,
+			"Numbers after an identifier should be read from the buffer again.");
+}
+
 TEST_CASE("[Variant] Assignment To Bool from Int,Float,String,Vec2,Vec2i,Vec3,Vec3i,Vec4,Vec4i,Rect2,Rect2i,Trans2d,Trans3d,Color,Call,Plane,Basis,AABB,Quant,Proj,RID,and Object") {
 	Variant int_v = 0;
 	Variant bool_v = true;
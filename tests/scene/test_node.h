@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/object/class_db.h"
+#include "core/object/script_instance.h"
 #include "scene/main/node.h"
 #include "scene/resources/packed_scene.h"
 
@@ -105,6 +106,39 @@ public:
 	}
 };
 
+// Stands in for a script, records how many children its owner has when it becomes ready.
+class ReadyCountingScriptInstance : public ScriptInstance {
+	Node *owner = nullptr;
+
+public:
+	int children_on_ready = -1;
+
+	bool set(const StringName &p_name, const Variant &p_value) override { return false; }
+	bool get(const StringName &p_name, Variant &r_ret) const override { return false; }
+	void get_property_list(List<PropertyInfo> *p_properties) const override {}
+	Variant::Type get_property_type(const StringName &p_name, bool *r_is_valid) const override { return Variant::NIL; }
+	void validate_property(PropertyInfo &p_property) const override {}
+	bool property_can_revert(const StringName &p_name) const override { return false; }
+	bool property_get_revert(const StringName &p_name, Variant &r_ret) const override { return false; }
+	void get_method_list(List<MethodInfo> *p_list) const override {}
+	bool has_method(const StringName &p_method) const override { return false; }
+	Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+		return Variant();
+	}
+	void notification(int p_notification, bool p_reversed = false) override {
+		if (p_notification == Node::NOTIFICATION_READY) {
+			children_on_ready = owner->get_child_count();
+		}
+	}
+	Ref<Script> get_script() const override { return Ref<Script>(); }
+	ScriptLanguage *get_language() override { return nullptr; }
+
+	ReadyCountingScriptInstance(Node *p_owner) {
+		owner = p_owner;
+	}
+};
+
 TEST_CASE("[SceneTree][Node] Testing node operations with a very simple scene tree") {
 	Node *node = memnew(Node);
 
@@ -520,6 +554,314 @@ TEST_CASE("[SceneTree][Node] Duplicating node with internal children") {
 	memdelete(dup);
 }
 
+TEST_CASE("[Node] Children of a wide parent") {
+	Node *parent = memnew(Node);
+	const int count = 1000;
+
+	for (int i = 0; i < count; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child");
+		parent->add_child(child, true);
+	}
+	REQUIRE(parent->get_child_count() == count);
+
+	SUBCASE("Readable names should be serial and reuse the lowest free number") {
+		CHECK(parent->get_child(0)->get_name() == "Child");
+		CHECK(parent->get_child(1)->get_name() == "Child2");
+		CHECK(parent->get_child(count - 1)->get_name() == "Child" + itos(count));
+
+		Node *removed = parent->get_node(NodePath("Child500"));
+		parent->remove_child(removed);
+		memdelete(removed);
+
+		Node *renamed = parent->get_node(NodePath("Child700"));
+		renamed->set_name("Renamed");
+
+		Node *child = memnew(Node);
+		child->set_name("Child");
+		parent->add_child(child, true);
+		CHECK(child->get_name() == "Child500");
+
+		child = memnew(Node);
+		child->set_name("Child");
+		parent->add_child(child, true);
+		CHECK(child->get_name() == "Child700");
+
+		child = memnew(Node);
+		child->set_name("Child");
+		parent->add_child(child, true);
+		CHECK(child->get_name() == "Child" + itos(count + 1));
+	}
+
+	SUBCASE("Order should be kept when removing and re-adding children") {
+		Node *first = parent->get_child(0);
+		Node *middle = parent->get_child(count / 2);
+		Node *last = parent->get_child(count - 1);
+		Node *after_middle = parent->get_child(count / 2 + 1);
+
+		parent->remove_child(middle);
+		CHECK(parent->get_child_count() == count - 1);
+		CHECK(parent->get_child(count / 2) == after_middle);
+		CHECK(after_middle->get_index() == count / 2);
+
+		parent->remove_child(last);
+		parent->remove_child(first);
+		CHECK(parent->get_child_count() == count - 3);
+		CHECK(parent->get_child(-1)->get_index() == count - 4);
+
+		parent->add_child(first);
+		parent->add_child(middle);
+		CHECK(parent->get_child(-2) == first);
+		CHECK(parent->get_child(-1) == middle);
+		CHECK(middle->get_index() == count - 2);
+
+		memdelete(last);
+
+		int index = 0;
+		for (Node *child : parent->iterate_children()) {
+			CHECK(child->get_index() == index);
+			index++;
+		}
+		CHECK(index == count - 1);
+	}
+
+	SUBCASE("Internal children should stay in their range when siblings are removed") {
+		Node *front = memnew(Node);
+		Node *back = memnew(Node);
+		parent->add_child(front, false, Node::INTERNAL_MODE_FRONT);
+		parent->add_child(back, false, Node::INTERNAL_MODE_BACK);
+
+		Node *first_external = parent->get_child(0, false);
+		Node *last_external = parent->get_child(-1, false);
+		parent->remove_child(last_external);
+		parent->remove_child(first_external);
+		memdelete(first_external);
+		memdelete(last_external);
+
+		CHECK(parent->get_child(0) == front);
+		CHECK(parent->get_child(-1) == back);
+		CHECK(parent->get_child_count(false) == count - 2);
+
+		parent->remove_child(back);
+		memdelete(back);
+		Node *child = memnew(Node);
+		parent->add_child(child);
+		CHECK(parent->get_child(-1) == child);
+		CHECK(child->get_index(false) == count - 2);
+	}
+
+	SUBCASE("Queries should stay right while children are removed from the front") {
+		Node *front = memnew(Node);
+		Node *back = memnew(Node);
+		parent->add_child(front, false, Node::INTERNAL_MODE_FRONT);
+		parent->add_child(back, false, Node::INTERNAL_MODE_BACK);
+
+		// Spans several batches of removed children left in the cache before it is compacted.
+		for (int i = 0; i < count / 2; i++) {
+			Node *first = parent->get_child(0, false);
+			parent->remove_child(first);
+			memdelete(first);
+
+			const int left = count - i - 1;
+			CHECK(parent->get_child_count(false) == left);
+			CHECK(parent->get_child(0, false)->get_name() == "Child" + itos(i + 2));
+			CHECK(parent->get_child(0, false)->get_index(false) == 0);
+			CHECK(parent->get_child(1) == parent->get_child(0, false));
+			CHECK(parent->get_child(-1, false)->get_index() == left);
+			CHECK(parent->get_child(-1) == back);
+			CHECK(back->get_index() == left + 1);
+		}
+		CHECK(parent->get_child(0) == front);
+
+		int index = 0;
+		for (Node *child : parent->iterate_children()) {
+			CHECK(child->get_index() == index);
+			index++;
+		}
+		CHECK(index == count - count / 2 + 2);
+	}
+
+	SUBCASE("Queries should stay right after children are removed out of order") {
+		LocalVector<Node *> expected;
+		for (int i = 0; i < count; i++) {
+			expected.push_back(parent->get_child(i));
+		}
+
+		// Few enough removals for the cache to keep them as holes, done back to front without queries in between.
+		for (int i = 59; i >= 1; i -= 2) {
+			parent->remove_child(expected[i]);
+			memdelete(expected[i]);
+			expected[i] = nullptr;
+		}
+		// Trims the last two slots of the cache.
+		for (int i = count - 2; i < count; i++) {
+			parent->remove_child(expected[i]);
+			memdelete(expected[i]);
+			expected[i] = nullptr;
+		}
+
+		int index = 0;
+		for (Node *child : expected) {
+			if (child) {
+				CHECK(parent->get_child(index) == child);
+				CHECK(child->get_index() == index);
+				index++;
+			}
+		}
+		CHECK(parent->get_child_count() == index);
+	}
+
+	SUBCASE("Serial names should start over once all children of a base are gone") {
+		while (parent->get_child_count() > 0) {
+			Node *last = parent->get_child(-1);
+			parent->remove_child(last);
+			memdelete(last);
+		}
+
+		for (int i = 0; i < 3; i++) {
+			Node *child = memnew(Node);
+			child->set_name("Child");
+			parent->add_child(child, true);
+		}
+		CHECK(parent->get_child(0)->get_name() == "Child");
+		CHECK(parent->get_child(1)->get_name() == "Child2");
+		CHECK(parent->get_child(2)->get_name() == "Child3");
+	}
+
+	memdelete(parent);
+}
+
+TEST_CASE("[Node] Multi-level paths should resolve after tree changes") {
+	Node *root = memnew(Node);
+	Node *a = memnew(Node);
+	Node *b = memnew(Node);
+	Node *c = memnew(Node);
+	a->set_name("A");
+	b->set_name("B");
+	c->set_name("C");
+	root->add_child(a);
+	a->add_child(b);
+	b->add_child(c);
+
+	CHECK(root->get_node_or_null(NodePath("A/B/C")) == c);
+	CHECK(c->get_node_or_null(NodePath("../../../A")) == a);
+	// Repeated lookups should keep returning the same node.
+	CHECK(root->get_node_or_null(NodePath("A/B/C")) == c);
+
+	SUBCASE("Renaming") {
+		b->set_name("Renamed");
+		CHECK(root->get_node_or_null(NodePath("A/B/C")) == nullptr);
+		CHECK(root->get_node_or_null(NodePath("A/Renamed/C")) == c);
+	}
+
+	SUBCASE("Removing and reparenting") {
+		a->remove_child(b);
+		CHECK(root->get_node_or_null(NodePath("A/B/C")) == nullptr);
+		CHECK(c->get_node_or_null(NodePath("../../../A")) == nullptr);
+
+		Node *other = memnew(Node);
+		other->set_name("B");
+		a->add_child(other);
+		CHECK(root->get_node_or_null(NodePath("A/B/C")) == nullptr);
+		CHECK(root->get_node_or_null(NodePath("A/B")) == other);
+
+		a->remove_child(other);
+		memdelete(other);
+		root->add_child(b);
+		CHECK(root->get_node_or_null(NodePath("B/C")) == c);
+		CHECK(c->get_node_or_null(NodePath("../../A")) == a);
+	}
+
+	SUBCASE("Unique names") {
+		b->set_owner(root);
+		c->set_owner(root);
+		c->set_unique_name_in_owner(true);
+		CHECK(b->get_node_or_null(NodePath("%C/..")) == b);
+
+		c->set_unique_name_in_owner(false);
+		CHECK(b->get_node_or_null(NodePath("%C/..")) == nullptr);
+	}
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][Node] Adding a subtree incrementally") {
+	Node *chunk = memnew(Node);
+	Node *first = memnew(Node);
+	Node *second = memnew(Node);
+	Node *grandchild = memnew(Node);
+	chunk->add_child(first);
+	chunk->add_child(second);
+	first->add_child(grandchild);
+	first->set_name("First");
+	second->set_name("Second");
+	grandchild->set_name("Grandchild");
+
+	SIGNAL_WATCH(SceneTree::get_singleton(), SNAME("incremental_attach_progress"));
+
+	// A zero budget attaches a single node per frame.
+	SceneTree::get_singleton()->add_child_incremental(SceneTree::get_singleton()->get_root(), chunk, 0.0);
+	CHECK(chunk->is_inside_tree());
+	CHECK_EQ(chunk->get_child_count(), 0);
+	CHECK_FALSE(first->is_inside_tree());
+	SIGNAL_CHECK_FALSE(SNAME("incremental_attach_progress"));
+
+	SceneTree::get_singleton()->process(0);
+	CHECK_EQ(chunk->get_child_count(), 1);
+	CHECK(first->is_inside_tree());
+	CHECK_EQ(first->get_child_count(), 0);
+	Array progress_args = { { chunk, 1, 3 } };
+	SIGNAL_CHECK(SNAME("incremental_attach_progress"), progress_args);
+
+	SceneTree::get_singleton()->process(0);
+	CHECK(grandchild->is_inside_tree());
+	CHECK_FALSE(second->is_inside_tree());
+	SIGNAL_DISCARD(SNAME("incremental_attach_progress"));
+
+	SceneTree::get_singleton()->process(0);
+	CHECK(second->is_inside_tree());
+	CHECK_EQ(chunk->get_child(0), first);
+	CHECK_EQ(chunk->get_child(1), second);
+	CHECK_EQ(chunk->get_node_or_null(NodePath("First/Grandchild")), grandchild);
+	progress_args = { { chunk, 3, 3 } };
+	SIGNAL_CHECK(SNAME("incremental_attach_progress"), progress_args);
+
+	// Nothing is left to report.
+	SceneTree::get_singleton()->process(0);
+	SIGNAL_CHECK_FALSE(SNAME("incremental_attach_progress"));
+
+	SIGNAL_UNWATCH(SceneTree::get_singleton(), SNAME("incremental_attach_progress"));
+	memdelete(chunk);
+}
+
+TEST_CASE("[SceneTree][Node] Adding a subtree with a scripted root incrementally") {
+	Node *chunk = memnew(Node);
+	Node *first = memnew(Node);
+	Node *second = memnew(Node);
+	Node *grandchild = memnew(Node);
+	chunk->add_child(first);
+	chunk->add_child(second);
+	first->add_child(grandchild);
+
+	ReadyCountingScriptInstance *script = memnew(ReadyCountingScriptInstance(chunk));
+	chunk->set_script_instance(script);
+
+	// Like for descendants, the children of a scripted node are attached together with it.
+	SceneTree::get_singleton()->add_child_incremental(SceneTree::get_singleton()->get_root(), chunk, 0.0);
+	CHECK(chunk->is_inside_tree());
+	CHECK_EQ(script->children_on_ready, 2);
+	CHECK(first->is_inside_tree());
+	CHECK(second->is_inside_tree());
+	CHECK(grandchild->is_inside_tree());
+
+	SceneTree::get_singleton()->process(0);
+	CHECK_EQ(chunk->get_child(0), first);
+	CHECK_EQ(chunk->get_child(1), second);
+	CHECK_EQ(first->get_child(0), grandchild);
+
+	memdelete(chunk);
+}
+
 TEST_CASE("[SceneTree][Node]Exported node checks") {
 	TestNode *node = memnew(TestNode);
 	SceneTree::get_singleton()->get_root()->add_child(node);
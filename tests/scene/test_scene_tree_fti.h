@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  test_scene_tree_fti.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/engine.h"
+#include "core/math/transform_interpolator.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneTreeFTI {
+
+static Transform3D chain_transform(int p_chain, int p_link, bool p_moved) {
+	Basis basis = Basis::from_euler(Vector3(0.01 * p_chain, 0.2 * p_link + (p_moved ? 0.3 : 0.0), 0.0));
+	Vector3 origin = Vector3(p_chain % 32, p_link, p_chain / 32) + (p_moved ? Vector3(0.5, -0.25, 1.0) : Vector3());
+	return Transform3D(basis, origin);
+}
+
+// Moves chains of interpolated nodes over one tick, and checks the interpolated xforms computed by
+// SceneTreeFTI against interpolating and concatenating them one by one.
+static void check_interpolated_chains(int p_chain_count, int p_chain_length) {
+	SceneTree *tree = SceneTree::get_singleton();
+	tree->set_physics_interpolation_enabled(true);
+
+	Node3D *holder = memnew(Node3D);
+	tree->get_root()->add_child(holder);
+
+	LocalVector<MeshInstance3D *> links;
+	for (int i = 0; i < p_chain_count; i++) {
+		Node3D *parent = holder;
+		for (int j = 0; j < p_chain_length; j++) {
+			MeshInstance3D *link = memnew(MeshInstance3D);
+			link->set_transform(chain_transform(i, j, false));
+			parent->add_child(link);
+			links.push_back(link);
+			parent = link;
+		}
+	}
+
+	// The first tick pumps the initial xforms as the previous ones.
+	tree->get_scene_tree_fti().tick_update();
+	for (int i = 0; i < p_chain_count; i++) {
+		for (int j = 0; j < p_chain_length; j++) {
+			links[i * p_chain_length + j]->set_transform(chain_transform(i, j, true));
+		}
+	}
+	tree->get_scene_tree_fti().frame_update(tree->get_root(), true);
+
+	const real_t fraction = Engine::get_singleton()->get_physics_interpolation_fraction();
+	for (int i = 0; i < p_chain_count; i++) {
+		Transform3D expected;
+		for (int j = 0; j < p_chain_length; j++) {
+			Transform3D local;
+			TransformInterpolator::interpolate_transform_3d(chain_transform(i, j, false), chain_transform(i, j, true), local, fraction);
+			expected = expected * local;
+			CHECK(links[i * p_chain_length + j]->get_global_transform_interpolated().is_equal_approx(expected));
+		}
+	}
+
+	memdelete(holder);
+	tree->set_physics_interpolation_enabled(false);
+}
+
+TEST_CASE("[SceneTree][SceneTreeFTI] Interpolated xforms of a small tree") {
+	// Few enough xforms to be interpolated on the calling thread.
+	check_interpolated_chains(8, 3);
+}
+
+TEST_CASE("[SceneTree][SceneTreeFTI] Interpolated xforms of a large tree") {
+	// Enough xforms to be interpolated on the worker threads.
+	check_interpolated_chains(512, 3);
+}
+
+} // namespace TestSceneTreeFTI
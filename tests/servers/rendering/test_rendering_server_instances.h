@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_rendering_server_instances.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingServerInstances {
+
+TEST_CASE("[SceneTree][RenderingServer] Batch instance updates") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene = static_cast<RendererSceneCull *>(RSG::scene);
+
+	RID scenario = rs->scenario_create();
+	const int count = 8;
+	TypedArray<RID> instances;
+	for (int i = 0; i < count; i++) {
+		RID instance = rs->instance_create();
+		rs->instance_set_scenario(instance, scenario);
+		instances.push_back(instance);
+	}
+
+	SUBCASE("Transforms should be read from the MultiMesh buffer layout") {
+		PackedFloat32Array buffer;
+		for (int i = 0; i < count; i++) {
+			const Transform3D transform(Basis::from_euler(Vector3(0.1 * i, 0.2, 0.3)), Vector3(i, -i, 2 * i));
+			for (int row = 0; row < 3; row++) {
+				buffer.push_back(transform.basis.rows[row].x);
+				buffer.push_back(transform.basis.rows[row].y);
+				buffer.push_back(transform.basis.rows[row].z);
+				buffer.push_back(transform.origin[row]);
+			}
+		}
+		rs->call("instances_set_transforms", instances, buffer);
+
+		for (int i = 0; i < count; i++) {
+			const Transform3D expected(Basis::from_euler(Vector3(0.1 * i, 0.2, 0.3)), Vector3(i, -i, 2 * i));
+			CHECK(scene->instance_owner.get_or_null(instances[i])->transform.is_equal_approx(expected));
+		}
+
+		PackedFloat32Array wrong_size;
+		wrong_size.resize((count - 1) * 12);
+		wrong_size.fill(0.0);
+		ERR_PRINT_OFF;
+		rs->call("instances_set_transforms", instances, wrong_size);
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(scene->instance_owner.get_or_null(instances[1])->transform.origin.is_equal_approx(Vector3(1, -1, 2)), "A buffer of the wrong size should be rejected as a whole.");
+	}
+
+	SUBCASE("Visibility and layer mask should be set on all instances, skipping invalid ones") {
+		TypedArray<RID> with_invalid = instances.duplicate();
+		with_invalid.insert(count / 2, RID());
+
+		ERR_PRINT_OFF;
+		rs->call("instances_set_visible", with_invalid, false);
+		rs->call("instances_set_layer_mask", with_invalid, 0b1010);
+		ERR_PRINT_ON;
+		for (int i = 0; i < count; i++) {
+			const RendererSceneCull::Instance *instance = scene->instance_owner.get_or_null(instances[i]);
+			CHECK_FALSE(instance->visible);
+			CHECK(instance->layer_mask == 0b1010);
+		}
+
+		rs->call("instances_set_visible", instances, true);
+		for (int i = 0; i < count; i++) {
+			CHECK(scene->instance_owner.get_or_null(instances[i])->visible);
+		}
+	}
+
+	SUBCASE("Shader parameters should be set per instance") {
+		Array values;
+		for (int i = 0; i < count; i++) {
+			values.push_back(i * 0.5);
+		}
+		rs->call("instances_geometry_set_shader_parameter", instances, "tint_amount", values);
+
+		for (int i = 0; i < count; i++) {
+			CHECK(rs->instance_geometry_get_shader_parameter(instances[i], "tint_amount") == Variant(i * 0.5));
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		rs->free_rid(instances[i]);
+	}
+	rs->free_rid(scenario);
+}
+
+} // namespace TestRenderingServerInstances
@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/physics_3d/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Creates a space with a grid of static unit boxes on the XY plane.
+static RID create_box_grid_space(int p_grid_size, LocalVector<RID> &r_rids) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID space = ps->space_create();
+	RID box = ps->box_shape_create();
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+
+	for (int y = 0; y < p_grid_size; y++) {
+		for (int x = 0; x < p_grid_size; x++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			ps->body_add_shape(body, box);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2, y * 2, (x + y) % 3)));
+			ps->body_set_space(body, space);
+			r_rids.push_back(body);
+		}
+	}
+
+	// Freed in order, so the bodies go before their shape and space.
+	r_rids.push_back(box);
+	r_rids.push_back(space);
+	return space;
+}
+
+static void free_rids(const LocalVector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		PhysicsServer3D::get_singleton()->free_rid(rid);
+	}
+}
+
+static void make_rays(int p_grid_size, int p_rays_per_side, LocalVector<Vector3> &r_from, LocalVector<Vector3> &r_to) {
+	const real_t extent = p_grid_size * 2;
+	for (int y = 0; y < p_rays_per_side; y++) {
+		for (int x = 0; x < p_rays_per_side; x++) {
+			const Vector3 origin(-1 + extent * x / p_rays_per_side, -1 + extent * y / p_rays_per_side, 10);
+			r_from.push_back(origin);
+			r_to.push_back(origin + Vector3(0.1, 0.1, -20));
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batch ray queries match single ray queries") {
+	LocalVector<RID> rids;
+	RID space = create_box_grid_space(8, rids);
+	PhysicsDirectSpaceState3D *space_state = PhysicsServer3D::get_singleton()->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	// Enough rays to be split across several worker tasks.
+	make_rays(8, 40, from, to);
+	const int ray_count = from.size();
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(ray_count);
+	LocalVector<bool> hits;
+	hits.resize(ray_count);
+
+	const int hit_count = space_state->intersect_rays(parameters, from.ptr(), to.ptr(), ray_count, results.ptr(), hits.ptr());
+	CHECK(hit_count > 0);
+	CHECK(hit_count < ray_count);
+
+	int expected_hit_count = 0;
+	bool all_match = true;
+	for (int i = 0; i < ray_count; i++) {
+		PhysicsDirectSpaceState3D::RayParameters single = parameters;
+		single.from = from[i];
+		single.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult result;
+		const bool hit = space_state->intersect_ray(single, result);
+		if (hit) {
+			expected_hit_count++;
+		}
+
+		if (hit != hits[i]) {
+			all_match = false;
+		} else if (hit && (result.rid != results[i].rid || result.shape != results[i].shape || !result.position.is_equal_approx(results[i].position) || !result.normal.is_equal_approx(results[i].normal))) {
+			all_match = false;
+		}
+	}
+	CHECK(all_match);
+	CHECK_EQ(hit_count, expected_hit_count);
+
+	SUBCASE("Script binding returns packed results") {
+		Ref<PhysicsRayQueryParameters3D> query;
+		query.instantiate();
+
+		PackedVector3Array packed_from = { Vector3(0, 0, 10), Vector3(-5, -5, 10) };
+		PackedVector3Array packed_to = { Vector3(0, 0, -10), Vector3(-5, -5, -10) };
+		Dictionary d = space_state->call("intersect_rays", query, packed_from, packed_to);
+
+		CHECK_EQ(int(d["hit_count"]), 1);
+		PackedInt32Array shapes = d["shape"];
+		REQUIRE_EQ(shapes.size(), 2);
+		CHECK_EQ(shapes[0], 0);
+		CHECK_EQ(shapes[1], -1);
+		PackedVector3Array positions = d["position"];
+		CHECK(positions[0].is_equal_approx(Vector3(0, 0, 0.5)));
+	}
+
+	free_rids(rids);
+}
+
+} // namespace TestPhysicsServer3D